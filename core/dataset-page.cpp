@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dataset-page.hpp"
+
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
+
+namespace nfd {
+
+constexpr size_t DatasetPageQuery::DEFAULT_LIMIT;
+constexpr size_t DatasetPageQuery::MAX_LIMIT;
+
+DatasetPageQuery&
+DatasetPageQuery::setCursor(const Block& cursor)
+{
+  if (cursor.type() != TLV_DATASET_PAGE_CURSOR) {
+    NDN_THROW(Error("Expecting DatasetPageCursor, but TLV-TYPE is " + to_string(cursor.type())));
+  }
+
+  m_cursor = cursor;
+  m_wire.reset();
+  return *this;
+}
+
+void
+DatasetPageQuery::wireDecode(const Block& wire)
+{
+  if (wire.type() != TLV_DATASET_PAGE_QUERY) {
+    NDN_THROW(Error("Expecting DatasetPageQuery, but TLV-TYPE is " + to_string(wire.type())));
+  }
+
+  m_wire = wire;
+  m_wire.parse();
+
+  m_prefix = nullopt;
+  m_faceId = nullopt;
+  m_cursor = nullopt;
+  m_limit = nullopt;
+  for (const Block& element : m_wire.elements()) {
+    switch (element.type()) {
+      case tlv::Name:
+        m_prefix.emplace(element);
+        break;
+      case tlv::nfd::FaceId:
+        m_faceId = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case TLV_DATASET_PAGE_CURSOR:
+        m_cursor = element;
+        break;
+      case TLV_DATASET_PAGE_LIMIT:
+        m_limit = ndn::encoding::readNonNegativeInteger(element);
+        if (*m_limit == 0) {
+          NDN_THROW(Error("DatasetPageLimit must be positive"));
+        }
+        break;
+      default:
+        NDN_THROW(Error("Unexpected TLV-TYPE " + to_string(element.type()) +
+                        " in DatasetPageQuery"));
+    }
+  }
+}
+
+Block
+DatasetPageQuery::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  m_wire = Block(TLV_DATASET_PAGE_QUERY);
+  if (m_prefix) {
+    m_wire.push_back(m_prefix->wireEncode());
+  }
+  if (m_faceId) {
+    m_wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::nfd::FaceId, *m_faceId));
+  }
+  if (m_cursor) {
+    m_wire.push_back(*m_cursor);
+  }
+  if (m_limit) {
+    m_wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(TLV_DATASET_PAGE_LIMIT, *m_limit));
+  }
+  m_wire.encode();
+  return m_wire;
+}
+
+} // namespace nfd
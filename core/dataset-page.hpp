@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_DATASET_PAGE_HPP
+#define NFD_CORE_DATASET_PAGE_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief TLV-TYPE numbers of the paged status dataset encodings.
+ *  \sa DatasetPageQuery
+ */
+enum : uint32_t {
+  TLV_DATASET_PAGE_QUERY  = 202,
+  TLV_DATASET_PAGE_CURSOR = 203,
+  TLV_DATASET_PAGE_LIMIT  = 204,
+};
+
+/** \brief Query of a paged and filtered status dataset request.
+ *
+ *  The query is appended as one name component after the dataset verb,
+ *  e.g. `/localhost/nfd/fib/list/<DatasetPageQuery>`. It asks the producer for a bounded page of
+ *  the dataset, optionally restricted to entries under a prefix and/or entries with a route
+ *  or nexthop toward a face.
+ *  \code
+ *  DatasetPageQuery = DATASET-PAGE-QUERY-TYPE TLV-LENGTH
+ *                       [Name]
+ *                       [FaceId]
+ *                       [DatasetPageCursor]
+ *                       [DatasetPageLimit]
+ *
+ *  DatasetPageCursor = DATASET-PAGE-CURSOR-TYPE TLV-LENGTH *OCTET
+ *  DatasetPageLimit = DATASET-PAGE-LIMIT-TYPE TLV-LENGTH NonNegativeInteger
+ *  \endcode
+ *
+ *  A page contains at most \c getLimit() dataset items. If the producer has not reached the end
+ *  of the table, the page is terminated with a DatasetPageCursor element, which the consumer
+ *  copies verbatim into the query for the next page. The content of a cursor is opaque to the
+ *  consumer. A page may contain fewer items than the limit, or even none, while still carrying
+ *  a cursor, because the producer also bounds the number of table entries examined per page.
+ */
+class DatasetPageQuery
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  /** \brief Page size used when the query does not specify a limit
+   */
+  static constexpr size_t DEFAULT_LIMIT = 1000;
+
+  /** \brief Largest page size honored by the producer
+   */
+  static constexpr size_t MAX_LIMIT = 10000;
+
+  DatasetPageQuery() = default;
+
+  explicit
+  DatasetPageQuery(const Block& block)
+  {
+    wireDecode(block);
+  }
+
+  bool
+  hasPrefix() const
+  {
+    return m_prefix != nullopt;
+  }
+
+  const Name&
+  getPrefix() const
+  {
+    BOOST_ASSERT(hasPrefix());
+    return *m_prefix;
+  }
+
+  DatasetPageQuery&
+  setPrefix(const Name& prefix)
+  {
+    m_prefix = prefix;
+    m_wire.reset();
+    return *this;
+  }
+
+  bool
+  hasFaceId() const
+  {
+    return m_faceId != nullopt;
+  }
+
+  uint64_t
+  getFaceId() const
+  {
+    BOOST_ASSERT(hasFaceId());
+    return *m_faceId;
+  }
+
+  DatasetPageQuery&
+  setFaceId(uint64_t faceId)
+  {
+    m_faceId = faceId;
+    m_wire.reset();
+    return *this;
+  }
+
+  bool
+  hasCursor() const
+  {
+    return m_cursor != nullopt;
+  }
+
+  /** \return the DatasetPageCursor element
+   */
+  const Block&
+  getCursor() const
+  {
+    BOOST_ASSERT(hasCursor());
+    return *m_cursor;
+  }
+
+  /** \param cursor a DatasetPageCursor element taken from the end of the previous page
+   *  \throw Error \p cursor is not a DatasetPageCursor element
+   */
+  DatasetPageQuery&
+  setCursor(const Block& cursor);
+
+  DatasetPageQuery&
+  unsetCursor()
+  {
+    m_cursor = nullopt;
+    m_wire.reset();
+    return *this;
+  }
+
+  /** \return the requested page size, clamped to [1, MAX_LIMIT], or DEFAULT_LIMIT if unspecified
+   */
+  size_t
+  getLimit() const
+  {
+    return m_limit ? std::min<uint64_t>(*m_limit, MAX_LIMIT) : DEFAULT_LIMIT;
+  }
+
+  /** \pre limit > 0
+   */
+  DatasetPageQuery&
+  setLimit(uint64_t limit)
+  {
+    BOOST_ASSERT(limit > 0);
+    m_limit = limit;
+    m_wire.reset();
+    return *this;
+  }
+
+  void
+  wireDecode(const Block& wire);
+
+  Block
+  wireEncode() const;
+
+private:
+  optional<Name> m_prefix;
+  optional<uint64_t> m_faceId;
+  optional<Block> m_cursor;
+  optional<uint64_t> m_limit;
+  mutable Block m_wire;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_DATASET_PAGE_HPP
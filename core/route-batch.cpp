@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route-batch.hpp"
+
+namespace nfd {
+
+constexpr size_t RouteBatchParameters::MAX_ROUTES;
+constexpr size_t RouteBatchParameters::MAX_ENCODED_SIZE;
+
+bool
+RouteBatchParameters::canAddRoute(const ndn::nfd::ControlParameters& route) const
+{
+  if (m_routes.size() >= MAX_ROUTES) {
+    return false;
+  }
+
+  size_t valueLength = wireEncode().value_size() + route.wireEncode().size();
+  return tlv::sizeOfVarNumber(TLV_ROUTE_BATCH_PARAMETERS) + tlv::sizeOfVarNumber(valueLength) +
+         valueLength <= MAX_ENCODED_SIZE;
+}
+
+bool
+RouteBatchParameters::isValid() const
+{
+  return !m_routes.empty() && m_routes.size() <= MAX_ROUTES &&
+         wireEncode().size() <= MAX_ENCODED_SIZE;
+}
+
+void
+RouteBatchParameters::wireDecode(const Block& wire)
+{
+  if (wire.type() != TLV_ROUTE_BATCH_PARAMETERS) {
+    NDN_THROW(Error("Expecting RouteBatchParameters, but TLV-TYPE is " + to_string(wire.type())));
+  }
+
+  m_wire = wire;
+  m_wire.parse();
+
+  m_routes.clear();
+  for (const Block& element : m_wire.elements()) {
+    if (element.type() != tlv::nfd::ControlParameters) {
+      NDN_THROW(Error("Unexpected TLV-TYPE " + to_string(element.type()) +
+                      " in RouteBatchParameters"));
+    }
+    m_routes.emplace_back(element);
+  }
+}
+
+Block
+RouteBatchParameters::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  m_wire = Block(TLV_ROUTE_BATCH_PARAMETERS);
+  for (const auto& route : m_routes) {
+    m_wire.push_back(route.wireEncode());
+  }
+  m_wire.encode();
+  return m_wire;
+}
+
+void
+RouteBatchResults::wireDecode(const Block& wire)
+{
+  if (wire.type() != TLV_ROUTE_BATCH_RESULTS) {
+    NDN_THROW(Error("Expecting RouteBatchResults, but TLV-TYPE is " + to_string(wire.type())));
+  }
+
+  m_wire = wire;
+  m_wire.parse();
+
+  m_results.clear();
+  for (const Block& element : m_wire.elements()) {
+    if (element.type() != tlv::nfd::ControlResponse) {
+      NDN_THROW(Error("Unexpected TLV-TYPE " + to_string(element.type()) +
+                      " in RouteBatchResults"));
+    }
+    m_results.emplace_back(element);
+  }
+}
+
+Block
+RouteBatchResults::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  m_wire = Block(TLV_ROUTE_BATCH_RESULTS);
+  for (const auto& result : m_results) {
+    m_wire.push_back(result.wireEncode());
+  }
+  m_wire.encode();
+  return m_wire;
+}
+
+} // namespace nfd
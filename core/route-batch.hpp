@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_ROUTE_BATCH_HPP
+#define NFD_CORE_ROUTE_BATCH_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/mgmt/control-parameters.hpp>
+#include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+#include <ndn-cxx/mgmt/nfd/control-response.hpp>
+
+namespace nfd {
+
+/** \brief TLV-TYPE numbers of the route batch encodings.
+ *  \sa RouteBatchParameters, RouteBatchResults
+ */
+enum : uint32_t {
+  TLV_ROUTE_BATCH_PARAMETERS = 200,
+  TLV_ROUTE_BATCH_RESULTS    = 201,
+};
+
+/** \brief Parameters of the rib/register-batch and rib/unregister-batch commands.
+ *
+ *  The encoding is a sequence of ControlParameters elements, one per route:
+ *  \code
+ *  RouteBatchParameters = ROUTE-BATCH-PARAMETERS-TYPE TLV-LENGTH
+ *                           *ControlParameters
+ *  \endcode
+ */
+class RouteBatchParameters : public ndn::mgmt::ControlParameters
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  /** \brief maximum number of routes in a batch
+   */
+  static constexpr size_t MAX_ROUTES = 48;
+
+  /** \brief maximum encoded size of a batch
+   *
+   *  The batch is carried in the name of the command Interest. The response Data has the same
+   *  name, and its body echoes every route with defaults applied, so it is about twice as large
+   *  as the batch. Together with #MAX_ROUTES, this limit keeps both packets within
+   *  ndn::MAX_NDN_PACKET_SIZE, leaving room for the command Interest signature and the
+   *  Data signature.
+   */
+  static constexpr size_t MAX_ENCODED_SIZE = 2000;
+
+  RouteBatchParameters() = default;
+
+  explicit
+  RouteBatchParameters(const Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<ndn::nfd::ControlParameters>&
+  getRoutes() const
+  {
+    return m_routes;
+  }
+
+  RouteBatchParameters&
+  addRoute(const ndn::nfd::ControlParameters& route)
+  {
+    m_routes.push_back(route);
+    m_wire.reset();
+    return *this;
+  }
+
+  size_t
+  size() const
+  {
+    return m_routes.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_routes.empty();
+  }
+
+  /** \return whether \p route can be added without exceeding #MAX_ROUTES or #MAX_ENCODED_SIZE
+   */
+  bool
+  canAddRoute(const ndn::nfd::ControlParameters& route) const;
+
+  /** \return whether the batch is nonempty and within #MAX_ROUTES and #MAX_ENCODED_SIZE
+   */
+  bool
+  isValid() const;
+
+  void
+  wireDecode(const Block& wire) final;
+
+  Block
+  wireEncode() const final;
+
+private:
+  std::vector<ndn::nfd::ControlParameters> m_routes;
+  mutable Block m_wire;
+};
+
+/** \brief Response body of the rib/register-batch and rib/unregister-batch commands.
+ *
+ *  Contains one ControlResponse per route, in the order the routes appeared in the request.
+ *  The body of each successful ControlResponse carries the effective ControlParameters.
+ *  \code
+ *  RouteBatchResults = ROUTE-BATCH-RESULTS-TYPE TLV-LENGTH
+ *                        *ControlResponse
+ *  \endcode
+ */
+class RouteBatchResults
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  RouteBatchResults() = default;
+
+  explicit
+  RouteBatchResults(const Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<ndn::nfd::ControlResponse>&
+  getResults() const
+  {
+    return m_results;
+  }
+
+  RouteBatchResults&
+  addResult(const ndn::nfd::ControlResponse& result)
+  {
+    m_results.push_back(result);
+    m_wire.reset();
+    return *this;
+  }
+
+  void
+  wireDecode(const Block& wire);
+
+  Block
+  wireEncode() const;
+
+private:
+  std::vector<ndn::nfd::ControlResponse> m_results;
+  mutable Block m_wire;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_ROUTE_BATCH_HPP
@@ -28,6 +28,7 @@
 
 #include "transport.hpp"
 #include "socket-utils.hpp"
+#include "uring-datagram-io.hpp"
 #include "common/global.hpp"
 
 #include <array>
@@ -38,22 +39,53 @@ namespace face {
 struct Unicast {};
 struct Multicast {};
 
+/** \brief Counters provided by DatagramTransport.
+ *  \note The type name DatagramTransportCounters is an implementation detail.
+ *        Use DatagramTransport::Counters in public API.
+ */
+class DatagramTransportCounters : public virtual Transport::Counters
+{
+public:
+  /** \brief count of incoming datagrams dropped by the kernel
+   *
+   *  This includes datagrams rejected by the socket filter (see attachNdnDatagramFilter)
+   *  and datagrams dropped because the socket receive buffer was full.
+   *  The value is read from the socket whenever DatagramTransport::getCounters() is called.
+   */
+  PacketCounter nInKernelDropped;
+};
+
 /** \brief Implements Transport for datagram-based protocols.
+ *
+ *  Unicast transports can use UringDatagramIo instead of Boost.Asio for sending and receiving,
+ *  if requested by the creator of the transport, when NFD is built with io_uring support and
+ *  the running kernel supports it.
  *
  *  \tparam Protocol a datagram-based protocol in Boost.Asio
  */
 template<class Protocol, class Addressing = Unicast>
 class DatagramTransport : public Transport
+                        , protected virtual DatagramTransportCounters
 {
 public:
   typedef Protocol protocol;
 
+  /** \brief Counters provided by DatagramTransport.
+   *  \sa DatagramTransportCounters
+   */
+  using Counters = DatagramTransportCounters;
+
   /** \brief Construct datagram transport.
    *
    *  \param socket Protocol-specific socket for the created transport
+   *  \param wantIoUring whether to use UringDatagramIo if possible; only honored for
+   *                     unicast transports, see UringDatagramIo for its memory cost
    */
   explicit
-  DatagramTransport(typename protocol::socket&& socket);
+  DatagramTransport(typename protocol::socket&& socket, bool wantIoUring = false);
+
+  const Counters&
+  getCounters() const final;
 
   ssize_t
   getSendQueueLength() override;
@@ -89,6 +121,10 @@ protected:
   static EndpointId
   makeEndpointId(const typename protocol::endpoint& ep);
 
+private:
+  void
+  asyncReceive();
+
 protected:
   typename protocol::socket m_socket;
   typename protocol::endpoint m_sender;
@@ -96,13 +132,15 @@ protected:
   NFD_LOG_MEMBER_DECL();
 
 private:
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  std::vector<uint8_t> m_receiveBuffer; ///< only allocated when Boost.Asio receives datagrams
   bool m_hasRecentlyReceived;
+  unique_ptr<UringDatagramIo> m_uring;
 };
 
 
 template<class T, class U>
-DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket)
+DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket,
+                                           bool wantIoUring)
   : m_socket(std::move(socket))
   , m_hasRecentlyReceived(false)
 {
@@ -117,10 +155,38 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                              [this] (auto&&... args) {
-                                this->handleReceive(std::forward<decltype(args)>(args)...);
-                              });
+  if (wantIoUring && std::is_same<U, Unicast>::value && UringDatagramIo::isSupported()) {
+    try {
+      // the socket is connected, so every datagram comes from the remote endpoint
+      m_sender = m_socket.remote_endpoint();
+      m_uring = make_unique<UringDatagramIo>(m_socket.native_handle(),
+        [this] (const uint8_t* buffer, size_t nBytesReceived, const boost::system::error_code& error) {
+          this->receiveDatagram(buffer, nBytesReceived, error);
+        },
+        [this] (const boost::system::error_code& error, size_t nBytesSent) {
+          this->handleSend(error, nBytesSent);
+        });
+      return;
+    }
+    catch (const std::exception& e) {
+      NFD_LOG_FACE_WARN("Cannot use io_uring, falling back to Boost.Asio: " << e.what());
+    }
+  }
+
+  m_receiveBuffer.resize(ndn::MAX_NDN_PACKET_SIZE);
+  asyncReceive();
+}
+
+template<class T, class U>
+const typename DatagramTransport<T, U>::Counters&
+DatagramTransport<T, U>::getCounters() const
+{
+  // the kernel does not report drops as they happen, so the count is read when it is needed
+  ssize_t nDropped = getSocketDropCount(m_socket.native_handle());
+  if (nDropped >= 0) {
+    const_cast<PacketCounter&>(nInKernelDropped).set(static_cast<uint64_t>(nDropped));
+  }
+  return *this;
 }
 
 template<class T, class U>
@@ -140,6 +206,11 @@ DatagramTransport<T, U>::doClose()
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_uring != nullptr) {
+    // stop the io_uring requests before the socket they refer to is closed
+    m_uring->close();
+  }
+
   if (m_socket.is_open()) {
     // Cancel all outstanding operations and close the socket.
     // Use the non-throwing variants and ignore errors, if any.
@@ -161,6 +232,11 @@ DatagramTransport<T, U>::doSend(const Block& packet, const EndpointId&)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_uring != nullptr) {
+    m_uring->send(packet);
+    return;
+  }
+
   m_socket.async_send(boost::asio::buffer(packet),
                       // 'packet' is copied into the lambda to retain the underlying Buffer
                       [this, packet] (auto&&... args) {
@@ -203,10 +279,17 @@ DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, s
   receiveDatagram(m_receiveBuffer.data(), nBytesReceived, error);
 
   if (m_socket.is_open())
-    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                                [this] (auto&&... args) {
-                                  this->handleReceive(std::forward<decltype(args)>(args)...);
-                                });
+    asyncReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::asyncReceive()
+{
+  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
+                              [this] (auto&&... args) {
+                                this->handleReceive(std::forward<decltype(args)>(args)...);
+                              });
 }
 
 template<class T, class U>
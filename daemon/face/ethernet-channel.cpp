@@ -39,12 +39,14 @@ namespace face {
 NFD_LOG_INIT(EthernetChannel);
 
 EthernetChannel::EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                                 time::nanoseconds idleTimeout)
+                                 time::nanoseconds idleTimeout,
+                                 EthernetTransport::IoBackend ioBackend)
   : m_localEndpoint(std::move(localEndpoint))
   , m_isListening(false)
   , m_socket(getGlobalIoService())
   , m_pcap(m_localEndpoint->getName())
   , m_idleFaceTimeout(idleTimeout)
+  , m_ioBackend(ioBackend)
 #ifdef _DEBUG
   , m_nDropped(0)
 #endif
@@ -205,7 +207,7 @@ EthernetChannel::createFace(const ethernet::Address& remoteEndpoint,
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastEthernetTransport>(*m_localEndpoint, remoteEndpoint,
                                                          params.persistency, m_idleFaceTimeout,
-                                                         params.mtu);
+                                                         params.mtu, m_ioBackend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_channelFaces[remoteEndpoint] = face;
@@ -229,6 +231,7 @@ EthernetChannel::updateFilter()
   for (const auto& addr : m_channelFaces | boost::adaptors::map_keys) {
     filter += " && (not ether src " + addr.toString() + ")";
   }
+  filter += " && " + ethernet::getPayloadTypeFilter();
   // "not vlan" must appear last in the filter expression, or the
   // rest of the filter won't work as intended, see pcap-filter(7)
   filter += " && (not vlan)";
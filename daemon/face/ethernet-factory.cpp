@@ -60,6 +60,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
   // {
   //   listen yes
   //   idle_timeout 600
+  //   io_backend pcap
   //   mcast yes
   //   mcast_group 01:00:5E:00:17:AA
   //   mcast_ad_hoc no
@@ -89,6 +90,19 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
       else if (key == "idle_timeout") {
         unicastConfig.idleTimeout = time::seconds(ConfigFile::parseNumber<uint32_t>(pair, "face_system.ether"));
       }
+      else if (key == "io_backend") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "pcap") {
+          unicastConfig.ioBackend = mcastConfig.ioBackend = EthernetTransport::IoBackend::PCAP;
+        }
+        else if (valueStr == "mmap") {
+          unicastConfig.ioBackend = mcastConfig.ioBackend = EthernetTransport::IoBackend::MMAP;
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.ether.io_backend: '" +
+                                      valueStr + "' is not a supported I/O backend"));
+        }
+      }
       else if (key == "mcast") {
         mcastConfig.isEnabled = ConfigFile::parseYesNo(pair, "face_system.ether");
       }
@@ -131,6 +145,9 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     if (m_unicastConfig.idleTimeout != unicastConfig.idleTimeout && !m_channels.empty()) {
       NFD_LOG_WARN("Idle timeout setting applies to new Ethernet channels only");
     }
+    if (m_unicastConfig.ioBackend != unicastConfig.ioBackend && !m_channels.empty()) {
+      NFD_LOG_WARN("I/O backend setting applies to new Ethernet channels only");
+    }
   }
   else if (m_unicastConfig.isEnabled && !m_channels.empty()) {
     NFD_LOG_WARN("Cannot disable Ethernet channels after initialization");
@@ -148,6 +165,9 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     if (m_mcastConfig.linkType != mcastConfig.linkType && !m_mcastFaces.empty()) {
       NFD_LOG_WARN("Cannot change ad hoc setting on existing faces");
     }
+    if (m_mcastConfig.ioBackend != mcastConfig.ioBackend && !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("Cannot change I/O backend on existing faces");
+    }
     if (m_mcastConfig.group != mcastConfig.group) {
       NFD_LOG_INFO("changing multicast group from " << m_mcastConfig.group <<
                    " to " << mcastConfig.group);
@@ -217,13 +237,14 @@ EthernetFactory::doCreateFace(const CreateFaceRequest& req,
 
 shared_ptr<EthernetChannel>
 EthernetFactory::createChannel(const shared_ptr<const ndn::net::NetworkInterface>& localEndpoint,
-                               time::nanoseconds idleTimeout)
+                               time::nanoseconds idleTimeout,
+                               EthernetTransport::IoBackend ioBackend)
 {
   auto it = m_channels.find(localEndpoint->getName());
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout);
+  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout, ioBackend);
   m_channels[localEndpoint->getName()] = channel;
   return channel;
 }
@@ -251,7 +272,8 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   opts.allowReassembly = true;
 
   auto linkService = make_unique<GenericLinkService>(opts);
-  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType);
+  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType,
+                                                           m_mcastConfig.ioBackend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[key] = face;
@@ -282,7 +304,7 @@ EthernetFactory::applyUnicastConfigToNetif(const shared_ptr<const ndn::net::Netw
     return nullptr;
   }
 
-  auto channel = this->createChannel(netif, m_unicastConfig.idleTimeout);
+  auto channel = this->createChannel(netif, m_unicastConfig.idleTimeout, m_unicastConfig.ioBackend);
   if (m_unicastConfig.wantListen && !channel->isListening()) {
     try {
       channel->listen(this->addFace, nullptr);
@@ -55,7 +55,8 @@ public:
    */
   shared_ptr<EthernetChannel>
   createChannel(const shared_ptr<const ndn::net::NetworkInterface>& localEndpoint,
-                time::nanoseconds idleTimeout);
+                time::nanoseconds idleTimeout,
+                EthernetTransport::IoBackend ioBackend = EthernetTransport::IoBackend::PCAP);
 
   /**
    * \brief Create a face to communicate on the given Ethernet multicast group
@@ -110,6 +111,7 @@ private:
     bool isEnabled = false;
     bool wantListen = false;
     time::nanoseconds idleTimeout = 10_min;
+    EthernetTransport::IoBackend ioBackend = EthernetTransport::IoBackend::PCAP;
   };
   UnicastConfig m_unicastConfig;
 
@@ -119,6 +121,7 @@ private:
     ethernet::Address group = ethernet::getDefaultMulticastAddress();
     ndn::nfd::LinkType linkType = ndn::nfd::LINK_TYPE_MULTI_ACCESS;
     NetworkInterfacePredicate netifPredicate;
+    EthernetTransport::IoBackend ioBackend = EthernetTransport::IoBackend::PCAP;
   };
   MulticastConfig m_mcastConfig;
 
@@ -26,6 +26,7 @@
 #include "ethernet-protocol.hpp"
 
 #include <boost/endian/conversion.hpp>
+#include <ndn-cxx/lp/tlv.hpp>
 
 namespace nfd {
 namespace ethernet {
@@ -58,5 +59,15 @@ checkFrameHeader(const uint8_t* packet, size_t length,
   return {eh, ""};
 }
 
+const std::string&
+getPayloadTypeFilter()
+{
+  static const std::string filter =
+    "(ether[" + to_string(HDR_LEN) + "] == " + to_string(tlv::Interest) +
+    " || ether[" + to_string(HDR_LEN) + "] == " + to_string(tlv::Data) +
+    " || ether[" + to_string(HDR_LEN) + "] == " + to_string(ndn::lp::tlv::LpPacket) + ")";
+  return filter;
+}
+
 } // namespace ethernet
 } // namespace nfd
@@ -39,6 +39,13 @@ std::pair<const ether_header*, std::string>
 checkFrameHeader(const uint8_t* packet, size_t length,
                  const Address& localAddr, const Address& destAddr);
 
+/** \brief pcap filter expression that only matches frames whose payload starts with
+ *         the TLV-TYPE of an Interest, a Data, or an LpPacket
+ *  \note The expression must precede "not vlan" in the complete filter, see pcap-filter(7)
+ */
+const std::string&
+getPayloadTypeFilter();
+
 } // namespace ethernet
 } // namespace nfd
 
@@ -0,0 +1,335 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-ring.hpp"
+#include "ethernet-protocol.hpp"
+
+#include <pcap/pcap.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <arpa/inet.h>         // for htons()
+#include <linux/filter.h>      // for struct sock_fprog
+#include <linux/if_packet.h>   // for TPACKET_V3
+#include <net/ethernet.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#endif
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN  0xffffffff
+#endif
+
+namespace nfd {
+namespace face {
+
+#if defined(__linux__)
+
+// RX ring: blocks are retired to user space when full or after RX_BLOCK_TIMEOUT_MS,
+// whichever comes first. Frames are packed back-to-back inside each block.
+const size_t RX_BLOCK_SIZE = 1 << 20;
+const size_t RX_BLOCK_NR = 8;
+const size_t RX_FRAME_SIZE = 1 << 11;
+const unsigned int RX_BLOCK_TIMEOUT_MS = 1;
+
+// TX ring: fixed-size slots, each large enough for a maximum-size NDN packet.
+const size_t TX_FRAME_SIZE = 1 << 14;
+const size_t TX_BLOCK_SIZE = 1 << 16;
+const size_t TX_BLOCK_NR = 64;
+
+static_assert(TX_FRAME_SIZE >= TPACKET3_HDRLEN + ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE,
+              "TX_FRAME_SIZE is too small");
+
+static std::string
+makeErrorMessage(const char* what)
+{
+  return what + ": "s + std::strerror(errno);
+}
+
+EthernetRing::EthernetRing(int interfaceIndex)
+  : m_fd(-1)
+  , m_map(nullptr)
+  , m_mapSize(0)
+  , m_rxBlockSize(RX_BLOCK_SIZE)
+  , m_rxBlockNr(RX_BLOCK_NR)
+  , m_rxBlockIdx(0)
+  , m_rxFrameIdx(0)
+  , m_rxFrameOffset(0)
+  , m_txFrameSize(TX_FRAME_SIZE)
+  , m_txFrameNr(TX_BLOCK_SIZE / TX_FRAME_SIZE * TX_BLOCK_NR)
+  , m_txFrameIdx(0)
+  , m_nPendingTx(0)
+  , m_nDropped(0)
+{
+  // protocol 0: do not receive anything until the rings are set up and the socket is bound
+  m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  if (m_fd < 0)
+    NDN_THROW(Error(makeErrorMessage("socket")));
+
+  auto failWith = [this] (const char* what) {
+    auto msg = makeErrorMessage(what);
+    ::close(m_fd);
+    m_fd = -1;
+    NDN_THROW(Error(msg));
+  };
+
+  int version = TPACKET_V3;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    failWith("setsockopt(PACKET_VERSION)");
+
+  tpacket_req3 rxReq{};
+  rxReq.tp_block_size = m_rxBlockSize;
+  rxReq.tp_block_nr = m_rxBlockNr;
+  rxReq.tp_frame_size = RX_FRAME_SIZE;
+  rxReq.tp_frame_nr = m_rxBlockSize / RX_FRAME_SIZE * m_rxBlockNr;
+  rxReq.tp_retire_blk_tov = RX_BLOCK_TIMEOUT_MS;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    failWith("setsockopt(PACKET_RX_RING)");
+
+  tpacket_req3 txReq{};
+  txReq.tp_block_size = TX_BLOCK_SIZE;
+  txReq.tp_block_nr = TX_BLOCK_NR;
+  txReq.tp_frame_size = m_txFrameSize;
+  txReq.tp_frame_nr = m_txFrameNr;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+    failWith("setsockopt(PACKET_TX_RING)");
+
+  // the RX ring is mapped first, immediately followed by the TX ring
+  m_mapSize = m_rxBlockSize * m_rxBlockNr + TX_BLOCK_SIZE * TX_BLOCK_NR;
+  void* map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, m_fd, 0);
+  if (map == MAP_FAILED) {
+    // MAP_LOCKED can fail due to RLIMIT_MEMLOCK, retry without it
+    map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (map == MAP_FAILED)
+      failWith("mmap");
+  }
+  m_map = static_cast<uint8_t*>(map);
+
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(ethernet::ETHERTYPE_NDN);
+  sll.sll_ifindex = interfaceIndex;
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0) {
+    ::munmap(m_map, m_mapSize);
+    m_map = nullptr;
+    failWith("bind");
+  }
+}
+
+EthernetRing::~EthernetRing()
+{
+  if (m_map != nullptr)
+    ::munmap(m_map, m_mapSize);
+  if (m_fd >= 0)
+    ::close(m_fd);
+}
+
+int
+EthernetRing::getFd() const
+{
+  // see PcapHelper::getFd()
+  return ::dup(m_fd);
+}
+
+size_t
+EthernetRing::getNDropped() const
+{
+  // the kernel resets the counters after each read
+  tpacket_stats_v3 stats{};
+  socklen_t len = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) < 0)
+    NDN_THROW(Error(makeErrorMessage("getsockopt(PACKET_STATISTICS)")));
+
+  m_nDropped += stats.tp_drops;
+  return m_nDropped;
+}
+
+void
+EthernetRing::setPacketFilter(const char* filter) const
+{
+  pcap_t* dead = pcap_open_dead(DLT_EN10MB, ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  if (dead == nullptr)
+    NDN_THROW(Error("pcap_open_dead failed"));
+
+  bpf_program prog;
+  if (pcap_compile(dead, &prog, filter, 1, PCAP_NETMASK_UNKNOWN) < 0) {
+    std::string err = pcap_geterr(dead);
+    pcap_close(dead);
+    NDN_THROW(Error("pcap_compile: " + err));
+  }
+  pcap_close(dead);
+
+  // struct bpf_insn and struct sock_filter have the same layout
+  sock_fprog fprog{};
+  fprog.len = prog.bf_len;
+  fprog.filter = reinterpret_cast<sock_filter*>(prog.bf_insns);
+  int ret = ::setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  pcap_freecode(&prog);
+  if (ret < 0)
+    NDN_THROW(Error(makeErrorMessage("setsockopt(SO_ATTACH_FILTER)")));
+}
+
+size_t
+EthernetRing::receiveFrames(const FrameCallback& onFrame)
+{
+  size_t nFrames = 0;
+
+  while (true) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_map + m_rxBlockIdx * m_rxBlockSize);
+    if ((block->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+      break;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // a block that was only partially processed in the previous call is resumed
+    // from the saved position, it still belongs to user space until it is released below
+    if (m_rxFrameIdx == 0)
+      m_rxFrameOffset = block->hdr.bh1.offset_to_first_pkt;
+
+    while (m_rxFrameIdx < block->hdr.bh1.num_pkts) {
+      auto hdr = reinterpret_cast<const tpacket3_hdr*>(reinterpret_cast<const uint8_t*>(block) +
+                                                       m_rxFrameOffset);
+      auto sll = reinterpret_cast<const sockaddr_ll*>(reinterpret_cast<const uint8_t*>(hdr) +
+                                                      TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+      ++m_rxFrameIdx;
+      m_rxFrameOffset += hdr->tp_next_offset;
+
+      // skip outgoing frames and 802.1Q-tagged frames, as "not vlan" does in the pcap filter
+      if (sll->sll_pkttype != PACKET_OUTGOING && (hdr->tp_status & TP_STATUS_VLAN_VALID) == 0) {
+        ++nFrames;
+        if (!onFrame(reinterpret_cast<const uint8_t*>(hdr) + hdr->tp_mac, hdr->tp_snaplen))
+          return nFrames;
+      }
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+    m_rxBlockIdx = (m_rxBlockIdx + 1) % m_rxBlockNr;
+    m_rxFrameIdx = 0;
+  }
+
+  return nFrames;
+}
+
+bool
+EthernetRing::enqueueFrame(const uint8_t* frame, size_t length)
+{
+  const size_t dataOffset = TPACKET3_HDRLEN - sizeof(sockaddr_ll);
+  if (dataOffset + length > m_txFrameSize)
+    return false;
+
+  uint8_t* slot = m_map + m_rxBlockSize * m_rxBlockNr + m_txFrameIdx * m_txFrameSize;
+  auto hdr = reinterpret_cast<tpacket3_hdr*>(slot);
+  if (hdr->tp_status != TP_STATUS_AVAILABLE)
+    return false;
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  std::memcpy(slot + dataOffset, frame, length);
+  hdr->tp_next_offset = 0;
+  hdr->tp_len = length;
+  hdr->tp_snaplen = length;
+
+  std::atomic_thread_fence(std::memory_order_release);
+  hdr->tp_status = TP_STATUS_SEND_REQUEST;
+
+  m_txFrameIdx = (m_txFrameIdx + 1) % m_txFrameNr;
+  ++m_nPendingTx;
+  return true;
+}
+
+void
+EthernetRing::flush()
+{
+  if (m_nPendingTx == 0)
+    return;
+
+  m_nPendingTx = 0;
+  if (::send(m_fd, nullptr, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != ENOBUFS)
+    NDN_THROW(Error(makeErrorMessage("send")));
+}
+
+#else // __linux__
+
+EthernetRing::EthernetRing(int)
+  : m_fd(-1)
+  , m_map(nullptr)
+  , m_mapSize(0)
+  , m_rxBlockSize(0)
+  , m_rxBlockNr(0)
+  , m_rxBlockIdx(0)
+  , m_rxFrameIdx(0)
+  , m_rxFrameOffset(0)
+  , m_txFrameSize(0)
+  , m_txFrameNr(0)
+  , m_txFrameIdx(0)
+  , m_nPendingTx(0)
+  , m_nDropped(0)
+{
+  NDN_THROW(Error("PACKET_MMAP rings are not supported on this platform"));
+}
+
+EthernetRing::~EthernetRing() = default;
+
+int
+EthernetRing::getFd() const
+{
+  return -1;
+}
+
+size_t
+EthernetRing::getNDropped() const
+{
+  return 0;
+}
+
+void
+EthernetRing::setPacketFilter(const char*) const
+{
+}
+
+size_t
+EthernetRing::receiveFrames(const FrameCallback&)
+{
+  return 0;
+}
+
+bool
+EthernetRing::enqueueFrame(const uint8_t*, size_t)
+{
+  return false;
+}
+
+void
+EthernetRing::flush()
+{
+}
+
+#endif // __linux__
+
+} // namespace face
+} // namespace nfd
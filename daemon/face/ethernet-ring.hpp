@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_RING_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief Memory-mapped RX/TX rings on a Linux AF_PACKET socket.
+ *
+ * Frames are exchanged with the kernel through PACKET_MMAP TPACKET_V3 rings that are shared
+ * between the kernel and user space. Received frames are handed to the caller in batches,
+ * one ring block at a time, without being copied. Outgoing frames are written into the TX
+ * ring and handed to the kernel in batches with a single send(2) call, see flush().
+ *
+ * The socket is bound to the NDN ethertype on a single network interface, and only incoming
+ * frames are reported, i.e., the behavior matches PcapHelper with `PCAP_D_IN`.
+ *
+ * @note This class is only functional on Linux. On other platforms the constructor throws.
+ * @sa packet(7), https://www.kernel.org/doc/Documentation/networking/packet_mmap.txt
+ */
+class EthernetRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Invoked for each received frame
+   * @param frame pointer to the first byte of the Ethernet header, valid only during the call
+   * @param length frame length, including the Ethernet header
+   * @return false to stop processing the current batch
+   */
+  using FrameCallback = std::function<bool(const uint8_t* frame, size_t length)>;
+
+  /**
+   * @brief Create an AF_PACKET socket with RX and TX rings bound to a network interface.
+   * @param interfaceIndex index of the network interface
+   * @throw Error on any error
+   */
+  explicit
+  EthernetRing(int interfaceIndex);
+
+  ~EthernetRing();
+
+  /**
+   * @brief Obtain a file descriptor that can be used in calls such as select(2) and poll(2).
+   * @return A selectable file descriptor. It is the caller's responsibility to close the fd.
+   * @throw Error on any error
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Get the number of frames dropped by the kernel since the ring was created.
+   * @throw Error on any error
+   */
+  size_t
+  getNDropped() const;
+
+  /**
+   * @brief Install a BPF filter on the socket.
+   * @param filter Null-terminated string containing the BPF program source.
+   * @throw Error on any error
+   * @sa pcap-filter(7)
+   */
+  void
+  setPacketFilter(const char* filter) const;
+
+  /**
+   * @brief Process all frames that the kernel has made available in the RX ring.
+   *
+   * If @p onFrame returns false, processing stops after that frame. The remaining frames are
+   * kept in the ring and delivered first by the next call.
+   *
+   * @return number of frames passed to @p onFrame
+   */
+  size_t
+  receiveFrames(const FrameCallback& onFrame);
+
+  /**
+   * @brief Copy a frame into the next free slot of the TX ring.
+   *
+   * The frame is not transmitted until flush() is called.
+   *
+   * @return false if the frame is too large or the TX ring is full
+   */
+  bool
+  enqueueFrame(const uint8_t* frame, size_t length);
+
+  /**
+   * @brief Number of frames enqueued since the last flush()
+   */
+  size_t
+  getNPendingFrames() const
+  {
+    return m_nPendingTx;
+  }
+
+  /**
+   * @brief Ask the kernel to transmit all enqueued frames.
+   * @throw Error the send(2) call failed
+   */
+  void
+  flush();
+
+private:
+  int m_fd;
+  uint8_t* m_map;
+  size_t m_mapSize;
+
+  size_t m_rxBlockSize;
+  size_t m_rxBlockNr;
+  size_t m_rxBlockIdx;
+  uint32_t m_rxFrameIdx;    ///< index of the next frame to deliver in the current RX block
+  uint32_t m_rxFrameOffset; ///< offset of that frame from the start of the block
+
+  size_t m_txFrameSize;
+  size_t m_txFrameNr;
+  size_t m_txFrameIdx;
+  size_t m_nPendingTx;
+
+  mutable size_t m_nDropped;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_RING_HPP
@@ -39,23 +39,38 @@ namespace face {
 NFD_LOG_INIT(EthernetTransport);
 
 EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                                     const ethernet::Address& remoteEndpoint)
+                                     const ethernet::Address& remoteEndpoint,
+                                     IoBackend backend)
   : m_socket(getGlobalIoService())
   , m_pcap(localEndpoint.getName())
   , m_srcAddress(localEndpoint.getEthernetAddress())
   , m_destAddress(remoteEndpoint)
   , m_interfaceName(localEndpoint.getName())
   , m_hasRecentlyReceived(false)
+  , m_hasPendingFlush(false)
 #ifdef _DEBUG
   , m_nDropped(0)
 #endif
 {
-  try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+  if (backend == IoBackend::MMAP) {
+    try {
+      m_ring = make_unique<EthernetRing>(localEndpoint.getIndex());
+      m_socket.assign(m_ring->getFd());
+    }
+    catch (const EthernetRing::Error& e) {
+      NFD_LOG_FACE_WARN("Cannot use PACKET_MMAP rings, falling back to libpcap: " << e.what());
+      m_ring.reset();
+    }
   }
-  catch (const PcapHelper::Error& e) {
-    NDN_THROW_NESTED(Error(e.what()));
+
+  if (m_ring == nullptr) {
+    try {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+    }
+    catch (const PcapHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
   }
 
   m_netifStateConn = localEndpoint.onStateChanged.connect(
@@ -79,6 +94,8 @@ EthernetTransport::doClose()
     m_socket.close(error);
   }
   m_pcap.close();
+  // m_ring is not released here because doClose() can be invoked while
+  // handleRead() is iterating over the RX ring; it is unmapped in the destructor
 
   // Ensure that the Transport stays alive at least
   // until all pending handlers are dispatched
@@ -87,6 +104,15 @@ EthernetTransport::doClose()
   });
 }
 
+void
+EthernetTransport::setPacketFilter(const char* filter) const
+{
+  if (m_ring != nullptr)
+    m_ring->setPacketFilter(filter);
+  else
+    m_pcap.setPacketFilter(filter);
+}
+
 void
 EthernetTransport::handleNetifStateChange(ndn::net::InterfaceState netifState)
 {
@@ -126,6 +152,25 @@ EthernetTransport::sendPacket(const ndn::Block& block)
   buffer.prependByteArray(m_srcAddress.data(), m_srcAddress.size());
   buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
 
+  if (m_ring != nullptr) {
+    if (!m_ring->enqueueFrame(buffer.buf(), buffer.size())) {
+      // the TX ring is full: hand the pending frames to the kernel and retry once
+      flushSendRing();
+      if (!m_ring->enqueueFrame(buffer.buf(), buffer.size())) {
+        NFD_LOG_FACE_DEBUG("TX ring is full, dropping frame of " << block.size() << " bytes");
+        return;
+      }
+    }
+
+    // frames enqueued during the same io_service turn are transmitted with one system call
+    if (!m_hasPendingFlush) {
+      m_hasPendingFlush = true;
+      m_flushEvent = getScheduler().schedule(0_ns, [this] { flushSendRing(); });
+    }
+    NFD_LOG_FACE_TRACE("Enqueued: " << block.size() << " bytes");
+    return;
+  }
+
   // send the frame
   int sent = pcap_inject(m_pcap, buffer.buf(), buffer.size());
   if (sent < 0)
@@ -138,6 +183,21 @@ EthernetTransport::sendPacket(const ndn::Block& block)
     NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
 }
 
+void
+EthernetTransport::flushSendRing()
+{
+  m_hasPendingFlush = false;
+  if (m_ring == nullptr || !m_socket.is_open())
+    return;
+
+  try {
+    m_ring->flush();
+  }
+  catch (const EthernetRing::Error& e) {
+    handleError("Send operation failed: "s + e.what());
+  }
+}
+
 void
 EthernetTransport::asyncRead()
 {
@@ -160,31 +220,27 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
     return;
   }
 
-  const uint8_t* pkt;
-  size_t len;
-  std::string err;
-  std::tie(pkt, len, err) = m_pcap.readNextPacket();
-
-  if (pkt == nullptr) {
-    NFD_LOG_FACE_WARN("Read error: " << err);
+  if (m_ring != nullptr) {
+    m_ring->receiveFrames([this] (const uint8_t* frame, size_t len) {
+      processFrame(frame, len);
+      // stop if the transport has been closed while processing the frame
+      return m_socket.is_open();
+    });
   }
   else {
-    const ether_header* eh;
-    std::tie(eh, err) = ethernet::checkFrameHeader(pkt, len, m_srcAddress,
-                                                   m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
-    if (eh == nullptr) {
-      NFD_LOG_FACE_WARN(err);
-    }
-    else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt += ethernet::HDR_LEN;
-      len -= ethernet::HDR_LEN;
-      receivePayload(pkt, len, sender);
-    }
+    const uint8_t* pkt;
+    size_t len;
+    std::string err;
+    std::tie(pkt, len, err) = m_pcap.readNextPacket();
+
+    if (pkt == nullptr)
+      NFD_LOG_FACE_WARN("Read error: " << err);
+    else
+      processFrame(pkt, len);
   }
 
 #ifdef _DEBUG
-  size_t nDropped = m_pcap.getNDropped();
+  size_t nDropped = m_ring != nullptr ? m_ring->getNDropped() : m_pcap.getNDropped();
   if (nDropped - m_nDropped > 0)
     NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
   m_nDropped = nDropped;
@@ -193,6 +249,22 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
   asyncRead();
 }
 
+void
+EthernetTransport::processFrame(const uint8_t* frame, size_t length)
+{
+  const ether_header* eh;
+  std::string err;
+  std::tie(eh, err) = ethernet::checkFrameHeader(frame, length, m_srcAddress,
+                                                 m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
+  if (eh == nullptr) {
+    NFD_LOG_FACE_WARN(err);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  receivePayload(frame + ethernet::HDR_LEN, length - ethernet::HDR_LEN, sender);
+}
+
 void
 EthernetTransport::receivePayload(const uint8_t* payload, size_t length,
                                   const ethernet::Address& sender)
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
 
 #include "ethernet-protocol.hpp"
+#include "ethernet-ring.hpp"
 #include "pcap-helper.hpp"
 #include "transport.hpp"
 
@@ -47,6 +48,14 @@ public:
     using std::runtime_error::runtime_error;
   };
 
+  /**
+   * @brief Selects how frames are exchanged with the kernel
+   */
+  enum class IoBackend {
+    PCAP, ///< libpcap, one system call and one copy per frame
+    MMAP, ///< PACKET_MMAP TPACKET_V3 rings, frames are read and written in batches (Linux only)
+  };
+
   /**
    * @brief Processes the payload of an incoming frame
    * @param payload Pointer to the first byte of data after the Ethernet header
@@ -57,13 +66,35 @@ public:
   receivePayload(const uint8_t* payload, size_t length,
                  const ethernet::Address& sender);
 
+  /**
+   * @brief Returns the I/O backend actually in use
+   */
+  IoBackend
+  getIoBackend() const
+  {
+    return m_ring != nullptr ? IoBackend::MMAP : IoBackend::PCAP;
+  }
+
 protected:
+  /**
+   * @param backend requested I/O backend; if the MMAP backend cannot be set up,
+   *                the transport falls back to PCAP
+   */
   EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                    const ethernet::Address& remoteEndpoint);
+                    const ethernet::Address& remoteEndpoint,
+                    IoBackend backend = IoBackend::PCAP);
 
   void
   doClose() final;
 
+  /**
+   * @brief Installs a BPF filter on the receiving socket
+   * @param filter Null-terminated string containing the BPF program source
+   * @sa PcapHelper::setPacketFilter, EthernetRing::setPacketFilter
+   */
+  void
+  setPacketFilter(const char* filter) const;
+
   bool
   hasRecentlyReceived() const
   {
@@ -95,12 +126,22 @@ private:
   void
   handleRead(const boost::system::error_code& error);
 
+  /**
+   * @brief Validates the Ethernet header of a received frame and passes the payload up
+   */
+  void
+  processFrame(const uint8_t* frame, size_t length);
+
+  void
+  flushSendRing();
+
   void
   handleError(const std::string& errorMessage);
 
 protected:
   boost::asio::posix::stream_descriptor m_socket;
   PcapHelper m_pcap;
+  unique_ptr<EthernetRing> m_ring; ///< non-null if the MMAP backend is in use
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   std::string m_interfaceName;
@@ -108,8 +149,10 @@ protected:
 private:
   signal::ScopedConnection m_netifStateConn;
   bool m_hasRecentlyReceived;
+  bool m_hasPendingFlush;
+  scheduler::ScopedEventId m_flushEvent;
 #ifdef _DEBUG
-  /// number of frames dropped by the kernel, as reported by libpcap
+  /// number of frames dropped by the kernel, as reported by libpcap or the RX ring
   size_t m_nDropped;
 #endif
 };
@@ -24,6 +24,7 @@
  */
 
 #include "face-system.hpp"
+#include "generic-link-service.hpp"
 #include "protocol-factory.hpp"
 #include "netdev-bound.hpp"
 #include "common/global.hpp"
@@ -50,6 +51,8 @@ FaceSystem::FaceSystem(FaceTable& faceTable, shared_ptr<ndn::net::NetworkMonitor
   }
 
   m_netdevBound = make_unique<NetdevBound>(pfCtorParams, *this);
+
+  m_afterAddConn = m_faceTable.afterAdd.connect([this] (Face& face) { applyGeneralConfig(face); });
 }
 
 ProtocolFactoryCtorParams
@@ -111,6 +114,9 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
       if (key == "enable_congestion_marking") {
         context.generalConfig.wantCongestionMarking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
       }
+      else if (key == "enable_pit_token") {
+        context.generalConfig.wantPitToken = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
+      }
       else {
         NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_GENERAL_FQ + "." + key));
       }
@@ -162,6 +168,27 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
 
     NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_FACESYSTEM + "." + sectionName));
   }
+
+  if (!isDryRun) {
+    m_generalConfig = context.generalConfig;
+    for (Face& face : m_faceTable) {
+      applyGeneralConfig(face);
+    }
+  }
+}
+
+void
+FaceSystem::applyGeneralConfig(Face& face) const
+{
+  auto linkService = dynamic_cast<GenericLinkService*>(face.getLinkService());
+  if (linkService == nullptr ||
+      linkService->getOptions().allowPitToken == m_generalConfig.wantPitToken) {
+    return;
+  }
+
+  auto options = linkService->getOptions();
+  options.allowPitToken = m_generalConfig.wantPitToken;
+  linkService->setOptions(options);
 }
 
 } // namespace face
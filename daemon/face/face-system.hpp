@@ -39,6 +39,7 @@ class FaceTable;
 
 namespace face {
 
+class Face;
 class NetdevBound;
 class ProtocolFactory;
 struct ProtocolFactoryCtorParams;
@@ -89,6 +90,7 @@ public:
   struct GeneralConfig
   {
     bool wantCongestionMarking = true;
+    bool wantPitToken = false;
   };
 
   /** \brief context for processing a config section in ProtocolFactory
@@ -109,6 +111,11 @@ private:
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  /** \brief apply link service options of the "general" section to \p face
+   */
+  void
+  applyGeneralConfig(Face& face) const;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief config section name => protocol factory
    */
@@ -124,6 +131,9 @@ private:
 
   FaceTable& m_faceTable;
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
+
+  GeneralConfig m_generalConfig;
+  signal::ScopedConnection m_afterAddConn;
 };
 
 } // namespace face
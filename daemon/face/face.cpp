@@ -35,6 +35,7 @@ Face::Face(unique_ptr<LinkService> service, unique_ptr<Transport> transport)
   , onDroppedInterest(service->onDroppedInterest)
   , afterStateChange(transport->afterStateChange)
   , m_id(INVALID_FACEID)
+  , m_incomingFaceIdTag(make_shared<lp::IncomingFaceIdTag>(m_id))
   , m_service(std::move(service))
   , m_transport(std::move(transport))
   , m_counters(m_service->getCounters(), m_transport->getCounters())
@@ -31,6 +31,8 @@
 #include "link-service.hpp"
 #include "transport.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
+
 namespace nfd {
 namespace face {
 
@@ -104,6 +106,14 @@ public: // static properties
   void
   setId(FaceId id);
 
+  /** \return an IncomingFaceIdTag carrying this face's ID
+   *
+   *  The same tag is returned until the face ID changes, so that it can be attached to every
+   *  packet received on this face without allocating a new tag.
+   */
+  const shared_ptr<lp::IncomingFaceIdTag>&
+  getIncomingFaceIdTag() const;
+
   /** \return a FaceUri representing local endpoint
    */
   FaceUri
@@ -168,6 +178,7 @@ public: // dynamic properties
 
 private:
   FaceId m_id;
+  shared_ptr<lp::IncomingFaceIdTag> m_incomingFaceIdTag;
   unique_ptr<LinkService> m_service;
   unique_ptr<Transport> m_transport;
   FaceCounters m_counters;
@@ -213,6 +224,13 @@ inline void
 Face::setId(FaceId id)
 {
   m_id = id;
+  m_incomingFaceIdTag = make_shared<lp::IncomingFaceIdTag>(id);
+}
+
+inline const shared_ptr<lp::IncomingFaceIdTag>&
+Face::getIncomingFaceIdTag() const
+{
+  return m_incomingFaceIdTag;
 }
 
 inline FaceUri
@@ -35,6 +35,17 @@ namespace face {
 
 NFD_LOG_INIT(GenericLinkService);
 
+/** \brief Get a CongestionMarkTag for \p mark
+ *
+ *  Tags are immutable, so the tag for the common value 1 is shared among all packets.
+ */
+static shared_ptr<lp::CongestionMarkTag>
+makeCongestionMarkTag(uint64_t mark)
+{
+  static const auto markOne = make_shared<lp::CongestionMarkTag>(1);
+  return mark == 1 ? markOne : make_shared<lp::CongestionMarkTag>(mark);
+}
+
 constexpr size_t CONGESTION_MARK_SIZE = tlv::sizeOfVarNumber(lp::tlv::CongestionMark) + // type
                                         tlv::sizeOfVarNumber(sizeof(uint64_t)) +        // length
                                         tlv::sizeOfNonNegativeInteger(UINT64_MAX);      // value
@@ -98,6 +109,11 @@ GenericLinkService::doSendInterest(const Interest& interest, const EndpointId& e
   lp::Packet lpPacket(interest.wireEncode());
 
   encodeLpFields(interest, lpPacket);
+  if (!m_options.allowPitToken && lpPacket.has<lp::PitTokenField>()) {
+    // the forwarder only attaches PIT tokens when canSendPitToken() is true,
+    // this guards against Interests sent by other callers
+    lpPacket.remove<lp::PitTokenField>();
+  }
 
   this->sendNetPacket(std::move(lpPacket), endpointId, true);
 }
@@ -365,12 +381,13 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    interest->setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    interest->setTag(makeCongestionMarkTag(firstPkt.get<lp::CongestionMarkField>()));
   }
 
   if (firstPkt.has<lp::NonDiscoveryField>()) {
     if (m_options.allowSelfLearning) {
-      interest->setTag(make_shared<lp::NonDiscoveryTag>(firstPkt.get<lp::NonDiscoveryField>()));
+      static const auto nonDiscoveryTag = make_shared<lp::NonDiscoveryTag>(lp::EmptyValue{});
+      interest->setTag(nonDiscoveryTag);
     }
     else {
       NFD_LOG_FACE_WARN("received NonDiscovery, but self-learning disabled: IGNORE");
@@ -423,7 +440,7 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt,
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    data->setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    data->setTag(makeCongestionMarkTag(firstPkt.get<lp::CongestionMarkField>()));
   }
 
   if (firstPkt.has<lp::NonDiscoveryField>()) {
@@ -441,6 +458,10 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt,
     }
   }
 
+  if (firstPkt.has<lp::PitTokenField>() && m_options.allowPitToken) {
+    data->setTag(make_shared<lp::PitToken>(firstPkt.get<lp::PitTokenField>()));
+  }
+
   this->receiveData(*data, endpointId);
 }
 
@@ -471,7 +492,7 @@ GenericLinkService::decodeNack(const Block& netPkt, const lp::Packet& firstPkt,
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    nack.setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    nack.setTag(makeCongestionMarkTag(firstPkt.get<lp::CongestionMarkField>()));
   }
 
   if (firstPkt.has<lp::NonDiscoveryField>()) {
@@ -151,6 +151,14 @@ public:
     /** \brief enables self-learning forwarding support
      */
     bool allowSelfLearning = true;
+
+    /** \brief enables PIT tokens toward the upstream
+     *
+     *  If enabled, PIT tokens assigned by the forwarder are encoded in outgoing Interests,
+     *  and PIT tokens echoed in incoming Data are decoded. This must only be enabled if the
+     *  remote endpoint is known to echo PIT tokens.
+     */
+    bool allowPitToken = false;
   };
 
   /** \brief counters provided by GenericLinkService
@@ -173,6 +181,12 @@ public:
   const Counters&
   getCounters() const OVERRIDE_WITH_TESTS_ELSE_FINAL;
 
+  bool
+  canSendPitToken() const final
+  {
+    return m_options.allowPitToken;
+  }
+
 PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
   /** \brief request an IDLE packet to transmit pending service fields
    */
@@ -109,6 +109,17 @@ public:
   virtual const Counters&
   getCounters() const;
 
+  /** \brief whether a PIT token attached to an outgoing Interest is sent to the peer
+   *
+   *  The forwarder attaches its PIT tokens only to Interests sent through link services that
+   *  return true, so that other faces do not pay for the token.
+   */
+  virtual bool
+  canSendPitToken() const
+  {
+    return false;
+  }
+
 public: // upper interface to be used by forwarding
   /** \brief Send Interest to \p endpoint
    *  \pre setTransport has been called
@@ -50,8 +50,9 @@ NFD_LOG_INIT(MulticastEthernetTransport);
 
 MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                                                        const ethernet::Address& mcastAddress,
-                                                       ndn::nfd::LinkType linkType)
-  : EthernetTransport(localEndpoint, mcastAddress)
+                                                       ndn::nfd::LinkType linkType,
+                                                       IoBackend backend)
+  : EthernetTransport(localEndpoint, mcastAddress, backend)
 #if defined(__linux__)
   , m_interfaceIndex(localEndpoint.getIndex())
 #endif
@@ -65,17 +66,18 @@ MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkIn
 
   NFD_LOG_FACE_DEBUG("Creating transport");
 
-  char filter[110];
+  char filter[200];
   // note #1: we cannot use std::snprintf because it's not available
   //          on some platforms (see #2299)
   // note #2: "not vlan" must appear last in the filter expression, or the
   //          rest of the filter won't work as intended (see pcap-filter(7))
   snprintf(filter, sizeof(filter),
-           "(ether proto 0x%x) && (ether dst %s) && (not ether src %s) && (not vlan)",
+           "(ether proto 0x%x) && (ether dst %s) && (not ether src %s) && %s && (not vlan)",
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().data(),
-           m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+           m_srcAddress.toString().data(),
+           ethernet::getPayloadTypeFilter().data());
+  setPacketFilter(filter);
 
   BOOST_ASSERT(m_destAddress.isMulticast());
   if (!m_destAddress.isBroadcast())
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shared-udp-transport.hpp"
+#include "common/global.hpp"
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(SharedUdpTransport);
+
+SharedUdpTransport::SharedUdpTransport(shared_ptr<boost::asio::ip::udp::socket> socket,
+                                       const udp::Endpoint& remoteEndpoint,
+                                       ndn::nfd::FacePersistency persistency,
+                                       time::nanoseconds idleTimeout,
+                                       optional<ssize_t> overrideMtu)
+  : m_socket(std::move(socket))
+  , m_remoteEndpoint(remoteEndpoint)
+  , m_idleTimeout(idleTimeout)
+  , m_hasRecentlyReceived(false)
+{
+  this->setLocalUri(FaceUri(m_socket->local_endpoint()));
+  this->setRemoteUri(FaceUri(m_remoteEndpoint));
+  this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  this->setPersistency(persistency);
+  this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+
+  if (overrideMtu) {
+    this->setMtu(std::min(udp::computeMtu(m_socket->local_endpoint()), *overrideMtu));
+  }
+  else {
+    this->setMtu(udp::computeMtu(m_socket->local_endpoint()));
+  }
+  BOOST_ASSERT(this->getMtu() >= MIN_MTU);
+
+  // the socket buffer is shared by all faces on the channel
+  this->setSendQueueCapacity(QUEUE_UNSUPPORTED);
+
+  NFD_LOG_FACE_DEBUG("Creating transport");
+
+  if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      m_idleTimeout > time::nanoseconds::zero()) {
+    scheduleClosureWhenIdle();
+  }
+}
+
+bool
+SharedUdpTransport::canChangePersistencyToImpl(ndn::nfd::FacePersistency newPersistency) const
+{
+  return true;
+}
+
+void
+SharedUdpTransport::afterChangePersistency(ndn::nfd::FacePersistency oldPersistency)
+{
+  if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      m_idleTimeout > time::nanoseconds::zero()) {
+    scheduleClosureWhenIdle();
+  }
+  else {
+    m_closeIfIdleEvent.cancel();
+    setExpirationTime(time::steady_clock::TimePoint::max());
+  }
+}
+
+void
+SharedUdpTransport::doClose()
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // the socket belongs to the channel and stays open
+  m_closeIfIdleEvent.cancel();
+
+  getGlobalIoService().post([this] {
+    this->setState(TransportState::CLOSED);
+  });
+}
+
+void
+SharedUdpTransport::doSend(const Block& packet, const EndpointId&)
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // The socket is non-blocking: the datagram is either copied into the socket buffer
+  // immediately, or dropped, therefore no completion handler can outlive the transport.
+  boost::system::error_code error;
+  size_t nBytesSent = m_socket->send_to(boost::asio::buffer(packet), m_remoteEndpoint, 0, error);
+
+  if (error == boost::asio::error::would_block || error == boost::asio::error::no_buffer_space) {
+    NFD_LOG_FACE_DEBUG("Socket buffer is full, dropping " << packet.size() << " bytes");
+  }
+  else if (error) {
+    if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_PERMANENT) {
+      NFD_LOG_FACE_DEBUG("Permanent face ignores error: " << error.message());
+      return;
+    }
+    NFD_LOG_FACE_ERROR("Send operation failed: " << error.message());
+    this->setState(TransportState::FAILED);
+    doClose();
+  }
+  else {
+    NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
+  }
+}
+
+void
+SharedUdpTransport::receiveDatagram(const uint8_t* buffer, size_t nBytesReceived)
+{
+  NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
+
+  bool isOk = false;
+  Block element;
+  std::tie(isOk, element) = Block::fromBuffer(buffer, nBytesReceived);
+  if (!isOk) {
+    NFD_LOG_FACE_WARN("Failed to parse incoming packet");
+    // This packet won't extend the face lifetime
+    return;
+  }
+  if (element.size() != nBytesReceived) {
+    NFD_LOG_FACE_WARN("Received datagram size and decoded element size don't match");
+    // This packet won't extend the face lifetime
+    return;
+  }
+  m_hasRecentlyReceived = true;
+
+  this->receive(element);
+}
+
+void
+SharedUdpTransport::scheduleClosureWhenIdle()
+{
+  m_closeIfIdleEvent = getScheduler().schedule(m_idleTimeout, [this] {
+    if (!m_hasRecentlyReceived) {
+      NFD_LOG_FACE_INFO("Closing due to inactivity");
+      this->close();
+    }
+    else {
+      m_hasRecentlyReceived = false;
+      scheduleClosureWhenIdle();
+    }
+  });
+  setExpirationTime(time::steady_clock::now() + m_idleTimeout);
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_SHARED_UDP_TRANSPORT_HPP
+#define NFD_DAEMON_FACE_SHARED_UDP_TRANSPORT_HPP
+
+#include "transport.hpp"
+#include "udp-protocol.hpp"
+
+namespace nfd {
+namespace face {
+
+/**
+ * \brief A unicast Transport that sends and receives on a socket shared with other faces
+ *
+ * Unlike UnicastUdpTransport, this transport does not own a connected socket. Outgoing
+ * datagrams are sent with sendto(2) on an unconnected socket owned by UdpChannel, and
+ * incoming datagrams are read by the channel and dispatched to the transport of the sender
+ * via receiveDatagram(). This allows a single socket to serve an arbitrary number of peers.
+ */
+class SharedUdpTransport final : public Transport
+{
+public:
+  SharedUdpTransport(shared_ptr<boost::asio::ip::udp::socket> socket,
+                     const udp::Endpoint& remoteEndpoint,
+                     ndn::nfd::FacePersistency persistency,
+                     time::nanoseconds idleTimeout,
+                     optional<ssize_t> overrideMtu = {});
+
+  /** \brief Translate a datagram received by the channel into a packet, deliver to parent class.
+   */
+  void
+  receiveDatagram(const uint8_t* buffer, size_t nBytesReceived);
+
+protected:
+  bool
+  canChangePersistencyToImpl(ndn::nfd::FacePersistency newPersistency) const final;
+
+  void
+  afterChangePersistency(ndn::nfd::FacePersistency oldPersistency) final;
+
+  void
+  doClose() final;
+
+private:
+  void
+  doSend(const Block& packet, const EndpointId& endpoint) final;
+
+  void
+  scheduleClosureWhenIdle();
+
+private:
+  shared_ptr<boost::asio::ip::udp::socket> m_socket;
+  const udp::Endpoint m_remoteEndpoint;
+  const time::nanoseconds m_idleTimeout;
+  scheduler::ScopedEventId m_closeIfIdleEvent;
+  bool m_hasRecentlyReceived;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_SHARED_UDP_TRANSPORT_HPP
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shm-ring.hpp"
+
+#include <atomic>
+#include <cstring> // for memcpy()
+
+namespace nfd {
+namespace face {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "ShmRing requires lock-free atomics to be usable across processes");
+
+const uint32_t SHM_RING_MAGIC = 0x4E444E52; // "NDNR"
+const uint32_t WRAP_MARKER = 0xFFFFFFFF;
+const size_t RECORD_HDR_LEN = sizeof(uint32_t);
+const size_t RECORD_ALIGN = 8;
+const size_t CACHE_LINE = 64;
+
+// The producer and consumer indices live on separate cache lines to avoid false sharing.
+struct ShmRing::Header
+{
+  uint32_t magic;
+  uint32_t capacity;
+  alignas(CACHE_LINE) std::atomic<uint64_t> head;
+  alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+  alignas(CACHE_LINE) std::atomic<uint32_t> isConsumerWaiting;
+};
+
+constexpr size_t ShmRing::MIN_CAPACITY;
+constexpr size_t ShmRing::MAX_CAPACITY;
+
+static size_t
+alignRecord(size_t length)
+{
+  return (RECORD_HDR_LEN + length + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+size_t
+ShmRing::adjustCapacity(size_t capacity)
+{
+  size_t c = MIN_CAPACITY;
+  while (c < capacity && c < MAX_CAPACITY) {
+    c <<= 1;
+  }
+  return c;
+}
+
+size_t
+ShmRing::computeRegionSize(size_t capacity)
+{
+  BOOST_ASSERT(adjustCapacity(capacity) == capacity);
+  return sizeof(Header) + capacity;
+}
+
+ShmRing::ShmRing(uint8_t* region, size_t capacity, bool initialize)
+  : m_header(reinterpret_cast<Header*>(region))
+  , m_data(region + sizeof(Header))
+  , m_capacity(capacity)
+{
+  BOOST_ASSERT(adjustCapacity(capacity) == capacity);
+
+  if (initialize) {
+    m_header->magic = SHM_RING_MAGIC;
+    m_header->capacity = static_cast<uint32_t>(capacity);
+    m_header->head.store(0, std::memory_order_relaxed);
+    m_header->tail.store(0, std::memory_order_relaxed);
+    m_header->isConsumerWaiting.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  else {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_header->magic != SHM_RING_MAGIC || m_header->capacity != capacity) {
+      NDN_THROW(Error("Shared memory region does not contain a ring of the expected capacity"));
+    }
+  }
+
+  m_head = m_header->head.load(std::memory_order_relaxed);
+  m_tail = m_header->tail.load(std::memory_order_relaxed);
+}
+
+size_t
+ShmRing::getUsedBytes() const
+{
+  uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+  return std::min<uint64_t>(m_head - tail, m_capacity);
+}
+
+bool
+ShmRing::push(const uint8_t* record, size_t length)
+{
+  if (length > ndn::MAX_NDN_PACKET_SIZE) {
+    return false;
+  }
+
+  uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+  uint64_t used = m_head - tail;
+  if (used > m_capacity) {
+    NDN_THROW(Error("Consumer index is out of range"));
+  }
+
+  size_t offset = m_head & (m_capacity - 1);
+  size_t contiguous = m_capacity - offset;
+  size_t recordSize = alignRecord(length);
+  size_t needed = recordSize <= contiguous ? recordSize : contiguous + recordSize;
+  if (needed > m_capacity - used) {
+    return false;
+  }
+
+  if (recordSize > contiguous) {
+    // not enough room before the end of the buffer: skip to the beginning
+    std::memcpy(m_data + offset, &WRAP_MARKER, RECORD_HDR_LEN);
+    m_head += contiguous;
+    offset = 0;
+  }
+
+  uint32_t length32 = static_cast<uint32_t>(length);
+  std::memcpy(m_data + offset, &length32, RECORD_HDR_LEN);
+  std::memcpy(m_data + offset + RECORD_HDR_LEN, record, length);
+  m_head += recordSize;
+  m_header->head.store(m_head, std::memory_order_release);
+  return true;
+}
+
+bool
+ShmRing::needsWakeup()
+{
+  // pairs with the fence in prepareToWait(): either the consumer sees the new head,
+  // or we see its announcement
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_header->isConsumerWaiting.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  return m_header->isConsumerWaiting.exchange(0, std::memory_order_acq_rel) != 0;
+}
+
+size_t
+ShmRing::consume(const RecordCallback& onRecord, size_t maxRecords)
+{
+  uint64_t head = m_header->head.load(std::memory_order_acquire);
+  if (head - m_tail > m_capacity) {
+    NDN_THROW(Error("Producer index is out of range"));
+  }
+
+  size_t nConsumed = 0;
+  while (m_tail != head && nConsumed < maxRecords) {
+    size_t offset = m_tail & (m_capacity - 1);
+    size_t contiguous = m_capacity - offset;
+    uint32_t length;
+    std::memcpy(&length, m_data + offset, RECORD_HDR_LEN);
+
+    if (length == WRAP_MARKER) {
+      if (contiguous > head - m_tail) {
+        NDN_THROW(Error("Wrap marker is out of range"));
+      }
+      m_tail += contiguous;
+      continue;
+    }
+
+    size_t recordSize = alignRecord(length);
+    if (length > ndn::MAX_NDN_PACKET_SIZE || recordSize > contiguous || recordSize > head - m_tail) {
+      NDN_THROW(Error("Record length is out of range"));
+    }
+
+    onRecord(m_data + offset + RECORD_HDR_LEN, length);
+    m_tail += recordSize;
+    ++nConsumed;
+  }
+
+  m_header->tail.store(m_tail, std::memory_order_release);
+  return nConsumed;
+}
+
+bool
+ShmRing::prepareToWait()
+{
+  m_header->isConsumerWaiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_header->head.load(std::memory_order_acquire) == m_tail) {
+    return true;
+  }
+  m_header->isConsumerWaiting.store(0, std::memory_order_relaxed);
+  return false;
+}
+
+void
+ShmRing::endWait()
+{
+  m_header->isConsumerWaiting.store(0, std::memory_order_relaxed);
+}
+
+} // namespace face
+} // namespace nfd
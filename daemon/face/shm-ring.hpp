@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_SHM_RING_HPP
+#define NFD_DAEMON_FACE_SHM_RING_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief TLV-TYPE numbers of the messages that negotiate a shared-memory data path
+ *        on a Unix stream face.
+ *
+ * These elements are exchanged on the Unix stream socket only, they are never forwarded.
+ * @sa UnixStreamTransport
+ */
+namespace shm_tlv {
+enum : uint32_t {
+  Request      = 0xFE10, ///< client asks for shared-memory rings
+  Response     = 0xFE11, ///< NFD grants the request, file descriptors are attached
+  RingCapacity = 0xFE12, ///< NonNegativeInteger, capacity of each ring in bytes
+};
+} // namespace shm_tlv
+
+/**
+ * @brief Single-producer single-consumer ring of variable-size records in shared memory.
+ *
+ * The ring occupies a contiguous memory region of computeRegionSize() bytes, typically
+ * a MAP_SHARED mapping that is visible to two processes. One process only calls push() and
+ * needsWakeup(), the other only calls consume(), prepareToWait(), and endWait().
+ * Each record is a 4-octet length followed by the payload, padded to a multiple of 8 octets.
+ *
+ * The peer process is not trusted: every index and length read from the shared region is
+ * validated, and Error is thrown if the ring is found to be corrupted.
+ *
+ * Wakeups are batched: the consumer announces that it is about to sleep with prepareToWait(),
+ * and needsWakeup() returns true to at most one push() after that announcement.
+ */
+class ShmRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Invoked for each consumed record
+   * @param record pointer to the payload, valid only during the call; since the region is
+   *               shared with the peer, the payload must be copied before it is parsed
+   * @param length payload length
+   */
+  using RecordCallback = std::function<void(const uint8_t* record, size_t length)>;
+
+  static constexpr size_t MIN_CAPACITY = 1 << 16;
+  static constexpr size_t MAX_CAPACITY = 1 << 22;
+
+  /**
+   * @brief Round @p capacity to a valid ring capacity.
+   *
+   * The result is a power of two within [MIN_CAPACITY, MAX_CAPACITY].
+   */
+  static size_t
+  adjustCapacity(size_t capacity);
+
+  /**
+   * @brief Size of the memory region needed by a ring of @p capacity bytes
+   */
+  static size_t
+  computeRegionSize(size_t capacity);
+
+  /**
+   * @brief Attach to a ring stored in @p region.
+   * @param region pointer to computeRegionSize(capacity) bytes, aligned to a page boundary
+   * @param capacity a value returned by adjustCapacity()
+   * @param initialize if true, the ring header is (re)initialized
+   * @throw Error @p initialize is false and the region does not contain a ring of @p capacity
+   */
+  ShmRing(uint8_t* region, size_t capacity, bool initialize);
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * @brief Number of bytes currently occupied in the ring, as seen by the producer
+   */
+  size_t
+  getUsedBytes() const;
+
+  /**
+   * @brief Append a record (producer side).
+   * @return false if the record does not fit in the free space of the ring
+   * @throw Error the ring is corrupted
+   */
+  bool
+  push(const uint8_t* record, size_t length);
+
+  /**
+   * @brief Whether the consumer must be woken up after the preceding push() calls.
+   *
+   * Returns true at most once per prepareToWait() on the consumer side.
+   */
+  bool
+  needsWakeup();
+
+  /**
+   * @brief Consume up to @p maxRecords records (consumer side).
+   * @return number of records passed to @p onRecord
+   * @throw Error the ring is corrupted
+   */
+  size_t
+  consume(const RecordCallback& onRecord, size_t maxRecords);
+
+  /**
+   * @brief Announce that the consumer is about to sleep.
+   * @return true if the ring is still empty and the consumer may sleep until woken up;
+   *         false if records have arrived in the meantime, in which case the announcement
+   *         has already been withdrawn
+   */
+  bool
+  prepareToWait();
+
+  /**
+   * @brief Withdraw the announcement made by prepareToWait(), after waking up.
+   */
+  void
+  endWait();
+
+private:
+  struct Header;
+
+  Header* m_header;
+  uint8_t* m_data;
+  size_t m_capacity;
+  uint64_t m_head; ///< private copy of the producer index
+  uint64_t m_tail; ///< private copy of the consumer index
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_SHM_RING_HPP
@@ -26,9 +26,16 @@
 #include "socket-utils.hpp"
 #include "transport.hpp"
 
+#include <ndn-cxx/lp/tlv.hpp>
+
+#include <cerrno>
+
 #if defined(__linux__)
+#include <linux/filter.h>
+#include <linux/sock_diag.h> // for SK_MEMINFO_DROPS
 #include <linux/sockios.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #elif defined(__APPLE__)
 #include <sys/socket.h>
 #endif
@@ -53,5 +60,62 @@ getTxQueueLength(int fd)
   return queueLength;
 }
 
+bool
+attachNdnDatagramFilter(int fd)
+{
+#if defined(__linux__)
+  // The data seen by a filter on a UDP socket starts at the UDP header.
+  // Only 1-octet TLV-TYPEs are accepted, which covers Interest, Data, and LpPacket.
+  const uint32_t PAYLOAD = 8;
+  static const sock_filter code[] = {
+    /*  0 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, PAYLOAD),         // A = TLV-TYPE
+    /*  1 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, tlv::Interest, 2, 0),
+    /*  2 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, tlv::Data, 1, 0),
+    /*  3 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ndn::lp::tlv::LpPacket, 0, 16), // else goto 20
+    /*  4 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, PAYLOAD + 1),     // A = first octet of TLV-LENGTH
+    /*  5 */ BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, 253, 2, 0),       // multi-octet: goto 8
+    /*  6 */ BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 2),              // A = element size
+    /*  7 */ BPF_STMT(BPF_JMP | BPF_JA, 7),                       // goto 15
+    /*  8 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 253, 0, 3),       // else goto 12
+    /*  9 */ BPF_STMT(BPF_LD | BPF_H | BPF_ABS, PAYLOAD + 2),     // A = 2-octet TLV-LENGTH
+    /* 10 */ BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 4),              // A = element size
+    /* 11 */ BPF_STMT(BPF_JMP | BPF_JA, 3),                       // goto 15
+    /* 12 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 254, 0, 7),       // else goto 20
+    /* 13 */ BPF_STMT(BPF_LD | BPF_W | BPF_ABS, PAYLOAD + 2),     // A = 4-octet TLV-LENGTH
+    /* 14 */ BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 6),              // A = element size
+    /* 15 */ BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, PAYLOAD),        // A = expected datagram size
+    /* 16 */ BPF_STMT(BPF_MISC | BPF_TAX, 0),                     // X = A
+    /* 17 */ BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0),               // A = actual datagram size
+    /* 18 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_X, 0, 0, 1),         // else goto 20
+    /* 19 */ BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFF),               // accept
+    /* 20 */ BPF_STMT(BPF_RET | BPF_K, 0),                        // drop
+  };
+
+  sock_fprog prog{};
+  prog.len = sizeof(code) / sizeof(code[0]);
+  prog.filter = const_cast<sock_filter*>(code);
+  return ::setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == 0;
+#else
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+ssize_t
+getSocketDropCount(int fd)
+{
+#if defined(__linux__) && defined(SO_MEMINFO)
+  uint32_t meminfo[SK_MEMINFO_VARS] = {};
+  socklen_t len = sizeof(meminfo);
+  if (::getsockopt(fd, SOL_SOCKET, SO_MEMINFO, meminfo, &len) < 0 ||
+      len <= SK_MEMINFO_DROPS * sizeof(uint32_t)) {
+    return -1;
+  }
+  return meminfo[SK_MEMINFO_DROPS];
+#else
+  return -1;
+#endif
+}
+
 } // namespace face
 } // namespace nfd
@@ -42,6 +42,28 @@ namespace face {
 ssize_t
 getTxQueueLength(int fd);
 
+/** \brief Attach a classic BPF socket filter that drops malformed datagrams in the kernel.
+ *
+ *  The filter accepts a datagram only if its payload starts with the TLV-TYPE of an Interest,
+ *  a Data, or an LpPacket, and the TLV-LENGTH of that element matches the payload length.
+ *
+ *  \param fd a UDP socket
+ *  \return true if the filter has been attached; false on error or if not supported
+ *          on this platform, in which case errno is set
+ */
+bool
+attachNdnDatagramFilter(int fd);
+
+/** \brief Get the number of incoming packets dropped by the kernel on a socket.
+ *
+ *  This includes packets rejected by the socket filter and packets that did not fit
+ *  in the socket receive buffer.
+ *
+ *  \return the drop count, or -1 on error or if not supported on this platform
+ */
+ssize_t
+getSocketDropCount(int fd);
+
 } // namespace face
 } // namespace nfd
 
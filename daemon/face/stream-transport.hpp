@@ -79,6 +79,13 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  /** \brief Handle a TLV element extracted from the byte stream.
+   *
+   *  The default implementation passes the element to the link service.
+   */
+  virtual void
+  handleReceivedElement(const Block& element);
+
   void
   processErrorCode(const boost::system::error_code& error);
 
@@ -255,7 +262,7 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
     offset += element.size();
     BOOST_ASSERT(offset <= m_receiveBufferSize);
 
-    this->receive(element);
+    this->handleReceivedElement(element);
   }
 
   if (!isOk && m_receiveBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0) {
@@ -278,6 +285,13 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
   startReceive();
 }
 
+template<class T>
+void
+StreamTransport<T>::handleReceivedElement(const Block& element)
+{
+  this->receive(element);
+}
+
 template<class T>
 void
 StreamTransport<T>::processErrorCode(const boost::system::error_code& error)
@@ -26,9 +26,15 @@
 #include "udp-channel.hpp"
 #include "face.hpp"
 #include "generic-link-service.hpp"
+#include "shared-udp-transport.hpp"
+#include "socket-utils.hpp"
 #include "unicast-udp-transport.hpp"
 #include "common/global.hpp"
 
+#include <cerrno>       // for errno
+#include <cstring>      // for std::strerror()
+#include <sys/socket.h> // for setsockopt()
+
 namespace nfd {
 namespace face {
 
@@ -38,11 +44,18 @@ namespace ip = boost::asio::ip;
 
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
                        time::nanoseconds idleTimeout,
-                       bool wantCongestionMarking)
+                       bool wantCongestionMarking,
+                       size_t nListenSockets,
+                       bool wantConnectedFaces,
+                       bool wantKernelFilter,
+                       bool wantIoUring)
   : m_localEndpoint(localEndpoint)
-  , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(idleTimeout)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_nListenSockets(std::max<size_t>(nListenSockets, 1))
+  , m_wantConnectedFaces(wantConnectedFaces)
+  , m_wantKernelFilter(wantKernelFilter)
+  , m_wantIoUring(wantIoUring)
 {
   setUri(FaceUri(m_localEndpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -54,9 +67,14 @@ UdpChannel::connect(const udp::Endpoint& remoteEndpoint,
                     const FaceCreatedCallback& onFaceCreated,
                     const FaceCreationFailedCallback& onConnectFailed)
 {
+  shared_ptr<ip::udp::socket> sharedSocket;
+  if (!m_wantConnectedFaces && isListening()) {
+    sharedSocket = m_listenSockets.front()->socket;
+  }
+
   shared_ptr<Face> face;
   try {
-    face = createFace(remoteEndpoint, params).second;
+    face = createFace(remoteEndpoint, params, sharedSocket).second;
   }
   catch (const boost::system::system_error& e) {
     NFD_LOG_CHAN_DEBUG("Face creation for " << remoteEndpoint << " failed: " << e.what());
@@ -79,29 +97,65 @@ UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
     return;
   }
 
-  m_socket.open(m_localEndpoint.protocol());
-  m_socket.set_option(ip::udp::socket::reuse_address(true));
-  if (m_localEndpoint.address().is_v6()) {
-    m_socket.set_option(ip::v6_only(true));
+  size_t nListenSockets = m_nListenSockets;
+#ifndef SO_REUSEPORT
+  if (nListenSockets > 1) {
+    NFD_LOG_CHAN_WARN("SO_REUSEPORT is not supported, using a single listening socket");
+    nListenSockets = 1;
+  }
+#endif
+
+  std::vector<unique_ptr<ListenSocket>> listenSockets;
+  for (size_t i = 0; i < nListenSockets; ++i) {
+    auto ls = make_unique<ListenSocket>(getGlobalIoService());
+    ip::udp::socket& socket = *ls->socket;
+
+    socket.open(m_localEndpoint.protocol());
+    socket.set_option(ip::udp::socket::reuse_address(true));
+#ifdef SO_REUSEPORT
+    if (nListenSockets > 1) {
+      const int value = 1;
+      if (::setsockopt(socket.native_handle(), SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) < 0) {
+        NDN_THROW(boost::system::system_error(errno, boost::system::system_category(),
+                                              "setsockopt(SO_REUSEPORT)"));
+      }
+    }
+#endif
+    if (m_localEndpoint.address().is_v6()) {
+      socket.set_option(ip::v6_only(true));
+    }
+    if (!m_wantConnectedFaces) {
+      // see SharedUdpTransport::doSend
+      socket.non_blocking(true);
+    }
+    attachKernelFilter(socket);
+    socket.bind(m_localEndpoint);
+
+    listenSockets.push_back(std::move(ls));
   }
-  m_socket.bind(m_localEndpoint);
 
-  waitForNewPeer(onFaceCreated, onFaceCreationFailed);
-  NFD_LOG_CHAN_DEBUG("Started listening");
+  m_listenSockets = std::move(listenSockets);
+  for (const auto& ls : m_listenSockets) {
+    waitForNewPeer(*ls, onFaceCreated, onFaceCreationFailed);
+  }
+  NFD_LOG_CHAN_DEBUG("Started listening on " << m_listenSockets.size() << " socket(s)");
 }
 
 void
-UdpChannel::waitForNewPeer(const FaceCreatedCallback& onFaceCreated,
+UdpChannel::waitForNewPeer(ListenSocket& ls,
+                           const FaceCreatedCallback& onFaceCreated,
                            const FaceCreationFailedCallback& onReceiveFailed)
 {
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_remoteEndpoint,
-                              [=] (auto&&... args) {
-                                this->handleNewPeer(std::forward<decltype(args)>(args)..., onFaceCreated, onReceiveFailed);
-                              });
+  ls.socket->async_receive_from(boost::asio::buffer(ls.receiveBuffer), ls.remoteEndpoint,
+                                [=, &ls] (auto&&... args) {
+                                  this->handleNewPeer(ls, std::forward<decltype(args)>(args)...,
+                                                      onFaceCreated, onReceiveFailed);
+                                });
 }
 
 void
-UdpChannel::handleNewPeer(const boost::system::error_code& error,
+UdpChannel::handleNewPeer(ListenSocket& ls,
+                          const boost::system::error_code& error,
                           size_t nBytesReceived,
                           const FaceCreatedCallback& onFaceCreated,
                           const FaceCreationFailedCallback& onReceiveFailed)
@@ -115,37 +169,50 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
     return;
   }
 
-  NFD_LOG_CHAN_TRACE("New peer " << m_remoteEndpoint);
-
-  bool isCreated = false;
   shared_ptr<Face> face;
-  try {
-    FaceParams params;
-    params.persistency = ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
-    std::tie(isCreated, face) = createFace(m_remoteEndpoint, params);
-  }
-  catch (const boost::system::system_error& e) {
-    NFD_LOG_CHAN_DEBUG("Face creation for " << m_remoteEndpoint << " failed: " << e.what());
-    if (onReceiveFailed)
-      onReceiveFailed(504, "Face creation failed: "s + e.what());
-    return;
+  auto it = m_channelFaces.find(ls.remoteEndpoint);
+  if (it != m_channelFaces.end()) {
+    // in unconnected mode, this is the common case
+    face = it->second;
+    if (m_wantConnectedFaces)
+      NFD_LOG_CHAN_DEBUG("Received datagram for existing face");
   }
+  else {
+    NFD_LOG_CHAN_TRACE("New peer " << ls.remoteEndpoint);
+
+    try {
+      FaceParams params;
+      params.persistency = ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
+      face = createFace(ls.remoteEndpoint, params,
+                        m_wantConnectedFaces ? nullptr : ls.socket).second;
+    }
+    catch (const boost::system::system_error& e) {
+      NFD_LOG_CHAN_DEBUG("Face creation for " << ls.remoteEndpoint << " failed: " << e.what());
+      if (onReceiveFailed)
+        onReceiveFailed(504, "Face creation failed: "s + e.what());
+      return;
+    }
 
-  if (isCreated)
     onFaceCreated(face);
-  else
-    NFD_LOG_CHAN_DEBUG("Received datagram for existing face");
+  }
 
   // dispatch the datagram to the face for processing
-  auto* transport = static_cast<UnicastUdpTransport*>(face->getTransport());
-  transport->receiveDatagram(m_receiveBuffer.data(), nBytesReceived, error);
+  auto* transport = face->getTransport();
+  if (auto* sharedTransport = dynamic_cast<SharedUdpTransport*>(transport)) {
+    sharedTransport->receiveDatagram(ls.receiveBuffer.data(), nBytesReceived);
+  }
+  else {
+    static_cast<UnicastUdpTransport*>(transport)->receiveDatagram(ls.receiveBuffer.data(),
+                                                                  nBytesReceived, error);
+  }
 
-  waitForNewPeer(onFaceCreated, onReceiveFailed);
+  waitForNewPeer(ls, onFaceCreated, onReceiveFailed);
 }
 
 std::pair<bool, shared_ptr<Face>>
 UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
-                       const FaceParams& params)
+                       const FaceParams& params,
+                       const shared_ptr<ip::udp::socket>& sharedSocket)
 {
   auto it = m_channelFaces.find(remoteEndpoint);
   if (it != m_channelFaces.end()) {
@@ -155,10 +222,20 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   }
 
   // else, create a new face
-  ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
-  socket.set_option(ip::udp::socket::reuse_address(true));
-  socket.bind(m_localEndpoint);
-  socket.connect(remoteEndpoint);
+  unique_ptr<Transport> transport;
+  if (sharedSocket != nullptr) {
+    transport = make_unique<SharedUdpTransport>(sharedSocket, remoteEndpoint, params.persistency,
+                                                m_idleFaceTimeout, params.mtu);
+  }
+  else {
+    ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
+    socket.set_option(ip::udp::socket::reuse_address(true));
+    attachKernelFilter(socket);
+    socket.bind(m_localEndpoint);
+    socket.connect(remoteEndpoint);
+    transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
+                                                 m_idleFaceTimeout, params.mtu, m_wantIoUring);
+  }
 
   GenericLinkService::Options options;
   options.allowFragmentation = true;
@@ -181,8 +258,6 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   }
 
   auto linkService = make_unique<GenericLinkService>(options);
-  auto transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
-                                                    m_idleFaceTimeout, params.mtu);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_channelFaces[remoteEndpoint] = face;
@@ -191,5 +266,26 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   return {true, face};
 }
 
+uint64_t
+UdpChannel::getNInKernelDropped() const
+{
+  uint64_t nDropped = 0;
+  for (const auto& ls : m_listenSockets) {
+    ssize_t n = getSocketDropCount(ls->socket->native_handle());
+    if (n > 0) {
+      nDropped += static_cast<uint64_t>(n);
+    }
+  }
+  return nDropped;
+}
+
+void
+UdpChannel::attachKernelFilter(ip::udp::socket& socket)
+{
+  if (m_wantKernelFilter && !attachNdnDatagramFilter(socket.native_handle())) {
+    NFD_LOG_CHAN_WARN("Cannot attach socket filter: " << std::strerror(errno));
+  }
+}
+
 } // namespace face
 } // namespace nfd
@@ -46,15 +46,29 @@ public:
    * To enable creation of faces upon incoming connections,
    * one needs to explicitly call UdpChannel::listen method.
    * The created socket is bound to \p localEndpoint.
+   *
+   * \param nListenSockets number of listening sockets; if greater than one, the sockets
+   *                       share \p localEndpoint via SO_REUSEPORT and the kernel distributes
+   *                       incoming datagrams among them by hashing the 4-tuple
+   * \param wantConnectedFaces if true, each face gets its own connected socket; if false,
+   *                           faces send and receive on the listening sockets
+   * \param wantKernelFilter if true, malformed datagrams are dropped by a socket filter
+   *                         in the kernel, see attachNdnDatagramFilter()
+   * \param wantIoUring if true, faces with a connected socket use io_uring where available,
+   *                    see UringDatagramIo
    */
   UdpChannel(const udp::Endpoint& localEndpoint,
              time::nanoseconds idleTimeout,
-             bool wantCongestionMarking);
+             bool wantCongestionMarking,
+             size_t nListenSockets = 1,
+             bool wantConnectedFaces = true,
+             bool wantKernelFilter = false,
+             bool wantIoUring = false);
 
   bool
   isListening() const override
   {
-    return m_socket.is_open();
+    return !m_listenSockets.empty();
   }
 
   size_t
@@ -63,6 +77,28 @@ public:
     return m_channelFaces.size();
   }
 
+  size_t
+  getNListenSockets() const
+  {
+    return m_nListenSockets;
+  }
+
+  bool
+  wantConnectedFaces() const
+  {
+    return m_wantConnectedFaces;
+  }
+
+  /**
+   * \brief Get the number of datagrams dropped by the kernel on the listening sockets
+   *
+   * Like DatagramTransport::Counters::nInKernelDropped, this includes datagrams rejected by
+   * the socket filter and datagrams dropped because a socket receive buffer was full.
+   * The value is read from the sockets on every call.
+   */
+  uint64_t
+  getNInKernelDropped() const;
+
   /**
    * \brief Create a unicast UDP face toward \p remoteEndpoint
    */
@@ -88,32 +124,59 @@ public:
          const FaceCreationFailedCallback& onFaceCreationFailed);
 
 private:
+  /**
+   * \brief A socket used to "accept" new peers, and its receive state
+   */
+  struct ListenSocket
+  {
+    explicit
+    ListenSocket(boost::asio::io_service& ios)
+      : socket(make_shared<boost::asio::ip::udp::socket>(ios))
+    {
+    }
+
+    /// shared with the transports of the faces in unconnected mode
+    shared_ptr<boost::asio::ip::udp::socket> socket;
+    udp::Endpoint remoteEndpoint; ///< The latest peer that sent a datagram to this socket
+    std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> receiveBuffer;
+  };
+
   void
-  waitForNewPeer(const FaceCreatedCallback& onFaceCreated,
+  waitForNewPeer(ListenSocket& ls,
+                 const FaceCreatedCallback& onFaceCreated,
                  const FaceCreationFailedCallback& onReceiveFailed);
 
   /**
-   * \brief The channel has received a packet from a remote
-   *        endpoint not associated with any UDP face yet
+   * \brief The channel has received a packet on a listening socket
+   *
+   * In connected mode, the remote endpoint is not associated with any UDP face yet.
+   * In unconnected mode, the datagram can also belong to an existing face.
    */
   void
-  handleNewPeer(const boost::system::error_code& error,
+  handleNewPeer(ListenSocket& ls,
+                const boost::system::error_code& error,
                 size_t nBytesReceived,
                 const FaceCreatedCallback& onFaceCreated,
                 const FaceCreationFailedCallback& onReceiveFailed);
 
   std::pair<bool, shared_ptr<Face>>
   createFace(const udp::Endpoint& remoteEndpoint,
-             const FaceParams& params);
+             const FaceParams& params,
+             const shared_ptr<boost::asio::ip::udp::socket>& sharedSocket = nullptr);
+
+  void
+  attachKernelFilter(boost::asio::ip::udp::socket& socket);
 
 private:
   const udp::Endpoint m_localEndpoint;
-  udp::Endpoint m_remoteEndpoint; ///< The latest peer that started communicating with us
-  boost::asio::ip::udp::socket m_socket; ///< Socket used to "accept" new peers
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  std::vector<unique_ptr<ListenSocket>> m_listenSockets;
   std::map<udp::Endpoint, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
   bool m_wantCongestionMarking;
+  const size_t m_nListenSockets;
+  const bool m_wantConnectedFaces;
+  const bool m_wantKernelFilter;
+  const bool m_wantIoUring;
 };
 
 } // namespace face
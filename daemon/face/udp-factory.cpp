@@ -26,11 +26,15 @@
 #include "udp-factory.hpp"
 #include "generic-link-service.hpp"
 #include "multicast-udp-transport.hpp"
+#include "socket-utils.hpp"
 #include "common/global.hpp"
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/copy.hpp>
 
+#include <cerrno>
+#include <cstring> // for std::strerror()
+
 namespace nfd {
 namespace face {
 
@@ -66,6 +70,10 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   enable_v4 yes
   //   enable_v6 yes
   //   idle_timeout 600
+  //   listen_sockets 1
+  //   connected_faces yes
+  //   kernel_filter no
+  //   io_uring no
   //   mcast yes
   //   mcast_group 224.0.23.170
   //   mcast_port 56363
@@ -88,6 +96,10 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV4 = false;
   bool enableV6 = false;
   uint32_t idleTimeout = 600;
+  size_t nListenSockets = 1;
+  bool wantConnectedFaces = true;
+  bool wantKernelFilter = false;
+  bool wantIoUring = false;
   MulticastConfig mcastConfig;
 
   if (configSection) {
@@ -113,6 +125,21 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
       else if (key == "idle_timeout") {
         idleTimeout = ConfigFile::parseNumber<uint32_t>(pair, "face_system.udp");
       }
+      else if (key == "listen_sockets") {
+        nListenSockets = ConfigFile::parseNumber<uint32_t>(pair, "face_system.udp");
+        if (nListenSockets < 1 || nListenSockets > 64) {
+          NDN_THROW(ConfigFile::Error("face_system.udp.listen_sockets: value must be between 1 and 64"));
+        }
+      }
+      else if (key == "connected_faces") {
+        wantConnectedFaces = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
+      else if (key == "kernel_filter") {
+        wantKernelFilter = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
+      else if (key == "io_uring") {
+        wantIoUring = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
       else if (key == "keep_alive_interval") {
         // ignored
       }
@@ -173,13 +200,45 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
     }
   }
 
+  // the listening sockets of an existing channel cannot be rearranged
+  auto checkChannelUnchanged = [&] (const udp::Endpoint& endpoint) {
+    auto it = m_channels.find(endpoint);
+    if (it != m_channels.end() &&
+        (it->second->getNListenSockets() != nListenSockets ||
+         it->second->wantConnectedFaces() != wantConnectedFaces)) {
+      NDN_THROW(ConfigFile::Error("face_system.udp.listen_sockets and face_system.udp.connected_faces "
+                                  "cannot be changed on existing channel " +
+                                  it->second->getUri().toString() + ", restart NFD instead"));
+    }
+  };
+  if (enableV4) {
+    checkChannelUnchanged(udp::Endpoint(ip::udp::v4(), port));
+  }
+  if (enableV6) {
+    checkChannelUnchanged(udp::Endpoint(ip::udp::v6(), port));
+  }
+
   if (context.isDryRun) {
     return;
   }
 
+  if (m_wantKernelFilter != wantKernelFilter) {
+    NFD_LOG_INFO((wantKernelFilter ? "enabling" : "disabling") << " socket filter; existing channels "
+                 "and multicast faces are not affected");
+  }
+  m_wantKernelFilter = wantKernelFilter;
+
+  if (m_wantIoUring != wantIoUring) {
+    NFD_LOG_INFO((wantIoUring ? "enabling" : "disabling") << " io_uring; existing channels "
+                 "are not affected");
+  }
+  m_wantIoUring = wantIoUring;
+
   if (enableV4) {
     udp::Endpoint endpoint(ip::udp::v4(), port);
-    shared_ptr<UdpChannel> v4Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
+    shared_ptr<UdpChannel> v4Channel = this->createChannel(endpoint, time::seconds(idleTimeout),
+                                                                  nListenSockets, wantConnectedFaces, wantKernelFilter,
+                                                                  wantIoUring);
     if (wantListen && !v4Channel->isListening()) {
       v4Channel->listen(this->addFace, nullptr);
     }
@@ -192,7 +251,9 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
 
   if (enableV6) {
     udp::Endpoint endpoint(ip::udp::v6(), port);
-    shared_ptr<UdpChannel> v6Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
+    shared_ptr<UdpChannel> v6Channel = this->createChannel(endpoint, time::seconds(idleTimeout),
+                                                                  nListenSockets, wantConnectedFaces, wantKernelFilter,
+                                                                  wantIoUring);
     if (wantListen && !v6Channel->isListening()) {
       v6Channel->listen(this->addFace, nullptr);
     }
@@ -290,7 +351,11 @@ UdpFactory::doCreateFace(const CreateFaceRequest& req,
 
 shared_ptr<UdpChannel>
 UdpFactory::createChannel(const udp::Endpoint& localEndpoint,
-                          time::nanoseconds idleTimeout)
+                          time::nanoseconds idleTimeout,
+                          size_t nListenSockets,
+                          bool wantConnectedFaces,
+                          bool wantKernelFilter,
+                          bool wantIoUring)
 {
   auto it = m_channels.find(localEndpoint);
   if (it != m_channels.end())
@@ -302,7 +367,9 @@ UdpFactory::createChannel(const udp::Endpoint& localEndpoint,
                     ", endpoint already allocated to a UDP multicast face"));
   }
 
-  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout, m_wantCongestionMarking);
+  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout, m_wantCongestionMarking,
+                                              nListenSockets, wantConnectedFaces, wantKernelFilter,
+                                              wantIoUring);
   m_channels[localEndpoint] = channel;
   return channel;
 }
@@ -349,6 +416,9 @@ UdpFactory::createMulticastFace(const shared_ptr<const net::NetworkInterface>& n
 
   ip::udp::socket rxSock(getGlobalIoService());
   MulticastUdpTransport::openRxSocket(rxSock, mcastEp, localAddress, netif);
+  if (m_wantKernelFilter && !attachNdnDatagramFilter(rxSock.native_handle())) {
+    NFD_LOG_WARN("Cannot attach socket filter on " << localEp << ": " << std::strerror(errno));
+  }
   ip::udp::socket txSock(getGlobalIoService());
   MulticastUdpTransport::openTxSocket(txSock, udp::Endpoint(localAddress, 0), netif);
 
@@ -60,13 +60,22 @@ public:
    * If a multicast face is already active on the same local endpoint,
    * the creation fails and an exception is thrown.
    *
+   * \param nListenSockets see UdpChannel::UdpChannel
+   * \param wantConnectedFaces see UdpChannel::UdpChannel
+   * \param wantKernelFilter see UdpChannel::UdpChannel
+   * \param wantIoUring see UdpChannel::UdpChannel
+   *
    * \return always a valid pointer to a UdpChannel object, an exception
    *         is thrown if it cannot be created.
    * \throw UdpFactory::Error
    */
   shared_ptr<UdpChannel>
   createChannel(const udp::Endpoint& localEndpoint,
-                time::nanoseconds idleTimeout);
+                time::nanoseconds idleTimeout,
+                size_t nListenSockets = 1,
+                bool wantConnectedFaces = true,
+                bool wantKernelFilter = false,
+                bool wantIoUring = false);
 
   /**
    * \brief Create a multicast UDP face
@@ -123,6 +132,8 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  bool m_wantKernelFilter = false;
+  bool m_wantIoUring = false;
   std::map<udp::Endpoint, shared_ptr<UdpChannel>> m_channels;
 
   struct MulticastConfig
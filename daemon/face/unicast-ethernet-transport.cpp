@@ -37,8 +37,9 @@ UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterf
                                                    const ethernet::Address& remoteEndpoint,
                                                    ndn::nfd::FacePersistency persistency,
                                                    time::nanoseconds idleTimeout,
-                                                   optional<ssize_t> overrideMtu)
-  : EthernetTransport(localEndpoint, remoteEndpoint)
+                                                   optional<ssize_t> overrideMtu,
+                                                   IoBackend backend)
+  : EthernetTransport(localEndpoint, remoteEndpoint, backend)
   , m_idleTimeout(idleTimeout)
 {
   this->setLocalUri(FaceUri::fromDev(m_interfaceName));
@@ -56,17 +57,18 @@ UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterf
 
   NFD_LOG_FACE_DEBUG("Creating transport");
 
-  char filter[110];
+  char filter[200];
   // note #1: we cannot use std::snprintf because it's not available
   //          on some platforms (see #2299)
   // note #2: "not vlan" must appear last in the filter expression, or the
   //          rest of the filter won't work as intended (see pcap-filter(7))
   snprintf(filter, sizeof(filter),
-           "(ether proto 0x%x) && (ether src %s) && (ether dst %s) && (not vlan)",
+           "(ether proto 0x%x) && (ether src %s) && (ether dst %s) && %s && (not vlan)",
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().data(),
-           m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+           m_srcAddress.toString().data(),
+           ethernet::getPayloadTypeFilter().data());
+  setPacketFilter(filter);
 
   if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
       m_idleTimeout > time::nanoseconds::zero()) {
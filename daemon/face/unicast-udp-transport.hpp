@@ -39,10 +39,14 @@ NFD_LOG_MEMBER_DECL_SPECIALIZED((DatagramTransport<boost::asio::ip::udp, Unicast
 class UnicastUdpTransport final : public DatagramTransport<boost::asio::ip::udp, Unicast>
 {
 public:
+  /**
+   * \param wantIoUring see DatagramTransport::DatagramTransport
+   */
   UnicastUdpTransport(protocol::socket&& socket,
                       ndn::nfd::FacePersistency persistency,
                       time::nanoseconds idleTimeout,
-                      optional<ssize_t> overrideMtu = {});
+                      optional<ssize_t> overrideMtu = {},
+                      bool wantIoUring = false);
 
 protected:
   bool
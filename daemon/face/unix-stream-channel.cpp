@@ -26,7 +26,6 @@
 #include "unix-stream-channel.hpp"
 #include "face.hpp"
 #include "generic-link-service.hpp"
-#include "unix-stream-transport.hpp"
 #include "common/global.hpp"
 
 #include <boost/filesystem.hpp>
@@ -38,12 +37,14 @@ namespace face {
 NFD_LOG_INIT(UnixStreamChannel);
 
 UnixStreamChannel::UnixStreamChannel(const unix_stream::Endpoint& endpoint,
-                                     bool wantCongestionMarking)
+                                     bool wantCongestionMarking,
+                                     shared_ptr<ShmQuota> shmQuota)
   : m_endpoint(endpoint)
   , m_acceptor(getGlobalIoService())
   , m_socket(getGlobalIoService())
   , m_size(0)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_shmQuota(std::move(shmQuota))
 {
   setUri(FaceUri(m_endpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -135,7 +136,7 @@ UnixStreamChannel::handleAccept(const boost::system::error_code& error,
   GenericLinkService::Options options;
   options.allowCongestionMarking = m_wantCongestionMarking;
   auto linkService = make_unique<GenericLinkService>(options);
-  auto transport = make_unique<UnixStreamTransport>(std::move(m_socket));
+  auto transport = make_unique<UnixStreamTransport>(std::move(m_socket), m_shmQuota);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   ++m_size;
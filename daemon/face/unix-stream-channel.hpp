@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_UNIX_STREAM_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "unix-stream-transport.hpp"
 
 namespace nfd {
 
@@ -63,8 +64,12 @@ public:
    *
    * To enable creation of faces upon incoming connections, one
    * needs to explicitly call UnixStreamChannel::listen method.
+   *
+   * \param shmQuota quota for the shared memory of the faces created by this channel,
+   *                 see UnixStreamTransport
    */
-  UnixStreamChannel(const unix_stream::Endpoint& endpoint, bool wantCongestionMarking);
+  UnixStreamChannel(const unix_stream::Endpoint& endpoint, bool wantCongestionMarking,
+                    shared_ptr<ShmQuota> shmQuota = nullptr);
 
   ~UnixStreamChannel() override;
 
@@ -116,6 +121,7 @@ private:
   boost::asio::local::stream_protocol::socket m_socket;
   size_t m_size;
   bool m_wantCongestionMarking;
+  shared_ptr<ShmQuota> m_shmQuota;
 };
 
 } // namespace face
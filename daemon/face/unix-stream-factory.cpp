@@ -47,6 +47,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   // unix
   // {
   //   path /var/run/nfd.sock
+  //   shm_limit 134217728
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -59,6 +60,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   }
 
   std::string path = "/var/run/nfd.sock";
+  size_t shmLimit = ShmQuota::DEFAULT_LIMIT;
 
   for (const auto& pair : *configSection) {
     const std::string& key = pair.first;
@@ -67,6 +69,9 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
     if (key == "path") {
       path = value.get_value<std::string>();
     }
+    else if (key == "shm_limit") {
+      shmLimit = ConfigFile::parseNumber<size_t>(pair, "face_system.unix");
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option face_system.unix." + key));
     }
@@ -76,6 +81,8 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
     return;
   }
 
+  m_shmQuota->setLimit(shmLimit);
+
   auto channel = this->createChannel(path);
   if (!channel->isListening()) {
     channel->listen(this->addFace, nullptr);
@@ -93,7 +100,7 @@ UnixStreamFactory::createChannel(const std::string& unixSocketPath)
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = make_shared<UnixStreamChannel>(endpoint, m_wantCongestionMarking);
+  auto channel = make_shared<UnixStreamChannel>(endpoint, m_wantCongestionMarking, m_shmQuota);
   m_channels[endpoint] = channel;
   return channel;
 }
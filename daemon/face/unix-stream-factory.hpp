@@ -67,6 +67,7 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  shared_ptr<ShmQuota> m_shmQuota = make_shared<ShmQuota>();
   std::map<unix_stream::Endpoint, shared_ptr<UnixStreamChannel>> m_channels;
 };
 
@@ -24,14 +24,40 @@
  */
 
 #include "unix-stream-transport.hpp"
+#include "common/global.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#endif
 
 namespace nfd {
 namespace face {
 
 NFD_LOG_MEMBER_INIT_SPECIALIZED(StreamTransport<boost::asio::local::stream_protocol>, UnixStreamTransport);
 
-UnixStreamTransport::UnixStreamTransport(protocol::socket&& socket)
+// capacity of each shared-memory ring, unless the application asks for a different one
+const size_t DEFAULT_SHM_RING_CAPACITY = 1 << 22;
+// maximum number of packets processed per wakeup, so that other faces are not starved
+const size_t MAX_SHM_RX_BATCH = 64;
+
+const size_t ShmQuota::DEFAULT_LIMIT = 128 * 1024 * 1024;
+
+UnixStreamTransport::UnixStreamTransport(protocol::socket&& socket, shared_ptr<ShmQuota> shmQuota)
   : StreamTransport(std::move(socket))
+  , m_shmQuota(std::move(shmQuota))
+  , m_shmRegion(nullptr)
+  , m_shmRegionSize(0)
+  , m_rxDoorbell(getGlobalIoService())
+  , m_txDoorbell(-1)
 {
   static_assert(
     std::is_same<std::remove_cv<protocol::socket::native_handle_type>::type, int>::value,
@@ -48,5 +74,294 @@ UnixStreamTransport::UnixStreamTransport(protocol::socket&& socket)
   NFD_LOG_FACE_DEBUG("Creating transport");
 }
 
+UnixStreamTransport::~UnixStreamTransport()
+{
+  releaseSharedMemory();
+}
+
+ssize_t
+UnixStreamTransport::getSendQueueLength()
+{
+  ssize_t queueLength = StreamTransport::getSendQueueLength();
+  if (m_txRing != nullptr) {
+    queueLength += m_txRing->getUsedBytes();
+  }
+  return queueLength;
+}
+
+void
+UnixStreamTransport::doClose()
+{
+  m_rxEvent.cancel();
+  if (m_rxDoorbell.is_open()) {
+    // use the non-throwing variant and ignore errors, if any
+    boost::system::error_code error;
+    m_rxDoorbell.cancel(error);
+  }
+
+  // the rings stay mapped until destruction, because handlers may still be pending
+  StreamTransport::doClose();
+}
+
+void
+UnixStreamTransport::doSend(const Block& packet, const EndpointId& endpoint)
+{
+  if (m_txRing == nullptr) {
+    return StreamTransport::doSend(packet, endpoint);
+  }
+
+  if (getState() != TransportState::UP)
+    return;
+
+  try {
+    if (!m_txRing->push(packet.wire(), packet.size())) {
+      NFD_LOG_FACE_DEBUG("Shared memory ring is full, dropping packet of size " << packet.size());
+      return;
+    }
+  }
+  catch (const ShmRing::Error& e) {
+    NFD_LOG_FACE_ERROR("Shared memory ring is corrupted: " << e.what());
+    this->setState(TransportState::FAILED);
+    doClose();
+    return;
+  }
+
+  if (m_txRing->needsWakeup()) {
+    uint64_t one = 1;
+    if (::write(m_txDoorbell, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+      NFD_LOG_FACE_WARN("Failed to wake up the application: " << std::strerror(errno));
+    }
+  }
+}
+
+void
+UnixStreamTransport::handleReceivedElement(const Block& element)
+{
+  if (element.type() == shm_tlv::Request) {
+    handleShmRequest(element);
+  }
+  else {
+    this->receive(element);
+  }
+}
+
+void
+UnixStreamTransport::handleShmRequest(const Block& request)
+{
+#if defined(__linux__)
+  if (m_rxRing != nullptr) {
+    NFD_LOG_FACE_WARN("Ignoring shared memory request: already using shared memory");
+    return;
+  }
+  if (getSendQueueBytes() > 0) {
+    // the response must not be interleaved with a partially written packet
+    NFD_LOG_FACE_WARN("Ignoring shared memory request: not the first packet on the socket");
+    return;
+  }
+
+  size_t capacity = DEFAULT_SHM_RING_CAPACITY;
+  try {
+    request.parse();
+    auto it = request.find(shm_tlv::RingCapacity);
+    if (it != request.elements_end()) {
+      capacity = static_cast<size_t>(std::min<uint64_t>(ndn::encoding::readNonNegativeInteger(*it),
+                                                        ShmRing::MAX_CAPACITY));
+    }
+  }
+  catch (const tlv::Error& e) {
+    NFD_LOG_FACE_WARN("Ignoring malformed shared memory request: " << e.what());
+    return;
+  }
+  capacity = ShmRing::adjustCapacity(capacity);
+  size_t ringRegionSize = ShmRing::computeRegionSize(capacity);
+
+  if (m_shmQuota != nullptr && !m_shmQuota->reserve(2 * ringRegionSize)) {
+    NFD_LOG_FACE_WARN("Ignoring shared memory request: limit of " << m_shmQuota->getLimit() <<
+                      " bytes would be exceeded");
+    return;
+  }
+  auto releaseQuota = [this, ringRegionSize] {
+    if (m_shmQuota != nullptr)
+      m_shmQuota->release(2 * ringRegionSize);
+  };
+
+  int fds[3] = {-1, -1, -1};
+  auto closeFds = [&fds] {
+    for (int fd : fds) {
+      if (fd >= 0)
+        ::close(fd);
+    }
+  };
+
+  // the size is sealed before the memfd is passed to the application: if the application could
+  // shrink it, accessing the truncated part of the mapping would raise SIGBUS in NFD
+  fds[0] = ::memfd_create("nfd-face-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  fds[1] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  fds[2] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (fds[0] < 0 || fds[1] < 0 || fds[2] < 0 || ::ftruncate(fds[0], 2 * ringRegionSize) < 0 ||
+      ::fcntl(fds[0], F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+    NFD_LOG_FACE_WARN("Cannot allocate shared memory: " << std::strerror(errno));
+    closeFds();
+    releaseQuota();
+    return;
+  }
+
+  void* region = ::mmap(nullptr, 2 * ringRegionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+  if (region == MAP_FAILED) {
+    NFD_LOG_FACE_WARN("Cannot map shared memory: " << std::strerror(errno));
+    closeFds();
+    releaseQuota();
+    return;
+  }
+  m_shmRegion = static_cast<uint8_t*>(region);
+  m_shmRegionSize = 2 * ringRegionSize;
+  m_rxRing = make_unique<ShmRing>(m_shmRegion, capacity, true);
+  m_txRing = make_unique<ShmRing>(m_shmRegion + ringRegionSize, capacity, true);
+
+  Block response(shm_tlv::Response);
+  response.push_back(ndn::encoding::makeNonNegativeIntegerBlock(shm_tlv::RingCapacity, capacity));
+  response.encode();
+
+  iovec iov{const_cast<uint8_t*>(response.wire()), response.size()};
+  union {
+    char buf[CMSG_SPACE(sizeof(fds))];
+    cmsghdr align;
+  } control;
+  std::memset(&control, 0, sizeof(control));
+
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  ssize_t nSent = ::sendmsg(m_socket.native_handle(), &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+  int sendErrno = errno;
+
+  // the mapping keeps the shared memory alive, the memfd itself is no longer needed here
+  ::close(fds[0]);
+  if (nSent != static_cast<ssize_t>(response.size())) {
+    ::close(fds[1]);
+    ::close(fds[2]);
+    releaseSharedMemory();
+    if (nSent > 0) {
+      NFD_LOG_FACE_ERROR("Shared memory response was truncated");
+      this->setState(TransportState::FAILED);
+      doClose();
+    }
+    else {
+      NFD_LOG_FACE_WARN("Cannot send shared memory response: " << std::strerror(sendErrno));
+    }
+    return;
+  }
+
+  m_rxDoorbell.assign(fds[1]);
+  m_txDoorbell = fds[2];
+  NFD_LOG_FACE_INFO("Using shared memory rings of " << capacity << " bytes");
+  receiveFromRing();
+#else
+  NFD_LOG_FACE_DEBUG("Ignoring shared memory request: not supported on this platform");
+#endif // __linux__
+}
+
+void
+UnixStreamTransport::receiveFromRing()
+{
+  BOOST_ASSERT(m_rxRing != nullptr);
+
+  size_t nRecords = 0;
+  try {
+    nRecords = m_rxRing->consume([this] (const uint8_t* record, size_t length) {
+      if (getState() != TransportState::UP)
+        return;
+
+      // Block::fromBuffer copies the record out of shared memory before it is parsed further
+      bool isOk = false;
+      Block element;
+      std::tie(isOk, element) = Block::fromBuffer(record, length);
+      if (!isOk || element.size() != length) {
+        NFD_LOG_FACE_WARN("Failed to parse incoming packet from shared memory");
+        return;
+      }
+      this->receive(element);
+    }, MAX_SHM_RX_BATCH);
+  }
+  catch (const ShmRing::Error& e) {
+    NFD_LOG_FACE_ERROR("Shared memory ring is corrupted: " << e.what());
+    this->setState(TransportState::FAILED);
+    doClose();
+    return;
+  }
+
+  if (getState() != TransportState::UP)
+    return;
+
+  if (nRecords == MAX_SHM_RX_BATCH || !m_rxRing->prepareToWait()) {
+    // more packets are available, continue after other pending events have been processed
+    m_rxEvent = getScheduler().schedule(0_ns, [this] { receiveFromRing(); });
+  }
+  else {
+    asyncWaitDoorbell();
+  }
+}
+
+void
+UnixStreamTransport::asyncWaitDoorbell()
+{
+  m_rxDoorbell.async_read_some(boost::asio::null_buffers(), [this] (const auto& error, auto) {
+    if (error) {
+      // boost::asio::error::operation_aborted must be checked first: in that case, the Transport
+      // may already have been destructed, therefore it's unsafe to call getState() or do logging.
+      if (error != boost::asio::error::operation_aborted &&
+          getState() != TransportState::CLOSING &&
+          getState() != TransportState::FAILED &&
+          getState() != TransportState::CLOSED) {
+        NFD_LOG_FACE_ERROR("Doorbell wait failed: " << error.message());
+        this->setState(TransportState::FAILED);
+        doClose();
+      }
+      return;
+    }
+
+    // reset the eventfd counter, the value itself is irrelevant
+    uint64_t value = 0;
+    ssize_t nRead = ::read(m_rxDoorbell.native_handle(), &value, sizeof(value));
+    BOOST_UNUSED(nRead);
+
+    m_rxRing->endWait();
+    receiveFromRing();
+  });
+}
+
+void
+UnixStreamTransport::releaseSharedMemory()
+{
+  m_rxRing.reset();
+  m_txRing.reset();
+
+#if defined(__linux__)
+  if (m_shmRegion != nullptr) {
+    ::munmap(m_shmRegion, m_shmRegionSize);
+    if (m_shmQuota != nullptr) {
+      m_shmQuota->release(m_shmRegionSize);
+    }
+    m_shmRegion = nullptr;
+    m_shmRegionSize = 0;
+  }
+#endif
+
+  boost::system::error_code error;
+  m_rxDoorbell.close(error);
+  if (m_txDoorbell >= 0) {
+    ::close(m_txDoorbell);
+    m_txDoorbell = -1;
+  }
+}
+
 } // namespace face
 } // namespace nfd
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_UNIX_STREAM_TRANSPORT_HPP
 
 #include "stream-transport.hpp"
+#include "shm-ring.hpp"
 
 #ifndef HAVE_UNIX_SOCKETS
 #error "Cannot include this file when UNIX sockets are not available"
@@ -37,14 +38,150 @@ namespace face {
 
 NFD_LOG_MEMBER_DECL_SPECIALIZED(StreamTransport<boost::asio::local::stream_protocol>);
 
+/**
+ * \brief Limits the total size of the shared memory regions allocated by UnixStreamTransports
+ *
+ * A single quota is shared by all Unix stream faces, so that local applications cannot make NFD
+ * allocate an unbounded amount of memory by opening many faces.
+ */
+class ShmQuota : noncopyable
+{
+public:
+  explicit
+  ShmQuota(size_t limit = DEFAULT_LIMIT)
+    : m_limit(limit)
+  {
+  }
+
+  size_t
+  getLimit() const
+  {
+    return m_limit;
+  }
+
+  /**
+   * \brief Change the limit
+   *
+   * Regions that have already been allocated are not affected, even if they exceed the new limit.
+   */
+  void
+  setLimit(size_t limit)
+  {
+    m_limit = limit;
+  }
+
+  size_t
+  getUsage() const
+  {
+    return m_usage;
+  }
+
+  /**
+   * \brief Reserve @p size bytes
+   * \return false if the reservation would exceed the limit, in which case nothing is reserved
+   */
+  bool
+  reserve(size_t size)
+  {
+    if (size > m_limit || m_usage > m_limit - size) {
+      return false;
+    }
+    m_usage += size;
+    return true;
+  }
+
+  /**
+   * \brief Return @p size bytes previously reserved with reserve()
+   */
+  void
+  release(size_t size)
+  {
+    BOOST_ASSERT(size <= m_usage);
+    m_usage -= size;
+  }
+
+public:
+  static const size_t DEFAULT_LIMIT;
+
+private:
+  size_t m_limit;
+  size_t m_usage = 0;
+};
+
 /**
  * \brief A Transport that communicates on a stream-oriented Unix domain socket
+ *
+ * A local application can move the data path of the face to a pair of shared-memory rings
+ * (see ShmRing) by sending a shm_tlv::Request element as its first packet. NFD answers with a
+ * shm_tlv::Response element, to which three file descriptors are attached with SCM_RIGHTS:
+ *  -# a memfd holding the application-to-NFD ring followed by the NFD-to-application ring;
+ *  -# an eventfd that the application writes to when ShmRing::needsWakeup() returns true
+ *     for the application-to-NFD ring;
+ *  -# an eventfd that NFD writes to when ShmRing::needsWakeup() returns true for the
+ *     NFD-to-application ring.
+ *
+ * Afterwards, packets are exchanged through the rings only, and the Unix socket is kept open
+ * to detect the termination of the application. The memfd is sealed, so that the application
+ * cannot shrink it while NFD has it mapped. A request is ignored if granting it would exceed
+ * the ShmQuota of the face. Shared memory is only supported on Linux;
+ * on other platforms the request is ignored and the face keeps using the socket.
  */
 class UnixStreamTransport final : public StreamTransport<boost::asio::local::stream_protocol>
 {
 public:
+  /**
+   * \param socket connected Unix stream socket
+   * \param shmQuota quota charged for the shared memory of this face; if nullptr, the size of
+   *                 the shared memory is only limited by ShmRing::MAX_CAPACITY
+   */
   explicit
-  UnixStreamTransport(protocol::socket&& socket);
+  UnixStreamTransport(protocol::socket&& socket, shared_ptr<ShmQuota> shmQuota = nullptr);
+
+  ~UnixStreamTransport() override;
+
+  ssize_t
+  getSendQueueLength() override;
+
+  /**
+   * \brief Whether the data path has been moved to shared memory
+   */
+  bool
+  isUsingSharedMemory() const
+  {
+    return m_rxRing != nullptr;
+  }
+
+private:
+  void
+  doClose() override;
+
+  void
+  doSend(const Block& packet, const EndpointId& endpoint) override;
+
+  void
+  handleReceivedElement(const Block& element) override;
+
+  void
+  handleShmRequest(const Block& request);
+
+  void
+  receiveFromRing();
+
+  void
+  asyncWaitDoorbell();
+
+  void
+  releaseSharedMemory();
+
+private:
+  shared_ptr<ShmQuota> m_shmQuota;
+  uint8_t* m_shmRegion;
+  size_t m_shmRegionSize;
+  unique_ptr<ShmRing> m_rxRing;
+  unique_ptr<ShmRing> m_txRing;
+  boost::asio::posix::stream_descriptor m_rxDoorbell;
+  int m_txDoorbell;
+  scheduler::ScopedEventId m_rxEvent;
 };
 
 } // namespace face
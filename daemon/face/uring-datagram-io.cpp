@@ -0,0 +1,326 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uring-datagram-io.hpp"
+#include "common/global.hpp"
+
+#ifdef HAVE_IO_URING
+#include <cerrno>
+#include <cstring> // for strerror()
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace nfd {
+namespace face {
+
+#ifdef HAVE_IO_URING
+
+// user_data of the multishot receive request; send requests use 1, 2, ...
+const uint64_t RECEIVE_ID = 0;
+// user_data of the request that cancels the receive request
+const uint64_t CANCEL_ID = std::numeric_limits<uint64_t>::max();
+// ID of the provided buffer group; every instance has its own ring, so one ID suffices
+const int BUFFER_GROUP_ID = 0;
+// number of submission queue entries; more sends in one event loop turn are submitted early
+const unsigned QUEUE_DEPTH = 256;
+
+static bool
+probeKernel()
+{
+  io_uring ring;
+  if (io_uring_queue_init(4, &ring, 0) < 0) {
+    return false;
+  }
+
+  // multishot receive (Linux 6.0) is the most recent feature used by this class,
+  // so send one datagram through a socketpair and check that it is delivered that way
+  bool isOk = false;
+  int ret = 0;
+  uint8_t buffer[16];
+  int fds[2] = {-1, -1};
+  io_uring_buf_ring* bufRing = io_uring_setup_buf_ring(&ring, 1, BUFFER_GROUP_ID, 0, &ret);
+  if (bufRing != nullptr && ::socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, fds) == 0) {
+    io_uring_buf_ring_add(bufRing, buffer, sizeof(buffer), 0, io_uring_buf_ring_mask(1), 0);
+    io_uring_buf_ring_advance(bufRing, 1);
+
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+    io_uring_prep_recv_multishot(sqe, fds[0], nullptr, 0, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP_ID;
+    io_uring_submit(&ring);
+
+    io_uring_cqe* cqe = nullptr;
+    __kernel_timespec timeout{1, 0};
+    if (::send(fds[1], "x", 1, 0) == 1 &&
+        io_uring_wait_cqe_timeout(&ring, &cqe, &timeout) == 0) {
+      isOk = cqe->res == 1 && (cqe->flags & IORING_CQE_F_BUFFER) && (cqe->flags & IORING_CQE_F_MORE);
+      io_uring_cqe_seen(&ring, cqe);
+    }
+  }
+
+  if (fds[0] >= 0) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+  if (bufRing != nullptr) {
+    io_uring_free_buf_ring(&ring, bufRing, 1, BUFFER_GROUP_ID);
+  }
+  io_uring_queue_exit(&ring);
+  return isOk;
+}
+
+bool
+UringDatagramIo::isSupported()
+{
+  static const bool isOk = probeKernel();
+  return isOk;
+}
+
+UringDatagramIo::UringDatagramIo(int socketFd, ReceiveCallback onReceive, SendCallback onSend)
+  : m_socketFd(socketFd)
+  , m_onReceive(std::move(onReceive))
+  , m_onSend(std::move(onSend))
+  , m_buffers(N_RECEIVE_BUFFERS * ndn::MAX_NDN_PACKET_SIZE)
+  , m_eventFd(getGlobalIoService())
+{
+  int ret = io_uring_queue_init(QUEUE_DEPTH, &m_ring, 0);
+  if (ret < 0) {
+    NDN_THROW(Error("io_uring_queue_init: "s + std::strerror(-ret)));
+  }
+
+  m_bufRing = io_uring_setup_buf_ring(&m_ring, N_RECEIVE_BUFFERS, BUFFER_GROUP_ID, 0, &ret);
+  if (m_bufRing == nullptr) {
+    io_uring_queue_exit(&m_ring);
+    NDN_THROW(Error("io_uring_setup_buf_ring: "s + std::strerror(-ret)));
+  }
+  for (unsigned i = 0; i < N_RECEIVE_BUFFERS; ++i) {
+    io_uring_buf_ring_add(m_bufRing, &m_buffers[i * ndn::MAX_NDN_PACKET_SIZE], ndn::MAX_NDN_PACKET_SIZE,
+                          i, io_uring_buf_ring_mask(N_RECEIVE_BUFFERS), i);
+  }
+  io_uring_buf_ring_advance(m_bufRing, N_RECEIVE_BUFFERS);
+
+  int eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (eventFd < 0 || (ret = io_uring_register_eventfd(&m_ring, eventFd)) < 0) {
+    std::string reason = std::strerror(eventFd < 0 ? errno : -ret);
+    if (eventFd >= 0) {
+      ::close(eventFd);
+    }
+    io_uring_free_buf_ring(&m_ring, m_bufRing, N_RECEIVE_BUFFERS, BUFFER_GROUP_ID);
+    io_uring_queue_exit(&m_ring);
+    NDN_THROW(Error("Cannot set up completion eventfd: " + reason));
+  }
+  m_eventFd.assign(eventFd);
+
+  armReceive();
+  io_uring_submit(&m_ring);
+  asyncWaitCompletions();
+}
+
+UringDatagramIo::~UringDatagramIo()
+{
+  close();
+
+  // exiting the ring cancels whatever is still in flight; the buffers of pending sends
+  // are released afterwards, when m_pendingSends is destroyed
+  io_uring_free_buf_ring(&m_ring, m_bufRing, N_RECEIVE_BUFFERS, BUFFER_GROUP_ID);
+  io_uring_queue_exit(&m_ring);
+}
+
+void
+UringDatagramIo::send(const Block& packet)
+{
+  if (!m_isOpen)
+    return;
+
+  io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+  if (sqe == nullptr) {
+    // the submission queue is full, hand it over to the kernel now
+    io_uring_submit(&m_ring);
+    sqe = io_uring_get_sqe(&m_ring);
+    BOOST_ASSERT(sqe != nullptr);
+  }
+
+  uint64_t id = ++m_lastSendId;
+  const Block& queued = m_pendingSends.emplace(id, packet).first->second;
+  io_uring_prep_send(sqe, m_socketFd, queued.wire(), queued.size(), 0);
+  io_uring_sqe_set_data64(sqe, id);
+  scheduleSubmit();
+}
+
+void
+UringDatagramIo::close()
+{
+  if (!m_isOpen)
+    return;
+  m_isOpen = false;
+
+  io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+  if (sqe == nullptr) {
+    io_uring_submit(&m_ring);
+    sqe = io_uring_get_sqe(&m_ring);
+  }
+  if (sqe != nullptr) {
+    io_uring_prep_cancel64(sqe, RECEIVE_ID, 0);
+    io_uring_sqe_set_data64(sqe, CANCEL_ID);
+  }
+  // this also submits the sends queued during the current event loop turn
+  io_uring_submit(&m_ring);
+
+  boost::system::error_code error;
+  m_eventFd.cancel(error);
+  m_eventFd.close(error);
+}
+
+void
+UringDatagramIo::armReceive()
+{
+  if (!m_isOpen)
+    return;
+
+  io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+  if (sqe == nullptr) {
+    io_uring_submit(&m_ring);
+    sqe = io_uring_get_sqe(&m_ring);
+    BOOST_ASSERT(sqe != nullptr);
+  }
+  io_uring_prep_recv_multishot(sqe, m_socketFd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BUFFER_GROUP_ID;
+  io_uring_sqe_set_data64(sqe, RECEIVE_ID);
+}
+
+void
+UringDatagramIo::scheduleSubmit()
+{
+  if (m_isSubmitScheduled)
+    return;
+  m_isSubmitScheduled = true;
+
+  // the token expires when this object is destroyed, before the posted handler runs
+  getGlobalIoService().post([this, token = std::weak_ptr<char>(m_token)] {
+    if (token.expired())
+      return;
+    m_isSubmitScheduled = false;
+    if (m_isOpen) {
+      io_uring_submit(&m_ring);
+    }
+  });
+}
+
+void
+UringDatagramIo::asyncWaitCompletions()
+{
+  m_eventFd.async_read_some(boost::asio::buffer(&m_eventCount, sizeof(m_eventCount)),
+                            [this] (const boost::system::error_code& error, size_t) {
+                              if (error == boost::asio::error::operation_aborted || !m_isOpen)
+                                return;
+                              processCompletions();
+                              if (m_isOpen)
+                                asyncWaitCompletions();
+                            });
+}
+
+void
+UringDatagramIo::processCompletions()
+{
+  io_uring_cqe* cqe = nullptr;
+  // stop as soon as a callback closes this object; the callbacks may also queue new sends
+  while (m_isOpen && io_uring_peek_cqe(&m_ring, &cqe) == 0) {
+    uint64_t id = io_uring_cqe_get_data64(cqe);
+    int res = cqe->res;
+    unsigned flags = cqe->flags;
+    io_uring_cqe_seen(&m_ring, cqe);
+
+    if (id == RECEIVE_ID) {
+      if ((flags & IORING_CQE_F_MORE) == 0) {
+        // the kernel terminated the multishot request, e.g., because it ran out of buffers;
+        // the buffers are returned below, before the new request is submitted
+        armReceive();
+        scheduleSubmit();
+      }
+
+      if (res < 0) {
+        if (res != -ENOBUFS) {
+          m_onReceive(nullptr, 0, boost::system::error_code(-res, boost::system::system_category()));
+        }
+        continue;
+      }
+
+      unsigned bufferId = flags >> IORING_CQE_BUFFER_SHIFT;
+      uint8_t* buffer = &m_buffers[bufferId * ndn::MAX_NDN_PACKET_SIZE];
+      m_onReceive(buffer, static_cast<size_t>(res), {});
+
+      io_uring_buf_ring_add(m_bufRing, buffer, ndn::MAX_NDN_PACKET_SIZE,
+                            bufferId, io_uring_buf_ring_mask(N_RECEIVE_BUFFERS), 0);
+      io_uring_buf_ring_advance(m_bufRing, 1);
+    }
+    else if (id != CANCEL_ID) {
+      auto it = m_pendingSends.find(id);
+      if (it == m_pendingSends.end())
+        continue;
+      m_pendingSends.erase(it);
+
+      if (res < 0) {
+        m_onSend(boost::system::error_code(-res, boost::system::system_category()), 0);
+      }
+      else {
+        m_onSend({}, static_cast<size_t>(res));
+      }
+    }
+  }
+}
+
+#else // HAVE_IO_URING
+
+bool
+UringDatagramIo::isSupported()
+{
+  return false;
+}
+
+UringDatagramIo::UringDatagramIo(int, ReceiveCallback, SendCallback)
+{
+  NDN_THROW(Error("NFD was compiled without io_uring support"));
+}
+
+UringDatagramIo::~UringDatagramIo() = default;
+
+void
+UringDatagramIo::send(const Block&)
+{
+}
+
+void
+UringDatagramIo::close()
+{
+}
+
+#endif // HAVE_IO_URING
+
+} // namespace face
+} // namespace nfd
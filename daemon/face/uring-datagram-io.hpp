@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_URING_DATAGRAM_IO_HPP
+#define NFD_DAEMON_FACE_URING_DATAGRAM_IO_HPP
+
+#include "core/common.hpp"
+
+#ifdef HAVE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief io_uring data path for a connected datagram socket.
+ *
+ * Incoming datagrams are received with a single multishot receive request that picks its
+ * buffers from a provided buffer ring, so that no request has to be resubmitted per datagram.
+ * Outgoing datagrams are queued as send requests and submitted together once per iteration of
+ * the event loop. Completions are signaled through an eventfd that is watched by the global
+ * io_service, so this class runs on the same thread as the rest of the face system.
+ *
+ * Whether io_uring is used is decided at runtime: if isSupported() returns false, or the
+ * constructor throws, the caller should keep using the Boost.Asio (epoll) data path.
+ *
+ * Each instance has its own io_uring, eventfd, and N_RECEIVE_BUFFERS receive buffers of
+ * ndn::MAX_NDN_PACKET_SIZE octets, i.e., about 140 KiB per face, compared to one receive buffer
+ * with Boost.Asio. It is therefore only used where enabled by configuration.
+ *
+ * @note This class is only functional when NFD is configured with `--with-io-uring`.
+ */
+class UringDatagramIo : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  using ReceiveCallback = std::function<void(const uint8_t* buffer, size_t nBytesReceived,
+                                             const boost::system::error_code& error)>;
+  using SendCallback = std::function<void(const boost::system::error_code& error,
+                                          size_t nBytesSent)>;
+
+  /**
+   * @brief Check whether the running kernel supports multishot receive with provided buffers.
+   *
+   * The kernel is probed on the first call; the result is cached for the lifetime of the process.
+   */
+  static bool
+  isSupported();
+
+  /**
+   * @brief Start receiving on @p socketFd.
+   * @param socketFd a connected datagram socket; the caller retains ownership, and must call
+   *                 close() before closing the socket
+   * @throw Error the io_uring instance could not be set up
+   */
+  UringDatagramIo(int socketFd, ReceiveCallback onReceive, SendCallback onSend);
+
+  ~UringDatagramIo();
+
+  /**
+   * @brief Queue @p packet for sending; it is submitted at the end of the current event loop turn.
+   */
+  void
+  send(const Block& packet);
+
+  /**
+   * @brief Cancel the receive request and stop invoking the callbacks.
+   */
+  void
+  close();
+
+public:
+  /// number of receive buffers in the provided buffer ring
+  static constexpr unsigned N_RECEIVE_BUFFERS = 16;
+
+private:
+  void
+  armReceive();
+
+  void
+  scheduleSubmit();
+
+  void
+  asyncWaitCompletions();
+
+  void
+  processCompletions();
+
+#ifdef HAVE_IO_URING
+private:
+  int m_socketFd;
+  ReceiveCallback m_onReceive;
+  SendCallback m_onSend;
+
+  io_uring m_ring;
+  io_uring_buf_ring* m_bufRing = nullptr;
+  std::vector<uint8_t> m_buffers;
+
+  boost::asio::posix::stream_descriptor m_eventFd;
+  uint64_t m_eventCount = 0;
+
+  std::map<uint64_t, Block> m_pendingSends; ///< keeps the buffers alive until completion
+  uint64_t m_lastSendId = 0;
+  bool m_isSubmitScheduled = false;
+  bool m_isOpen = true;
+  shared_ptr<char> m_token = make_shared<char>(); ///< guards handlers posted to the io_service
+#endif // HAVE_IO_URING
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_URING_DATAGRAM_IO_HPP
@@ -57,27 +57,53 @@ FaceInfo*
 NamespaceInfo::getFaceInfo(FaceId faceId)
 {
   auto it = m_fiMap.find(faceId);
-  return it != m_fiMap.end() ? &it->second : nullptr;
+  if (it == m_fiMap.end()) {
+    return nullptr;
+  }
+
+  if (it->second.m_expiry <= time::steady_clock::now()) {
+    m_fiMap.erase(it);
+    return nullptr;
+  }
+  return &it->second;
 }
 
 FaceInfo&
 NamespaceInfo::getOrCreateFaceInfo(FaceId faceId)
 {
+  FaceInfo* existing = getFaceInfo(faceId);
+  if (existing != nullptr) {
+    return *existing;
+  }
+
+  // new faces are rare, so this is a good time to reclaim expired ones
+  eraseExpiredFaceInfo(time::steady_clock::now());
+
   auto ret = m_fiMap.emplace(std::piecewise_construct,
                              std::forward_as_tuple(faceId),
                              std::forward_as_tuple(m_rttEstimatorOpts));
   auto& faceInfo = ret.first->second;
-  if (ret.second) {
-    extendFaceInfoLifetime(faceInfo, faceId);
-  }
+  extendFaceInfoLifetime(faceInfo);
   return faceInfo;
 }
 
 void
-NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId faceId)
+NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info)
 {
-  info.m_measurementExpiration = getScheduler().schedule(AsfMeasurements::MEASUREMENTS_LIFETIME,
-                                                         [=] { m_fiMap.erase(faceId); });
+  info.m_expiry = time::steady_clock::now() + AsfMeasurements::MEASUREMENTS_LIFETIME;
+}
+
+void
+NamespaceInfo::eraseExpiredFaceInfo(time::steady_clock::TimePoint now)
+{
+  for (auto it = m_fiMap.begin(); it != m_fiMap.end();) {
+    if (it->second.m_expiry <= now) {
+      it = m_fiMap.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
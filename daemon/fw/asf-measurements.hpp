@@ -112,8 +112,8 @@ private:
   Name m_lastInterestName;
   size_t m_nSilentTimeouts = 0;
 
-  // Timeout associated with measurement
-  scheduler::ScopedEventId m_measurementExpiration;
+  // Expiration of this measurement, checked when the FaceInfo is looked up
+  time::steady_clock::TimePoint m_expiry = time::steady_clock::TimePoint::max();
   friend class NamespaceInfo;
 
   // RTO associated with Interest
@@ -140,14 +140,21 @@ public:
   {
   }
 
+  /** \return FaceInfo of \p faceId, or nullptr if it does not exist or has expired
+   */
   FaceInfo*
   getFaceInfo(FaceId faceId);
 
   FaceInfo&
   getOrCreateFaceInfo(FaceId faceId);
 
+  /** \brief Keep \p info for another AsfMeasurements::MEASUREMENTS_LIFETIME
+   *
+   *  Expired FaceInfo items are erased lazily, when they are looked up or when
+   *  a new FaceInfo is created in this namespace.
+   */
   void
-  extendFaceInfoLifetime(FaceInfo& info, FaceId faceId);
+  extendFaceInfoLifetime(FaceInfo& info);
 
   bool
   isProbingDue() const
@@ -173,6 +180,10 @@ public:
     m_isFirstProbeScheduled = isScheduled;
   }
 
+private:
+  void
+  eraseExpiredFaceInfo(time::steady_clock::TimePoint now);
+
 private:
   std::unordered_map<FaceId, FaceInfo> m_fiMap;
   shared_ptr<const ndn::util::RttEstimator::Options> m_rttEstimatorOpts;
@@ -192,7 +192,7 @@ AsfStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
   }
 
   // Extend lifetime for measurements associated with Face
-  namespaceInfo->extendFaceInfoLifetime(*faceInfo, ingress.face.getId());
+  namespaceInfo->extendFaceInfoLifetime(*faceInfo);
 
   faceInfo->cancelTimeout(data.getName());
 }
@@ -221,11 +221,11 @@ AsfStrategy::forwardInterest(const Interest& interest, Face& outFace, const fib:
     this->sendInterest(pitEntry, egress, interest);
   }
 
-  FaceInfo& faceInfo = m_measurements.getOrCreateFaceInfo(fibEntry, interest, egress.face.getId());
+  NamespaceInfo& namespaceInfo = m_measurements.getOrCreateNamespaceInfo(fibEntry, interest);
+  FaceInfo& faceInfo = namespaceInfo.getOrCreateFaceInfo(egress.face.getId());
 
   // Refresh measurements since Face is being used for forwarding
-  NamespaceInfo& namespaceInfo = m_measurements.getOrCreateNamespaceInfo(fibEntry, interest);
-  namespaceInfo.extendFaceInfoLifetime(faceInfo, egress.face.getId());
+  namespaceInfo.extendFaceInfoLifetime(faceInfo);
 
   if (!faceInfo.isTimeoutScheduled()) {
     auto timeout = faceInfo.scheduleTimeout(interest.getName(),
@@ -295,7 +295,12 @@ AsfStrategy::getBestFaceForForwarding(const Interest& interest, const Face& inFa
                                       const fib::Entry& fibEntry, const shared_ptr<pit::Entry>& pitEntry,
                                       bool isInterestNew)
 {
-  std::set<FaceStats, FaceStatsCompare> rankedFaces;
+  // Look up the namespace once; per-face stats are then found without touching Measurements
+  NamespaceInfo& namespaceInfo = m_measurements.getOrCreateNamespaceInfo(fibEntry, interest);
+
+  // Keep the first face with the lowest (RTT, cost), as an ordered set of all candidates would
+  FaceStats best{nullptr, FaceInfo::RTT_NO_MEASUREMENT, FaceInfo::RTT_NO_MEASUREMENT, 0};
+  FaceStatsCompare isBetter;
 
   auto now = time::steady_clock::now();
   for (const auto& nh : fibEntry.getNextHops()) {
@@ -303,18 +308,20 @@ AsfStrategy::getBestFaceForForwarding(const Interest& interest, const Face& inFa
       continue;
     }
 
-    FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest, nh.getFace().getId());
-    if (info == nullptr) {
-      rankedFaces.insert({&nh.getFace(), FaceInfo::RTT_NO_MEASUREMENT,
-                          FaceInfo::RTT_NO_MEASUREMENT, nh.getCost()});
+    FaceStats stats{&nh.getFace(), FaceInfo::RTT_NO_MEASUREMENT,
+                    FaceInfo::RTT_NO_MEASUREMENT, nh.getCost()};
+    const FaceInfo* info = namespaceInfo.getFaceInfo(nh.getFace().getId());
+    if (info != nullptr) {
+      stats.rtt = info->getLastRtt();
+      stats.srtt = info->getSrtt();
     }
-    else {
-      rankedFaces.insert({&nh.getFace(), info->getLastRtt(), info->getSrtt(), nh.getCost()});
+
+    if (best.face == nullptr || isBetter(stats, best)) {
+      best = stats;
     }
   }
 
-  auto it = rankedFaces.begin();
-  return it != rankedFaces.end() ? it->face : nullptr;
+  return best.face;
 }
 
 void
@@ -339,7 +346,7 @@ AsfStrategy::onTimeout(const Name& interestName, FaceId faceId)
   if (nTimeouts <= m_maxSilentTimeouts) {
     NFD_LOG_TRACE(interestName << " face=" << faceId << " timeout-count=" << nTimeouts << " ignoring");
     // Extend lifetime for measurements associated with Face
-    namespaceInfo->extendFaceInfoLifetime(faceInfo, faceId);
+    namespaceInfo->extendFaceInfoLifetime(faceInfo);
     faceInfo.cancelTimeout(interestName);
   }
   else {
@@ -32,7 +32,9 @@
 #include "common/logger.hpp"
 #include "table/cleanup.hpp"
 
+#include <ndn-cxx/lp/pit-token.hpp>
 #include <ndn-cxx/lp/tags.hpp>
+#include <algorithm>
 
 namespace nfd {
 
@@ -89,7 +91,7 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
 {
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest in=" << ingress << " interest=" << interest.getName());
-  interest.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
+  interest.setTag(ingress.face.getIncomingFaceIdTag());
   ++m_counters.nInInterests;
 
   // /localhost scope control
@@ -212,7 +214,8 @@ Forwarder::onContentStoreHit(const FaceEndpoint& ingress, const shared_ptr<pit::
   NFD_LOG_DEBUG("onContentStoreHit interest=" << interest.getName());
   ++m_counters.nCsHits;
 
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+  static const auto csIncomingFaceIdTag = make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE);
+  data.setTag(csIncomingFaceIdTag);
   // FIXME Should we lookup PIT for other Interests that also match the data?
 
   pitEntry->isSatisfied = true;
@@ -235,8 +238,28 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry,
   // insert out-record
   pitEntry->insertOrUpdateOutRecord(egress.face, interest);
 
-  // send Interest
-  egress.face.sendInterest(interest, egress.endpoint);
+  // the upstream only ever sees the PIT token of this entry, and only if the egress link service
+  // sends PIT tokens; a token received from a downstream stays in the in-record for the return
+  // path, and is restored afterwards because Interest may be shared
+  auto downstreamToken = interest.getTag<lp::PitToken>();
+  if (egress.face.getLinkService()->canSendPitToken()) {
+    interest.setTag(m_pit.getToken(*pitEntry));
+    egress.face.sendInterest(interest, egress.endpoint);
+    if (downstreamToken != nullptr) {
+      interest.setTag(downstreamToken);
+    }
+    else {
+      interest.removeTag<lp::PitToken>();
+    }
+  }
+  else if (downstreamToken != nullptr) {
+    Interest interest2 = interest;
+    interest2.removeTag<lp::PitToken>();
+    egress.face.sendInterest(interest2, egress.endpoint);
+  }
+  else {
+    egress.face.sendInterest(interest, egress.endpoint);
+  }
   ++m_counters.nOutInterests;
 }
 
@@ -267,7 +290,7 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName());
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
+  data.setTag(ingress.face.getIncomingFaceIdTag());
   ++m_counters.nInData;
 
   // /localhost scope control
@@ -280,7 +303,20 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
   }
 
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  pit::DataMatchResult pitMatches;
+  auto pitToken = data.getTag<lp::PitToken>();
+  if (pitToken != nullptr) {
+    // the PIT token was issued by this forwarder and is meaningless beyond this hop
+    data.removeTag<lp::PitToken>();
+    auto pitEntry = m_pit.findByToken(*pitToken, data);
+    if (pitEntry != nullptr) {
+      pitMatches.push_back(std::move(pitEntry));
+    }
+  }
+  if (pitMatches.empty()) {
+    // no PIT token, or the token is stale
+    pitMatches = m_pit.findAllDataMatches(data);
+  }
   if (pitMatches.size() == 0) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(ingress, data);
@@ -316,7 +352,9 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
   // when more than one PIT entry is matched, trigger strategy: before satisfy Interest,
   // and send Data to all matched out faces
   else {
-    std::set<std::pair<Face*, EndpointId>> pendingDownstreams;
+    // take over the reusable buffer; a nested invocation of this pipeline will find it empty
+    std::vector<Face*> pendingDownstreams;
+    pendingDownstreams.swap(m_pendingDownstreamsBuffer);
     auto now = time::steady_clock::now();
 
     for (const auto& pitEntry : pitMatches) {
@@ -325,7 +363,7 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
       // remember pending downstreams
       for (const pit::InRecord& inRecord : pitEntry->getInRecords()) {
         if (inRecord.getExpiry() > now) {
-          pendingDownstreams.emplace(&inRecord.getFace(), 0);
+          pendingDownstreams.push_back(&inRecord.getFace());
         }
       }
 
@@ -348,16 +386,26 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
       pitEntry->deleteOutRecord(ingress.face);
     }
 
+    // remove duplicates, a downstream may have in-records in several matched PIT entries
+    std::sort(pendingDownstreams.begin(), pendingDownstreams.end(),
+              [] (const Face* a, const Face* b) { return a->getId() < b->getId(); });
+    pendingDownstreams.erase(std::unique(pendingDownstreams.begin(), pendingDownstreams.end()),
+                             pendingDownstreams.end());
+
     // foreach pending downstream
-    for (const auto& pendingDownstream : pendingDownstreams) {
-      if (pendingDownstream.first->getId() == ingress.face.getId() &&
-          pendingDownstream.second == ingress.endpoint &&
-          pendingDownstream.first->getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) {
+    for (Face* pendingDownstream : pendingDownstreams) {
+      if (pendingDownstream->getId() == ingress.face.getId() &&
+          ingress.endpoint == 0 &&
+          pendingDownstream->getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) {
         continue;
       }
       // goto outgoing Data pipeline
-      this->onOutgoingData(data, FaceEndpoint(*pendingDownstream.first, pendingDownstream.second));
+      this->onOutgoingData(data, FaceEndpoint(*pendingDownstream, 0));
     }
+
+    // return the buffer for reuse
+    pendingDownstreams.clear();
+    m_pendingDownstreamsBuffer.swap(pendingDownstreams);
   }
 }
 
@@ -403,7 +451,7 @@ void
 Forwarder::onIncomingNack(const FaceEndpoint& ingress, const lp::Nack& nack)
 {
   // receive Nack
-  nack.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
+  nack.setTag(ingress.face.getIncomingFaceIdTag());
   ++m_counters.nInNacks;
 
   // if multi-access or ad hoc face, drop
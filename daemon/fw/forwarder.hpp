@@ -273,6 +273,10 @@ private:
   DeadNonceList      m_deadNonceList;
   NetworkRegionTable m_networkRegionTable;
 
+  /** \brief storage reused by the incoming Data pipeline to collect pending downstreams
+   */
+  std::vector<Face*> m_pendingDownstreamsBuffer;
+
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 };
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/strategy-info.hpp"
+
+namespace nfd {
+namespace fw {
+
+namespace {
+
+/// items are grouped into size classes of this granularity
+constexpr size_t POOL_GRANULARITY = alignof(std::max_align_t);
+
+/// larger items are not pooled
+constexpr size_t POOL_MAX_ITEM_SIZE = 256;
+
+constexpr size_t POOL_N_SIZE_CLASSES = POOL_MAX_ITEM_SIZE / POOL_GRANULARITY;
+
+/// maximum number of free blocks retained per size class
+constexpr size_t POOL_MAX_FREE_BLOCKS = 4096;
+
+struct FreeBlock
+{
+  FreeBlock* next;
+};
+
+struct FreeList
+{
+  FreeBlock* head;
+  size_t nBlocks;
+};
+
+// Retained blocks are not returned to the system when a thread exits; at most
+// POOL_MAX_FREE_BLOCKS * POOL_MAX_ITEM_SIZE bytes per thread are held this way.
+thread_local FreeList t_freeLists[POOL_N_SIZE_CLASSES];
+
+constexpr size_t
+getSizeClass(size_t size)
+{
+  return (size - 1) / POOL_GRANULARITY;
+}
+
+} // unnamed namespace
+
+void*
+StrategyInfo::operator new(std::size_t size)
+{
+  if (size == 0 || size > POOL_MAX_ITEM_SIZE) {
+    return ::operator new(size);
+  }
+
+  size_t sizeClass = getSizeClass(size);
+  FreeList& freeList = t_freeLists[sizeClass];
+  if (freeList.head == nullptr) {
+    // allocate the full size class, so that the block can be reused by any item in the class
+    return ::operator new((sizeClass + 1) * POOL_GRANULARITY);
+  }
+
+  FreeBlock* block = freeList.head;
+  freeList.head = block->next;
+  --freeList.nBlocks;
+  return block;
+}
+
+void
+StrategyInfo::operator delete(void* ptr, std::size_t size) noexcept
+{
+  if (ptr == nullptr) {
+    return;
+  }
+
+  if (size == 0 || size > POOL_MAX_ITEM_SIZE) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  FreeList& freeList = t_freeLists[getSizeClass(size)];
+  if (freeList.nBlocks >= POOL_MAX_FREE_BLOCKS) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto block = static_cast<FreeBlock*>(ptr);
+  block->next = freeList.head;
+  freeList.head = block;
+  ++freeList.nBlocks;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -50,6 +50,21 @@ public:
   virtual
   ~StrategyInfo() = default;
 
+  /** \brief Allocate storage for a StrategyInfo item
+   *
+   *  StrategyInfo items are created and destroyed as often as PIT entries. Storage is
+   *  recycled through per-thread free lists, one for each size class, so that a steady
+   *  stream of items does not reach the general-purpose allocator.
+   */
+  static void*
+  operator new(std::size_t size);
+
+  /** \brief Return storage of a StrategyInfo item to its free list
+   *  \param size size of the most-derived type, supplied by the virtual destructor
+   */
+  static void
+  operator delete(void* ptr, std::size_t size) noexcept;
+
 protected:
   StrategyInfo() = default;
 };
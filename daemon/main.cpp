@@ -30,6 +30,7 @@
 #include "common/logger.hpp"
 #include "common/privilege-helper.hpp"
 #include "core/version.hpp"
+#include "face/uring-datagram-io.hpp"
 
 #include <string.h> // for strsignal()
 
@@ -117,7 +118,11 @@ public:
     std::mutex m;
     std::condition_variable cv;
 
-    std::thread ribThread([configFile = m_configFile, &retval, &ribIo, mainIo, &cv, &m] {
+    // FibManager is only used on the main thread; the RIB thread hands FIB updates to it
+    // through mainIo instead of sending control commands
+    FibManager* fibManager = &m_nfd.getFibManager();
+
+    std::thread ribThread([configFile = m_configFile, &retval, &ribIo, mainIo, fibManager, &cv, &m] {
       {
         std::lock_guard<std::mutex> lock(m);
         ribIo = &getGlobalIoService();
@@ -130,6 +135,7 @@ public:
         ndn::KeyChain ribKeyChain;
         // must be created inside a separate thread
         rib::Service ribService(configFile, ribKeyChain);
+        ribService.enableInProcessFibUpdates(*fibManager);
         getGlobalIoService().run(); // ribIo is not thread-safe to use here
       }
       catch (const std::exception& e) {
@@ -195,6 +201,7 @@ private:
     NFD_LOG_INFO("Caught signal " << signalNo << " (" << ::strsignal(signalNo) << "), exiting...");
 
     systemdNotify("STOPPING=1");
+    m_nfd.saveCsSnapshot();
     getGlobalIoService().stop();
   }
 
@@ -291,6 +298,12 @@ main(int argc, char** argv)
       "with Boost version " + to_string(BOOST_VERSION / 100000) +
       "." + to_string(BOOST_VERSION / 100 % 1000) +
       "." + to_string(BOOST_VERSION % 100);
+  const std::string ioBuildInfo =
+#ifdef HAVE_IO_URING
+      "with io_uring support";
+#else
+      "without io_uring support";
+#endif
   const std::string pcapBuildInfo =
 #ifdef HAVE_LIBPCAP
       "with " + std::string(pcap_lib_version());
@@ -309,11 +322,23 @@ main(int argc, char** argv)
   std::clog << "NFD version " << NFD_VERSION_BUILD_STRING << " starting\n"
             << "Built with " BOOST_COMPILER ", with " BOOST_STDLIB
                ", " << boostBuildInfo <<
+               ", " << ioBuildInfo <<
                ", " << pcapBuildInfo <<
                ", " << wsBuildInfo <<
                ", with ndn-cxx version " NDN_CXX_VERSION_BUILD_STRING
             << std::endl;
 
+#ifdef HAVE_IO_URING
+  if (face::UringDatagramIo::isSupported()) {
+    std::clog << "io_uring is available for unicast UDP faces "
+                 "(enable with face_system.udp.io_uring)" << std::endl;
+  }
+  else {
+    std::clog << "io_uring is not supported by the running kernel, "
+                 "unicast UDP faces will use Boost.Asio" << std::endl;
+  }
+#endif // HAVE_IO_URING
+
   NfdRunner runner(configFile);
   try {
     runner.initialize();
@@ -24,9 +24,13 @@
  */
 
 #include "command-authenticator.hpp"
+#include "common/global.hpp"
 #include "common/logger.hpp"
 
 #include <ndn-cxx/tag.hpp>
+#include <ndn-cxx/security/command-interest-signer.hpp>
+#include <ndn-cxx/security/transform/public-key.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
 #include <ndn-cxx/security/v2/certificate-fetcher-offline.hpp>
 #include <ndn-cxx/security/v2/certificate-request.hpp>
 #include <ndn-cxx/security/v2/validation-policy.hpp>
@@ -36,6 +40,7 @@
 #include <ndn-cxx/util/io.hpp>
 
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 
 namespace sec2 = ndn::security::v2;
 
@@ -45,6 +50,12 @@ NFD_LOG_INIT(CommandAuthenticator);
 // INFO: configuration change, etc
 // DEBUG: per authentication request result
 
+const time::seconds CommandAuthenticator::DEFAULT_KEY_CACHE_LIFETIME = 60_s;
+
+/** \brief grace interval of command timestamps, same as ValidationPolicyCommandInterest default
+ */
+static const time::milliseconds TIMESTAMP_GRACE_INTERVAL = 2_min;
+
 /** \brief an Interest tag to indicate command signer
  */
 using SignerTag = ndn::SimpleTag<Name, 20>;
@@ -96,6 +107,52 @@ public:
   }
 };
 
+/** \brief obtain KeyLocator name and timestamp of a command Interest
+ *  \return KeyLocator name and timestamp, or nullopt if they cannot be extracted
+ */
+static optional<std::pair<Name, time::system_clock::TimePoint>>
+getSignerAndTimestamp(const Interest& interest)
+{
+  const Name& name = interest.getName();
+  if (name.size() < ndn::command_interest::MIN_SIZE ||
+      !name[ndn::command_interest::POS_TIMESTAMP].isNumber()) {
+    return nullopt;
+  }
+
+  try {
+    ndn::SignatureInfo sigInfo(name[ndn::command_interest::POS_SIG_INFO].blockFromValue());
+    if (!sigInfo.hasKeyLocator() || sigInfo.getKeyLocator().getType() != tlv::Name) {
+      return nullopt;
+    }
+    auto timestamp = time::fromUnixTimestamp(
+                       time::milliseconds(name[ndn::command_interest::POS_TIMESTAMP].toNumber()));
+    return std::make_pair(sigInfo.getKeyLocator().getName(), timestamp);
+  }
+  catch (const tlv::Error&) {
+    return nullopt;
+  }
+}
+
+struct CommandAuthenticator::PendingCommand
+{
+  enum State {
+    IN_PROGRESS,
+    VERIFIED,
+    REJECTED,
+  };
+
+  Name name;
+  State state = IN_PROGRESS;
+  /// KeyLocator name and timestamp of a verified command; nullopt if not applicable
+  optional<std::pair<Name, time::system_clock::TimePoint>> signer;
+  /// requester passed to AcceptContinuation, also used in log messages
+  std::string requester = "?";
+  ndn::mgmt::RejectReply rejectReply = ndn::mgmt::RejectReply::STATUS403;
+  std::string rejectReason;
+  ndn::mgmt::AcceptContinuation accept;
+  ndn::mgmt::RejectContinuation reject;
+};
+
 shared_ptr<CommandAuthenticator>
 CommandAuthenticator::create()
 {
@@ -104,6 +161,15 @@ CommandAuthenticator::create()
 
 CommandAuthenticator::CommandAuthenticator() = default;
 
+CommandAuthenticator::~CommandAuthenticator()
+{
+  if (m_verificationThread.joinable()) {
+    m_verificationWork.reset();
+    m_verificationIo.stop();
+    m_verificationThread.join();
+  }
+}
+
 void
 CommandAuthenticator::setConfigFile(ConfigFile& configFile)
 {
@@ -121,14 +187,29 @@ CommandAuthenticator::processConfig(const ConfigSection& section, bool isDryRun,
         make_unique<sec2::ValidationPolicyCommandInterest>(make_unique<CommandAuthenticatorValidationPolicy>()),
         make_unique<sec2::CertificateFetcherOffline>());
     }
-  }
-
-  if (section.empty()) {
-    NDN_THROW(ConfigFile::Error("'authorize' is missing under 'authorizations'"));
+    m_anchors.clear();
+    m_verifiedKeys.clear();
+    m_keyCacheLifetime = DEFAULT_KEY_CACHE_LIFETIME;
+    m_wantVerificationThread = false;
   }
 
   int authSectionIndex = 0;
   for (const auto& kv : section) {
+    if (kv.first == "key_cache_lifetime") {
+      auto lifetime = time::seconds(ConfigFile::parseNumber<uint32_t>(kv, "authorizations"));
+      if (!isDryRun) {
+        m_keyCacheLifetime = lifetime;
+        NFD_LOG_INFO("key-cache-lifetime=" << lifetime);
+      }
+      continue;
+    }
+    if (kv.first == "verification_thread") {
+      bool wantThread = ConfigFile::parseYesNo(kv, "authorizations");
+      if (!isDryRun) {
+        m_wantVerificationThread = wantThread;
+      }
+      continue;
+    }
     if (kv.first != "authorize") {
       NDN_THROW(ConfigFile::Error("'" + kv.first + "' section is not permitted under 'authorizations'"));
     }
@@ -193,12 +274,33 @@ CommandAuthenticator::processConfig(const ConfigSection& section, bool isDryRun,
         const Name& keyName = cert->getKeyName();
         sec2::Certificate certCopy = *cert;
         found->second->loadAnchor(certfile, std::move(certCopy));
+        m_anchors[module].push_back(*cert);
         NFD_LOG_INFO("authorize module=" << module << " signer=" << keyName << " certfile=" << certfile);
       }
     }
 
     ++authSectionIndex;
   }
+
+  if (authSectionIndex == 0) {
+    NDN_THROW(ConfigFile::Error("'authorize' is missing under 'authorizations'"));
+  }
+
+  if (!isDryRun && m_wantVerificationThread && m_keyCacheLifetime > 0_ns) {
+    startVerificationThread();
+  }
+}
+
+void
+CommandAuthenticator::startVerificationThread()
+{
+  if (m_verificationThread.joinable()) {
+    return;
+  }
+
+  NFD_LOG_INFO("starting verification thread");
+  m_verificationWork = make_unique<boost::asio::io_service::work>(m_verificationIo);
+  m_verificationThread = std::thread([this] { m_verificationIo.run(); });
 }
 
 ndn::mgmt::Authorization
@@ -211,43 +313,204 @@ CommandAuthenticator::makeAuthorization(const std::string& module, const std::st
               const ndn::mgmt::ControlParameters*,
               const ndn::mgmt::AcceptContinuation& accept,
               const ndn::mgmt::RejectContinuation& reject) {
-    auto validator = self->m_validators.at(module);
-    auto successCb = [accept, validator] (const Interest& interest1) {
-      auto signer1 = getSignerFromTag(interest1);
-      BOOST_ASSERT(signer1 || // signer must be available unless 'certfile any'
-                   dynamic_cast<sec2::ValidationPolicyAcceptAll*>(&validator->getPolicy()) != nullptr);
-      std::string signer = signer1.value_or("*");
-      NFD_LOG_DEBUG("accept " << interest1.getName() << " signer=" << signer);
-      accept(signer);
-    };
-    auto failureCb = [reject] (const Interest& interest1, const sec2::ValidationError& err) {
-      using ndn::mgmt::RejectReply;
-      RejectReply reply = RejectReply::STATUS403;
-      switch (err.getCode()) {
-      case sec2::ValidationError::NO_SIGNATURE:
-      case sec2::ValidationError::INVALID_KEY_LOCATOR:
+    self->authorize(module, interest, accept, reject);
+  };
+}
+
+void
+CommandAuthenticator::authorize(const std::string& module, const Interest& interest,
+                                const ndn::mgmt::AcceptContinuation& accept,
+                                const ndn::mgmt::RejectContinuation& reject)
+{
+  auto command = make_shared<PendingCommand>();
+  command->name = interest.getName();
+  command->accept = accept;
+  command->reject = reject;
+  m_pending.push_back(command);
+
+  if (m_keyCacheLifetime > 0_ns) {
+    auto signer = getSignerAndTimestamp(interest);
+    if (signer) {
+      auto it = m_verifiedKeys.find({module, signer->first});
+      if (it != m_verifiedKeys.end() && it->second.expiry > time::steady_clock::now()) {
+        command->signer = signer;
+        command->requester = signer->first.toUri();
+        verify(module, interest, it->second.publicKey, command);
+        return;
+      }
+    }
+  }
+
+  validate(module, interest, command);
+}
+
+void
+CommandAuthenticator::validate(const std::string& module, const Interest& interest,
+                               const shared_ptr<PendingCommand>& command)
+{
+  auto validator = m_validators.at(module);
+  if (!validator) {
+    command->state = PendingCommand::REJECTED;
+    command->rejectReason = "Unauthorized";
+    processCompletedCommands();
+    return;
+  }
+
+  auto successCb = [this, module, validator, command] (const Interest& interest1) {
+    auto signer1 = getSignerFromTag(interest1);
+    BOOST_ASSERT(signer1 || // signer must be available unless 'certfile any'
+                 dynamic_cast<sec2::ValidationPolicyAcceptAll*>(&validator->getPolicy()) != nullptr);
+    command->state = PendingCommand::VERIFIED;
+    command->requester = signer1.value_or("*");
+    if (signer1) {
+      command->signer = getSignerAndTimestamp(interest1);
+      if (command->signer) {
+        cacheVerifiedKey(module, command->signer->first);
+      }
+    }
+    processCompletedCommands();
+  };
+  auto failureCb = [this, command] (const Interest& interest1, const sec2::ValidationError& err) {
+    using ndn::mgmt::RejectReply;
+    RejectReply reply = RejectReply::STATUS403;
+    switch (err.getCode()) {
+    case sec2::ValidationError::NO_SIGNATURE:
+    case sec2::ValidationError::INVALID_KEY_LOCATOR:
+      reply = RejectReply::SILENT;
+      break;
+    case sec2::ValidationError::POLICY_ERROR:
+      if (interest1.getName().size() < ndn::command_interest::MIN_SIZE) { // "name too short"
         reply = RejectReply::SILENT;
-        break;
-      case sec2::ValidationError::POLICY_ERROR:
-        if (interest1.getName().size() < ndn::command_interest::MIN_SIZE) { // "name too short"
-          reply = RejectReply::SILENT;
-        }
-        break;
       }
-      NFD_LOG_DEBUG("reject " << interest1.getName() << " signer=" <<
-                    getSignerFromTag(interest1).value_or("?") << " reason=" << err);
-      reject(reply);
-    };
+      break;
+    }
+    command->state = PendingCommand::REJECTED;
+    command->requester = getSignerFromTag(interest1).value_or("?");
+    command->rejectReply = reply;
+    command->rejectReason = boost::lexical_cast<std::string>(err);
+    processCompletedCommands();
+  };
+
+  validator->validate(interest, successCb, failureCb);
+}
 
-    if (validator) {
-      validator->validate(interest, successCb, failureCb);
+void
+CommandAuthenticator::verify(const std::string& module, const Interest& interest,
+                             shared_ptr<const ndn::security::transform::PublicKey> key,
+                             const shared_ptr<PendingCommand>& command)
+{
+  weak_ptr<CommandAuthenticator> weakSelf = this->shared_from_this();
+  auto onVerified = [weakSelf, module, interest, command] (bool isValid) {
+    auto self = weakSelf.lock();
+    if (self == nullptr) {
+      return;
+    }
+    if (isValid) {
+      command->state = PendingCommand::VERIFIED;
+      self->processCompletedCommands();
     }
     else {
-      NFD_LOG_DEBUG("reject " << interest.getName() << " signer=" <<
-                    getSignerFromTag(interest).value_or("?") << " reason=Unauthorized");
-      reject(ndn::mgmt::RejectReply::STATUS403);
+      // let the Validator determine the failure reason
+      command->signer = nullopt;
+      command->requester = "?";
+      self->validate(module, interest, command);
     }
   };
+
+  if (!m_verificationThread.joinable() || !m_wantVerificationThread) {
+    onVerified(ndn::security::verifySignature(interest, *key));
+    return;
+  }
+
+  // onVerified holds the PendingCommand, so it is moved back rather than copied,
+  // ensuring that the command is only touched on the originating thread
+  auto& originIo = getGlobalIoService();
+  m_verificationIo.post([interest, key = std::move(key), onVerified, &originIo] () mutable {
+    bool isValid = ndn::security::verifySignature(interest, *key);
+    originIo.post([onVerified = std::move(onVerified), isValid] { onVerified(isValid); });
+  });
+}
+
+void
+CommandAuthenticator::cacheVerifiedKey(const std::string& module, const Name& signer)
+{
+  if (m_keyCacheLifetime <= 0_ns) {
+    return;
+  }
+
+  auto expiry = time::steady_clock::now() + m_keyCacheLifetime;
+  auto it = m_verifiedKeys.find({module, signer});
+  if (it != m_verifiedKeys.end()) {
+    it->second.expiry = expiry;
+    return;
+  }
+
+  for (const auto& cert : m_anchors[module]) {
+    if (!signer.isPrefixOf(cert.getName())) {
+      continue;
+    }
+
+    auto key = make_shared<ndn::security::transform::PublicKey>();
+    try {
+      key->loadPkcs8(cert.getPublicKey().data(), cert.getPublicKey().size());
+    }
+    catch (const ndn::security::transform::PublicKey::Error& e) {
+      NFD_LOG_WARN("cannot cache key of " << cert.getName() << ": " << e.what());
+      return;
+    }
+    m_verifiedKeys[{module, signer}] = {std::move(key), expiry};
+    return;
+  }
+}
+
+bool
+CommandAuthenticator::checkAndRecordTimestamp(const PendingCommand& command)
+{
+  if (!command.signer) {
+    return true;
+  }
+
+  const Name& signer = command.signer->first;
+  const auto& timestamp = command.signer->second;
+  auto now = time::system_clock::now();
+  if (timestamp < now - TIMESTAMP_GRACE_INTERVAL || timestamp > now + TIMESTAMP_GRACE_INTERVAL) {
+    return false;
+  }
+
+  auto it = m_lastTimestamps.find(signer);
+  if (it == m_lastTimestamps.end()) {
+    m_lastTimestamps.emplace(signer, timestamp);
+    return true;
+  }
+  if (timestamp <= it->second) {
+    return false;
+  }
+  it->second = timestamp;
+  return true;
+}
+
+void
+CommandAuthenticator::processCompletedCommands()
+{
+  while (!m_pending.empty() && m_pending.front()->state != PendingCommand::IN_PROGRESS) {
+    auto command = std::move(m_pending.front());
+    m_pending.pop_front();
+
+    if (command->state == PendingCommand::VERIFIED && !checkAndRecordTimestamp(*command)) {
+      command->state = PendingCommand::REJECTED;
+      command->rejectReason = "Replayed or stale timestamp";
+    }
+
+    if (command->state == PendingCommand::VERIFIED) {
+      NFD_LOG_DEBUG("accept " << command->name << " signer=" << command->requester);
+      command->accept(command->requester);
+    }
+    else {
+      NFD_LOG_DEBUG("reject " << command->name << " signer=" << command->requester <<
+                    " reason=" << command->rejectReason);
+      command->reject(command->rejectReply);
+    }
+  }
 }
 
 } // namespace nfd
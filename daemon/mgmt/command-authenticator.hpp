@@ -30,9 +30,18 @@
 
 #include <ndn-cxx/mgmt/dispatcher.hpp>
 
+#include <boost/asio/io_service.hpp>
+
+#include <deque>
+#include <thread>
+
 namespace ndn {
 namespace security {
+namespace transform {
+class PublicKey;
+} // namespace transform
 namespace v2 {
+class Certificate;
 class Validator;
 } // namespace v2
 } // namespace security
@@ -41,6 +50,12 @@ class Validator;
 namespace nfd {
 
 /** \brief Provides ControlCommand authorization according to NFD configuration file.
+ *
+ *  The first command from a signer is validated by a full ndn-cxx Validator. Afterwards, the
+ *  signer's key is remembered for a configurable lifetime, during which its commands are checked
+ *  directly against the cached public key, bypassing the Validator. Optionally, these signature
+ *  verifications are performed on a separate thread. In either case, authorization results are
+ *  delivered in the order in which the commands arrived.
  */
 class CommandAuthenticator : public std::enable_shared_from_this<CommandAuthenticator>, noncopyable
 {
@@ -59,9 +74,55 @@ public:
   ndn::mgmt::Authorization
   makeAuthorization(const std::string& module, const std::string& verb);
 
+  ~CommandAuthenticator();
+
+  /** \brief Default lifetime of a verified key, see "key_cache_lifetime" option
+   */
+  static const time::seconds DEFAULT_KEY_CACHE_LIFETIME;
+
 private:
   CommandAuthenticator();
 
+  struct PendingCommand;
+
+  /** \brief authorize a command for \p module
+   */
+  void
+  authorize(const std::string& module, const Interest& interest,
+            const ndn::mgmt::AcceptContinuation& accept,
+            const ndn::mgmt::RejectContinuation& reject);
+
+  /** \brief validate a command with the module's Validator
+   */
+  void
+  validate(const std::string& module, const Interest& interest,
+           const shared_ptr<PendingCommand>& command);
+
+  /** \brief verify a command against a cached public key, possibly on the verification thread
+   */
+  void
+  verify(const std::string& module, const Interest& interest,
+         shared_ptr<const ndn::security::transform::PublicKey> key,
+         const shared_ptr<PendingCommand>& command);
+
+  /** \brief remember the key of \p signer after a successful validation
+   */
+  void
+  cacheVerifiedKey(const std::string& module, const Name& signer);
+
+  /** \brief deliver the results of completed commands at the front of the queue
+   */
+  void
+  processCompletedCommands();
+
+  /** \brief check the command timestamp for replay, and record it
+   */
+  bool
+  checkAndRecordTimestamp(const PendingCommand& command);
+
+  void
+  startVerificationThread();
+
   /** \brief process "authorizations" section
    *  \throw ConfigFile::Error on parse error
    */
@@ -71,6 +132,28 @@ private:
 private:
   /// module => validator
   std::unordered_map<std::string, shared_ptr<ndn::security::v2::Validator>> m_validators;
+  /// module => trust anchors granted privilege of the module
+  std::unordered_map<std::string, std::vector<ndn::security::v2::Certificate>> m_anchors;
+
+  struct VerifiedKey
+  {
+    shared_ptr<const ndn::security::transform::PublicKey> publicKey;
+    time::steady_clock::TimePoint expiry;
+  };
+  /// (module, KeyLocator name) => key that has passed validation
+  std::map<std::pair<std::string, Name>, VerifiedKey> m_verifiedKeys;
+  time::nanoseconds m_keyCacheLifetime = DEFAULT_KEY_CACHE_LIFETIME;
+
+  /// KeyLocator name => timestamp of the last accepted command
+  std::map<Name, time::system_clock::TimePoint> m_lastTimestamps;
+
+  /// commands in arrival order, whose results have not been delivered
+  std::deque<shared_ptr<PendingCommand>> m_pending;
+
+  bool m_wantVerificationThread = false;
+  boost::asio::io_service m_verificationIo;
+  unique_ptr<boost::asio::io_service::work> m_verificationWork;
+  std::thread m_verificationThread;
 };
 
 } // namespace nfd
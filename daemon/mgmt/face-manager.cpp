@@ -26,10 +26,13 @@
 #include "face-manager.hpp"
 
 #include "common/logger.hpp"
+#include "face/datagram-transport.hpp"
 #include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
+#include "face/udp-channel.hpp"
 #include "fw/face-table.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/mgmt/nfd/channel-status.hpp>
 #include <ndn-cxx/mgmt/nfd/face-event-notification.hpp>
@@ -377,13 +380,35 @@ makeFaceStatus(const Face& face, const time::steady_clock::TimePoint& now)
   return status;
 }
 
+/** \brief append the kernel drop count to an encoded FaceStatus or ChannelStatus
+ */
+static Block
+appendKernelDropCount(Block wire, uint64_t nDropped)
+{
+  wire.parse();
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(TLV_N_IN_KERNEL_DROPPED, nDropped));
+  wire.encode();
+  return wire;
+}
+
+static Block
+encodeFaceStatus(const Face& face, const time::steady_clock::TimePoint& now)
+{
+  Block wire = makeFaceStatus(face, now).wireEncode();
+
+  auto counters = dynamic_cast<const face::DatagramTransportCounters*>(&face.getTransport()->getCounters());
+  if (counters != nullptr) {
+    return appendKernelDropCount(wire, counters->nInKernelDropped);
+  }
+  return wire;
+}
+
 void
 FaceManager::listFaces(ndn::mgmt::StatusDatasetContext& context)
 {
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
-    ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-    context.append(status.wireEncode());
+    context.append(encodeFaceStatus(face, now));
   }
   context.end();
 }
@@ -396,7 +421,14 @@ FaceManager::listChannels(ndn::mgmt::StatusDatasetContext& context)
     for (const auto& channel : factory->getChannels()) {
       ndn::nfd::ChannelStatus entry;
       entry.setLocalUri(channel->getUri().toString());
-      context.append(entry.wireEncode());
+
+      auto udpChannel = dynamic_pointer_cast<const face::UdpChannel>(channel);
+      if (udpChannel != nullptr) {
+        context.append(appendKernelDropCount(entry.wireEncode(), udpChannel->getNInKernelDropped()));
+      }
+      else {
+        context.append(entry.wireEncode());
+      }
     }
   }
   context.end();
@@ -460,8 +492,7 @@ FaceManager::queryFaces(const Interest& interest,
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
     if (matchFilter(faceFilter, face)) {
-      ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-      context.append(status.wireEncode());
+      context.append(encodeFaceStatus(face, now));
     }
   }
   context.end();
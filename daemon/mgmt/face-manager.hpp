@@ -32,6 +32,17 @@
 
 namespace nfd {
 
+/**
+ * @brief TLV-TYPE of an NFD-specific element appended to FaceStatus and ChannelStatus.
+ *
+ * The element is a NonNegativeInteger: the number of incoming datagrams dropped by the kernel,
+ * see face::DatagramTransportCounters::nInKernelDropped and face::UdpChannel::getNInKernelDropped.
+ * The number is even, so decoders that do not recognize the element ignore it.
+ */
+enum : uint32_t {
+  TLV_N_IN_KERNEL_DROPPED = 214,
+};
+
 /**
  * @brief Implements the Face Management of NFD Management Protocol.
  * @sa https://redmine.named-data.net/projects/nfd/wiki/FaceMgmt
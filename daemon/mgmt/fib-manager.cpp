@@ -32,12 +32,13 @@
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/mgmt/nfd/fib-entry.hpp>
 
-#include <boost/range/adaptor/transformed.hpp>
-
 namespace nfd {
 
 NFD_LOG_INIT(FibManager);
 
+// number of name tree buckets that a page of fib/list may examine per item of its limit
+static const size_t MAX_BUCKETS_PER_PAGE_ITEM = 4;
+
 FibManager::FibManager(Fib& fib, const FaceTable& faceTable,
                        Dispatcher& dispatcher, CommandAuthenticator& authenticator)
   : ManagerBase("fib", dispatcher, authenticator)
@@ -58,29 +59,37 @@ FibManager::addNextHop(const Name& topPrefix, const Interest& interest,
                        const ndn::mgmt::CommandContinuation& done)
 {
   setFaceForSelfRegistration(interest, parameters);
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
-  uint64_t cost = parameters.getCost();
 
+  ControlResponse response = doAddNextHop(parameters.getName(), parameters.getFaceId(),
+                                          parameters.getCost());
+  if (response.getCode() == 200) {
+    response.setBody(parameters.wireEncode());
+  }
+  return done(response);
+}
+
+ControlResponse
+FibManager::doAddNextHop(const Name& prefix, FaceId faceId, uint64_t cost)
+{
   if (prefix.size() > Fib::getMaxDepth()) {
     NFD_LOG_DEBUG("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost <<
                   "): FAIL prefix-too-long");
-    return done(ControlResponse(414, "FIB entry prefix cannot exceed " +
-                                to_string(Fib::getMaxDepth()) + " components"));
+    return ControlResponse(414, "FIB entry prefix cannot exceed " +
+                           to_string(Fib::getMaxDepth()) + " components");
   }
 
   Face* face = m_faceTable.get(faceId);
   if (face == nullptr) {
     NFD_LOG_DEBUG("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost <<
                   "): FAIL unknown-faceid");
-    return done(ControlResponse(410, "Face not found"));
+    return ControlResponse(410, "Face not found");
   }
 
   fib::Entry* entry = m_fib.insert(prefix).first;
   m_fib.addOrUpdateNextHop(*entry, *face, cost);
 
   NFD_LOG_TRACE("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost << "): OK");
-  return done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+  return ControlResponse(200, "Success");
 }
 
 void
@@ -89,18 +98,22 @@ FibManager::removeNextHop(const Name& topPrefix, const Interest& interest,
                           const ndn::mgmt::CommandContinuation& done)
 {
   setFaceForSelfRegistration(interest, parameters);
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
 
   done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
 
+  doRemoveNextHop(parameters.getName(), parameters.getFaceId());
+}
+
+void
+FibManager::doRemoveNextHop(const Name& prefix, FaceId faceId)
+{
   Face* face = m_faceTable.get(faceId);
   if (face == nullptr) {
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK no-face");
     return;
   }
 
-  fib::Entry* entry = m_fib.findExactMatch(parameters.getName());
+  fib::Entry* entry = m_fib.findExactMatch(prefix);
   if (entry == nullptr) {
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK no-entry");
     return;
@@ -120,21 +133,83 @@ FibManager::removeNextHop(const Name& topPrefix, const Interest& interest,
   }
 }
 
+uint32_t
+FibManager::applyFibUpdate(const rib::FibUpdate& update)
+{
+  switch (update.action) {
+    case rib::FibUpdate::ADD_NEXTHOP:
+      return doAddNextHop(update.name, update.faceId, update.cost).getCode();
+    case rib::FibUpdate::REMOVE_NEXTHOP:
+      doRemoveNextHop(update.name, update.faceId);
+      return 200;
+  }
+  return 200;
+}
+
+static ndn::nfd::FibEntry
+makeFibEntry(const fib::Entry& entry, optional<FaceId> faceId = nullopt)
+{
+  ndn::nfd::FibEntry item;
+  item.setPrefix(entry.getPrefix());
+  for (const fib::NextHop& nh : entry.getNextHops()) {
+    if (!faceId || nh.getFace().getId() == *faceId) {
+      item.addNextHopRecord(ndn::nfd::NextHopRecord()
+                            .setFaceId(nh.getFace().getId())
+                            .setCost(nh.getCost()));
+    }
+  }
+  return item;
+}
+
 void
 FibManager::listEntries(const Name& topPrefix, const Interest& interest,
                         ndn::mgmt::StatusDatasetContext& context)
 {
-  for (const auto& entry : m_fib) {
-    const auto& nexthops = entry.getNextHops() |
-                           boost::adaptors::transformed([] (const fib::NextHop& nh) {
-                             return ndn::nfd::NextHopRecord()
-                                 .setFaceId(nh.getFace().getId())
-                                 .setCost(nh.getCost());
-                           });
-    context.append(ndn::nfd::FibEntry()
-                   .setPrefix(entry.getPrefix())
-                   .setNextHopRecords(std::begin(nexthops), std::end(nexthops))
-                   .wireEncode());
+  optional<DatasetPageQuery> query;
+  size_t cursor = 0;
+  try {
+    query = extractDatasetPageQuery(topPrefix, interest);
+    if (query && query->hasCursor()) {
+      cursor = static_cast<size_t>(ndn::encoding::readNonNegativeInteger(query->getCursor()));
+    }
+  }
+  catch (const tlv::Error& e) {
+    NFD_LOG_DEBUG("Malformed dataset query: " << e.what());
+    return context.reject(ControlResponse(400, "Malformed query"));
+  }
+
+  if (!query) {
+    for (const auto& entry : m_fib) {
+      context.append(makeFibEntry(entry).wireEncode());
+    }
+    context.end();
+    return;
+  }
+
+  // A page is bounded both by the number of items and by the number of name tree buckets
+  // examined, so that a sparse FIB or a selective filter cannot make one request expensive.
+  // The cursor is the index of the next bucket to examine.
+  optional<FaceId> faceId;
+  if (query->hasFaceId()) {
+    faceId = query->getFaceId();
+  }
+  size_t limit = query->getLimit();
+  size_t nItems = 0;
+  auto next = m_fib.visitSlice(cursor, limit * MAX_BUCKETS_PER_PAGE_ITEM,
+    [&] (const fib::Entry& entry) {
+      if (query->hasPrefix() && !query->getPrefix().isPrefixOf(entry.getPrefix())) {
+        return true;
+      }
+      auto item = makeFibEntry(entry, faceId);
+      if (faceId && item.getNextHopRecords().empty()) {
+        return true;
+      }
+      context.append(item.wireEncode());
+      return ++nItems < limit;
+    });
+
+  if (next) {
+    context.append(ndn::encoding::makeNonNegativeIntegerBlock(TLV_DATASET_PAGE_CURSOR, *next));
   }
   context.end();
 }
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_FIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/fib-update.hpp"
 
 namespace nfd {
 
@@ -46,6 +47,19 @@ public:
   FibManager(fib::Fib& fib, const FaceTable& faceTable,
              Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /**
+   * @brief Apply a FIB update computed by the RIB service in the same process.
+   *
+   * The update has the same effect as the corresponding add-nexthop or remove-nexthop
+   * command, but no control command is signed or validated.
+   * This must be invoked on the main thread.
+   *
+   * @return status code of the equivalent control command: 200 on success,
+   *         410 if the face does not exist, 414 if the prefix is too long
+   */
+  uint32_t
+  applyFibUpdate(const rib::FibUpdate& update);
+
 private:
   void
   addNextHop(const Name& topPrefix, const Interest& interest,
@@ -65,6 +79,12 @@ private:
   void
   setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters);
 
+  ControlResponse
+  doAddNextHop(const Name& prefix, FaceId faceId, uint64_t cost);
+
+  void
+  doRemoveNextHop(const Name& prefix, FaceId faceId);
+
 private:
   fib::Fib& m_fib;
   const FaceTable& m_faceTable;
@@ -76,6 +76,17 @@ ManagerBase::extractRequester(const Interest& interest, ndn::mgmt::AcceptContinu
   }
 }
 
+optional<DatasetPageQuery>
+ManagerBase::extractDatasetPageQuery(const Name& topPrefix, const Interest& interest)
+{
+  // the query, if any, follows the module and verb components
+  size_t queryIndex = topPrefix.size() + 2;
+  if (interest.getName().size() <= queryIndex) {
+    return nullopt;
+  }
+  return DatasetPageQuery(interest.getName()[queryIndex].blockFromValue());
+}
+
 ndn::mgmt::Authorization
 ManagerBase::makeAuthorization(const std::string& verb)
 {
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_MANAGER_BASE_HPP
 
 #include "command-authenticator.hpp"
+#include "core/dataset-page.hpp"
 
 #include <ndn-cxx/mgmt/dispatcher.hpp>
 #include <ndn-cxx/mgmt/nfd/control-command.hpp>
@@ -102,6 +103,17 @@ PUBLIC_WITH_TESTS_ELSE_PROTECTED: // helpers
   void
   extractRequester(const Interest& interest, ndn::mgmt::AcceptContinuation accept);
 
+  /**
+   * @brief Extracts the DatasetPageQuery from a StatusDataset request.
+   *
+   * @param topPrefix the top prefix of the dispatcher
+   * @param interest a request for a StatusDataset of this module
+   * @return the query that follows the dataset verb, or nullopt if the whole dataset is requested
+   * @throw tlv::Error the query is malformed
+   */
+  static optional<DatasetPageQuery>
+  extractDatasetPageQuery(const Name& topPrefix, const Interest& interest);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * @brief Returns an authorization function for a specific management module and verb.
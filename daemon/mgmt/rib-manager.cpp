@@ -27,6 +27,7 @@
 
 #include "common/global.hpp"
 #include "common/logger.hpp"
+#include "core/route-batch.hpp"
 #include "rib/rib.hpp"
 #include "table/fib.hpp"
 
@@ -45,6 +46,8 @@ NFD_LOG_INIT(RibManager);
 static const std::string MGMT_MODULE_NAME = "rib";
 static const Name LOCALHOST_TOP_PREFIX = "/localhost/nfd";
 static const time::seconds ACTIVE_FACE_FETCH_INTERVAL = 5_min;
+// number of RIB entries that a page of rib/list may examine per item of its limit
+static const size_t MAX_ENTRIES_PER_PAGE_ITEM = 4;
 
 const Name RibManager::LOCALHOP_TOP_PREFIX = "/localhop/nfd";
 
@@ -65,9 +68,34 @@ RibManager::RibManager(rib::Rib& rib, ndn::Face& face, ndn::KeyChain& keyChain,
   registerCommandHandler<ndn::nfd::RibUnregisterCommand>("unregister",
     bind(&RibManager::unregisterEntry, this, _2, _3, _4, _5));
 
+  auto validateBatch = [] (const ndn::mgmt::ControlParameters& params) {
+    return static_cast<const RouteBatchParameters&>(params).isValid();
+  };
+  auto registerCommand = make_shared<ndn::nfd::RibRegisterCommand>();
+  m_dispatcher.addControlCommand<RouteBatchParameters>(
+    PartialName(MGMT_MODULE_NAME).append("register-batch"),
+    makeAuthorization("register-batch"), validateBatch,
+    [=] (const Name&, const Interest& interest, const ndn::mgmt::ControlParameters& params,
+         const ndn::mgmt::CommandContinuation& done) {
+      handleBatch(*registerCommand, true, interest, params, done);
+    });
+  auto unregisterCommand = make_shared<ndn::nfd::RibUnregisterCommand>();
+  m_dispatcher.addControlCommand<RouteBatchParameters>(
+    PartialName(MGMT_MODULE_NAME).append("unregister-batch"),
+    makeAuthorization("unregister-batch"), validateBatch,
+    [=] (const Name&, const Interest& interest, const ndn::mgmt::ControlParameters& params,
+         const ndn::mgmt::CommandContinuation& done) {
+      handleBatch(*unregisterCommand, false, interest, params, done);
+    });
+
   registerStatusDatasetHandler("list", bind(&RibManager::listEntries, this, _1, _2, _3));
 }
 
+RibManager::~RibManager()
+{
+  saveSnapshot();
+}
+
 void
 RibManager::applyLocalhostConfig(const ConfigSection& section, const std::string& filename)
 {
@@ -136,12 +164,7 @@ RibManager::beginAddRoute(const Name& name, Route route, optional<time::nanoseco
   NFD_LOG_INFO("Adding route " << name << " nexthop=" << route.faceId <<
                " origin=" << route.origin << " cost=" << route.cost);
 
-  if (expires) {
-    auto event = getScheduler().schedule(*expires, [=] { m_rib.onRouteExpiration(name, route); });
-    route.setExpirationEvent(event);
-    NFD_LOG_TRACE("Scheduled unregistration at: " << *route.expires);
-  }
-
+  // the RIB tracks route.expires in its expiration wheel once the route is inserted
   RibUpdate update;
   update.setAction(RibUpdate::REGISTER)
         .setName(name)
@@ -225,6 +248,74 @@ RibManager::registerEntry(const Name& topPrefix, const Interest& interest,
   // Respond since command is valid and authorized
   done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
 
+  beginRegister(parameters);
+}
+
+void
+RibManager::unregisterEntry(const Name& topPrefix, const Interest& interest,
+                            ControlParameters parameters,
+                            const ndn::mgmt::CommandContinuation& done)
+{
+  setFaceForSelfRegistration(interest, parameters);
+
+  // Respond since command is valid and authorized
+  done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+
+  beginUnregister(parameters);
+}
+
+void
+RibManager::handleBatch(const ControlCommand& command, bool isRegister,
+                        const Interest& interest, const ndn::mgmt::ControlParameters& params,
+                        const ndn::mgmt::CommandContinuation& done)
+{
+  BOOST_ASSERT(dynamic_cast<const RouteBatchParameters*>(&params) != nullptr);
+  const auto& batch = static_cast<const RouteBatchParameters&>(params);
+
+  RouteBatchResults results;
+  std::vector<ControlParameters> accepted;
+  accepted.reserve(batch.size());
+
+  for (ControlParameters parameters : batch.getRoutes()) {
+    try {
+      command.validateRequest(parameters);
+    }
+    catch (const ControlCommand::ArgumentError& e) {
+      results.addResult(ControlResponse(400, e.what()));
+      continue;
+    }
+    command.applyDefaultsToRequest(parameters);
+
+    if (isRegister && parameters.getName().size() > Fib::getMaxDepth()) {
+      results.addResult(ControlResponse(414, "Route prefix cannot exceed " +
+                                             to_string(Fib::getMaxDepth()) + " components"));
+      continue;
+    }
+
+    setFaceForSelfRegistration(interest, parameters);
+    results.addResult(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+    accepted.push_back(std::move(parameters));
+  }
+
+  // Respond since the batch is valid and authorized; per-route outcomes are in the body
+  done(ControlResponse(200, "Success").setBody(results.wireEncode()));
+
+  NFD_LOG_DEBUG((isRegister ? "register-batch" : "unregister-batch") << ": " <<
+                accepted.size() << " of " << batch.size() << " routes accepted");
+
+  for (const auto& parameters : accepted) {
+    if (isRegister) {
+      beginRegister(parameters);
+    }
+    else {
+      beginUnregister(parameters);
+    }
+  }
+}
+
+void
+RibManager::beginRegister(const ControlParameters& parameters)
+{
   Route route;
   route.faceId = parameters.getFaceId();
   route.origin = parameters.getOrigin();
@@ -241,15 +332,8 @@ RibManager::registerEntry(const Name& topPrefix, const Interest& interest,
 }
 
 void
-RibManager::unregisterEntry(const Name& topPrefix, const Interest& interest,
-                            ControlParameters parameters,
-                            const ndn::mgmt::CommandContinuation& done)
+RibManager::beginUnregister(const ControlParameters& parameters)
 {
-  setFaceForSelfRegistration(interest, parameters);
-
-  // Respond since command is valid and authorized
-  done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
-
   Route route;
   route.faceId = parameters.getFaceId();
   route.origin = parameters.getOrigin();
@@ -257,27 +341,91 @@ RibManager::unregisterEntry(const Name& topPrefix, const Interest& interest,
   beginRemoveRoute(parameters.getName(), route, [] (RibUpdateResult) {});
 }
 
+static ndn::nfd::RibEntry
+makeRibEntry(const rib::RibEntry& entry, const time::steady_clock::TimePoint& now,
+             optional<uint64_t> faceId = nullopt)
+{
+  ndn::nfd::RibEntry item;
+  item.setName(entry.getName());
+  for (const Route& route : entry.getRoutes()) {
+    if (faceId && route.faceId != *faceId) {
+      continue;
+    }
+    ndn::nfd::Route r;
+    r.setFaceId(route.faceId);
+    r.setOrigin(route.origin);
+    r.setCost(route.cost);
+    r.setFlags(route.flags);
+    if (route.expires) {
+      r.setExpirationPeriod(time::duration_cast<time::milliseconds>(*route.expires - now));
+    }
+    item.addRoute(r);
+  }
+  return item;
+}
+
 void
 RibManager::listEntries(const Name& topPrefix, const Interest& interest,
                         ndn::mgmt::StatusDatasetContext& context)
 {
+  optional<DatasetPageQuery> query;
+  optional<Name> lastName;
+  try {
+    query = extractDatasetPageQuery(topPrefix, interest);
+    if (query && query->hasCursor()) {
+      Block cursor = query->getCursor();
+      cursor.parse();
+      lastName.emplace(cursor.get(tlv::Name));
+    }
+  }
+  catch (const tlv::Error& e) {
+    NFD_LOG_DEBUG("Malformed dataset query: " << e.what());
+    return context.reject(ControlResponse(400, "Malformed query"));
+  }
+
   auto now = time::steady_clock::now();
-  for (const auto& kv : m_rib) {
-    const rib::RibEntry& entry = *kv.second;
-    ndn::nfd::RibEntry item;
-    item.setName(entry.getName());
-    for (const Route& route : entry.getRoutes()) {
-      ndn::nfd::Route r;
-      r.setFaceId(route.faceId);
-      r.setOrigin(route.origin);
-      r.setCost(route.cost);
-      r.setFlags(route.flags);
-      if (route.expires) {
-        r.setExpirationPeriod(time::duration_cast<time::milliseconds>(*route.expires - now));
-      }
-      item.addRoute(r);
+  if (!query) {
+    for (const auto& kv : m_rib) {
+      context.append(makeRibEntry(*kv.second, now).wireEncode());
+    }
+    context.end();
+    return;
+  }
+
+  // The RIB is ordered by name, so the cursor is the name of the last examined entry.
+  // Entries under the prefix filter are contiguous and are located with a single lookup.
+  auto it = lastName ? m_rib.upper_bound(*lastName) : m_rib.begin();
+  if (query->hasPrefix() && it != m_rib.end() && it->first < query->getPrefix()) {
+    it = m_rib.lower_bound(query->getPrefix());
+  }
+  auto isInRange = [&] (rib::Rib::const_iterator i) {
+    return i != m_rib.end() && (!query->hasPrefix() || query->getPrefix().isPrefixOf(i->first));
+  };
+
+  optional<uint64_t> faceId;
+  if (query->hasFaceId()) {
+    faceId = query->getFaceId();
+  }
+  size_t limit = query->getLimit();
+  size_t maxExamined = limit * MAX_ENTRIES_PER_PAGE_ITEM;
+  size_t nItems = 0;
+  size_t nExamined = 0;
+  for (; isInRange(it) && nItems < limit && nExamined < maxExamined; ++it, ++nExamined) {
+    lastName = it->first;
+    auto item = makeRibEntry(*it->second, now, faceId);
+    if (faceId && item.getRoutes().empty()) {
+      continue;
     }
     context.append(item.wireEncode());
+    ++nItems;
+  }
+
+  if (isInRange(it)) {
+    BOOST_ASSERT(lastName);
+    Block cursor(TLV_DATASET_PAGE_CURSOR);
+    cursor.push_back(lastName->wireEncode());
+    cursor.encode();
+    context.append(cursor);
   }
   context.end();
 }
@@ -304,7 +452,8 @@ RibManager::makeAuthorization(const std::string& verb)
                  const ndn::mgmt::AcceptContinuation& accept,
                  const ndn::mgmt::RejectContinuation& reject) {
     BOOST_ASSERT(params != nullptr);
-    BOOST_ASSERT(typeid(*params) == typeid(ndn::nfd::ControlParameters));
+    BOOST_ASSERT(typeid(*params) == typeid(ndn::nfd::ControlParameters) ||
+                 typeid(*params) == typeid(RouteBatchParameters));
     BOOST_ASSERT(prefix == LOCALHOST_TOP_PREFIX || prefix == LOCALHOP_TOP_PREFIX);
 
     ndn::ValidatorConfig& validator = prefix == LOCALHOST_TOP_PREFIX ?
@@ -457,9 +606,15 @@ RibManager::removeInvalidFaces(const std::vector<ndn::nfd::FaceStatus>& activeFa
   NFD_LOG_DEBUG("Checking for invalid face registrations");
 
   std::set<uint64_t> activeFaceIds;
+  m_permanentFaces.clear();
   for (const auto& faceStatus : activeFaces) {
     activeFaceIds.insert(faceStatus.getFaceId());
+    if (faceStatus.getFacePersistency() == ndn::nfd::FACE_PERSISTENCY_PERMANENT) {
+      m_permanentFaces[faceStatus.getFaceId()] = {faceStatus.getRemoteUri(), faceStatus.getLocalUri()};
+    }
   }
+  m_hasActiveFaces = true;
+  restoreSnapshot(activeFaces);
   getGlobalIoService().post([=] { m_rib.beginRemoveFailedFaces(activeFaceIds); });
 
   // Reschedule the check for future clean up
@@ -473,8 +628,121 @@ RibManager::onNotification(const ndn::nfd::FaceEventNotification& notification)
 
   if (notification.getKind() == ndn::nfd::FACE_EVENT_DESTROYED) {
     NFD_LOG_DEBUG("Received notification for destroyed FaceId " << notification.getFaceId());
+    m_permanentFaces.erase(notification.getFaceId());
     getGlobalIoService().post([this, id = notification.getFaceId()] { m_rib.beginRemoveFace(id); });
   }
+  else if (notification.getFacePersistency() == ndn::nfd::FACE_PERSISTENCY_PERMANENT) {
+    m_permanentFaces[notification.getFaceId()] = {notification.getRemoteUri(),
+                                                  notification.getLocalUri()};
+  }
+  else {
+    m_permanentFaces.erase(notification.getFaceId());
+  }
+}
+
+void
+RibManager::enableSnapshot(const std::string& filename, time::nanoseconds interval)
+{
+  BOOST_ASSERT(interval > 0_ns);
+  m_snapshotFilename = filename;
+  m_snapshotInterval = interval;
+
+  if (!m_hasLoadedSnapshot) {
+    m_hasLoadedSnapshot = true;
+    try {
+      m_pendingSnapshot = rib::RibSnapshot::load(filename);
+      NFD_LOG_INFO("Loaded " << m_pendingSnapshot->size() << " routes from " << filename);
+      // restore as soon as the active faces are known, instead of at the next periodic check
+      fetchActiveFaces();
+    }
+    catch (const rib::RibSnapshot::Error& e) {
+      NFD_LOG_WARN("Cannot load RIB snapshot: " << e.what());
+    }
+  }
+
+  scheduleSnapshot();
+}
+
+void
+RibManager::disableSnapshot()
+{
+  m_snapshotFilename.clear();
+  m_snapshotEvent.cancel();
+}
+
+void
+RibManager::scheduleSnapshot()
+{
+  m_snapshotEvent = getScheduler().schedule(m_snapshotInterval, [this] {
+    saveSnapshot();
+    scheduleSnapshot();
+  });
+}
+
+void
+RibManager::saveSnapshot()
+{
+  if (m_snapshotFilename.empty() || !m_hasActiveFaces || m_pendingSnapshot) {
+    return;
+  }
+
+  std::vector<rib::RibSnapshotRoute> routes;
+  for (const auto& ribEntry : m_rib) {
+    for (const Route& route : *ribEntry.second) {
+      auto faceIt = m_permanentFaces.find(route.faceId);
+      if (faceIt == m_permanentFaces.end() || route.announcement) {
+        // prefix announcements are refreshed by self-learning, and other faces will not reappear
+        continue;
+      }
+      routes.push_back({ribEntry.first, faceIt->second.first, faceIt->second.second, route});
+    }
+  }
+
+  try {
+    rib::RibSnapshot::save(m_snapshotFilename, routes);
+    NFD_LOG_DEBUG("Saved " << routes.size() << " routes to " << m_snapshotFilename);
+  }
+  catch (const rib::RibSnapshot::Error& e) {
+    NFD_LOG_WARN("Cannot save RIB snapshot: " << e.what());
+  }
+}
+
+void
+RibManager::restoreSnapshot(const std::vector<ndn::nfd::FaceStatus>& activeFaces)
+{
+  if (!m_pendingSnapshot) {
+    return;
+  }
+  auto routes = std::move(*m_pendingSnapshot);
+  m_pendingSnapshot = nullopt;
+
+  std::map<std::pair<std::string, std::string>, uint64_t> faceIdByUris;
+  for (const auto& faceStatus : activeFaces) {
+    if (faceStatus.getFacePersistency() == ndn::nfd::FACE_PERSISTENCY_PERMANENT) {
+      faceIdByUris[{faceStatus.getRemoteUri(), faceStatus.getLocalUri()}] = faceStatus.getFaceId();
+    }
+  }
+
+  // all routes are submitted at once; the RIB pipelines their FIB updates
+  size_t nRestored = 0;
+  for (auto& r : routes) {
+    auto it = faceIdByUris.find({r.remoteUri, r.localUri});
+    if (it == faceIdByUris.end()) {
+      NFD_LOG_DEBUG("Discarding saved route " << r.prefix << " remote=" << r.remoteUri <<
+                    " local=" << r.localUri << ": face not found");
+      continue;
+    }
+    r.route.faceId = it->second;
+    if (m_rib.find(r.prefix, r.route) != nullptr) {
+      // registered again before the snapshot was restored; the newer route takes precedence
+      NFD_LOG_DEBUG("Skipping saved route " << r.prefix << " face=" << r.route.faceId <<
+                    " origin=" << r.route.origin << ": already in RIB");
+      continue;
+    }
+    beginAddRoute(r.prefix, r.route, nullopt, [] (RibUpdateResult) {});
+    ++nRestored;
+  }
+  NFD_LOG_INFO("Restored " << nRestored << " of " << routes.size() << " saved routes");
 }
 
 } // namespace nfd
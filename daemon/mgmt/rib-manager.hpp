@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_RIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/rib-snapshot.hpp"
 #include "rib/route.hpp"
 
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
@@ -52,6 +53,11 @@ public:
   RibManager(rib::Rib& rib, ndn::Face& face, ndn::KeyChain& keyChain,
              ndn::nfd::Controller& nfdController, Dispatcher& dispatcher);
 
+  /**
+   * @brief Save the RIB snapshot one last time, if snapshots are enabled.
+   */
+  ~RibManager() override;
+
   /**
    * @brief Apply localhost_security configuration.
    */
@@ -83,6 +89,35 @@ public:
   void
   enableLocalFields();
 
+public: // snapshot
+  /**
+   * @brief Restore routes from a snapshot file and keep the file up to date.
+   *
+   * Upon the first call, routes are loaded from @p filename if it exists. After the active
+   * faces have been fetched, each loaded route is installed on the permanent face whose
+   * remote and local FaceUris match the saved ones; routes whose face has not reappeared are
+   * discarded. Afterwards, routes on permanent faces are saved to @p filename every
+   * @p interval and when the RibManager is destroyed.
+   */
+  void
+  enableSnapshot(const std::string& filename, time::nanoseconds interval);
+
+  /**
+   * @brief Stop saving snapshots.
+   */
+  void
+  disableSnapshot();
+
+  /**
+   * @brief Save routes on permanent faces to the snapshot file now.
+   *
+   * Nothing is saved while snapshots are disabled, before the active faces are known, or
+   * before a loaded snapshot has been restored, so that a valid snapshot is never replaced
+   * by an incomplete one.
+   */
+  void
+  saveSnapshot();
+
 public: // self-learning support
   enum class SlAnnounceResult {
     OK,                 ///< RIB and FIB have been updated
@@ -204,7 +239,28 @@ private: // management Dispatcher related
                   ControlParameters parameters,
                   const ndn::mgmt::CommandContinuation& done);
 
-  /** \brief Serve rib/list dataset.
+  /** \brief Serve rib/register-batch and rib/unregister-batch commands.
+   *
+   *  Each route in the batch is validated against \p command individually. The command
+   *  is answered with a RouteBatchResults body that reports the outcome for every route,
+   *  and the accepted routes are then added to (or removed from) the RIB one by one.
+   */
+  void
+  handleBatch(const ControlCommand& command, bool isRegister,
+              const Interest& interest, const ndn::mgmt::ControlParameters& params,
+              const ndn::mgmt::CommandContinuation& done);
+
+  /** \brief Start adding the route described by validated rib/register \p parameters.
+   */
+  void
+  beginRegister(const ControlParameters& parameters);
+
+  /** \brief Start removing the route described by validated rib/unregister \p parameters.
+   */
+  void
+  beginUnregister(const ControlParameters& parameters);
+
+  /** \brief Serve rib/list dataset, optionally paged and filtered by a DatasetPageQuery.
    */
   void
   listEntries(const Name& topPrefix, const Interest& interest,
@@ -233,6 +289,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   onNotification(const ndn::nfd::FaceEventNotification& notification);
 
+private: // snapshot
+  void
+  scheduleSnapshot();
+
+  /** \brief install the loaded snapshot routes whose faces are among \p activeFaces
+   */
+  void
+  restoreSnapshot(const std::vector<ndn::nfd::FaceStatus>& activeFaces);
+
 public:
   static const Name LOCALHOP_TOP_PREFIX;
 
@@ -248,6 +313,17 @@ private:
   bool m_isLocalhopEnabled;
 
   scheduler::ScopedEventId m_activeFaceFetchEvent;
+
+  /** \brief FaceUris of permanent faces, which are expected to reappear after a restart
+   */
+  std::map<uint64_t, std::pair<std::string, std::string>> m_permanentFaces;
+  bool m_hasActiveFaces = false;
+
+  std::string m_snapshotFilename;
+  time::nanoseconds m_snapshotInterval;
+  bool m_hasLoadedSnapshot = false;
+  optional<std::vector<rib::RibSnapshotRoute>> m_pendingSnapshot;
+  scheduler::ScopedEventId m_snapshotEvent;
 };
 
 std::ostream&
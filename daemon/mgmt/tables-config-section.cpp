@@ -29,10 +29,12 @@
 namespace nfd {
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const time::seconds TablesConfigSection::DEFAULT_CS_SNAPSHOT_INTERVAL = 600_s;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
   , m_isConfigured(false)
+  , m_csSnapshotInterval(DEFAULT_CS_SNAPSHOT_INTERVAL)
 {
 }
 
@@ -89,6 +91,22 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  std::string csSnapshotPath;
+  OptionalConfigSection csSnapshotPathNode = section.get_child_optional("cs_snapshot_path");
+  if (csSnapshotPathNode) {
+    csSnapshotPath = csSnapshotPathNode->get_value<std::string>();
+  }
+
+  time::seconds csSnapshotInterval = DEFAULT_CS_SNAPSHOT_INTERVAL;
+  OptionalConfigSection csSnapshotIntervalNode = section.get_child_optional("cs_snapshot_interval");
+  if (csSnapshotIntervalNode) {
+    auto n = ConfigFile::parseNumber<uint32_t>(*csSnapshotIntervalNode, "cs_snapshot_interval", "tables");
+    if (n == 0) {
+      NDN_THROW(ConfigFile::Error("Invalid value '0' for option 'cs_snapshot_interval' in section 'tables'"));
+    }
+    csSnapshotInterval = time::seconds(n);
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -111,6 +129,9 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+  m_csSnapshotPath = csSnapshotPath;
+  m_csSnapshotInterval = csSnapshotInterval;
+
   m_isConfigured = true;
 }
 
@@ -40,6 +40,8 @@ namespace nfd {
  *    cs_max_packets 65536
  *    cs_policy lru
  *    cs_unsolicited_policy drop-all
+ *    cs_snapshot_path /var/lib/ndn/nfd/cs.snapshot
+ *    cs_snapshot_interval 600
  *
  *    strategy_choice
  *    {
@@ -62,6 +64,8 @@ namespace nfd {
  *      defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
+ *  \li cs_snapshot_path and cs_snapshot_interval are recorded, but only take effect
+ *      when NFD starts.
  *
  *  It's necessary to call \p ensureConfigured() after initial configuration and
  *  configuration reload, so that the correct defaults are applied in case
@@ -81,6 +85,22 @@ public:
   void
   ensureConfigured();
 
+  /** \brief get the CS snapshot file, or an empty string if CS snapshot is disabled
+   */
+  const std::string&
+  getCsSnapshotPath() const
+  {
+    return m_csSnapshotPath;
+  }
+
+  /** \brief get the interval between periodic CS snapshots
+   */
+  time::seconds
+  getCsSnapshotInterval() const
+  {
+    return m_csSnapshotInterval;
+  }
+
 private:
   void
   processConfig(const ConfigSection& section, bool isDryRun);
@@ -93,10 +113,13 @@ private:
 
 private:
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const time::seconds DEFAULT_CS_SNAPSHOT_INTERVAL;
 
   Forwarder& m_forwarder;
 
   bool m_isConfigured;
+  std::string m_csSnapshotPath;
+  time::seconds m_csSnapshotInterval;
 };
 
 } // namespace nfd
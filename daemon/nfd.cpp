@@ -40,6 +40,7 @@
 #include "mgmt/log-config-section.hpp"
 #include "mgmt/strategy-choice-manager.hpp"
 #include "mgmt/tables-config-section.hpp"
+#include "table/cs-snapshot.hpp"
 
 namespace nfd {
 
@@ -168,6 +169,10 @@ Nfd::initializeManagement()
 
   tablesConfig.ensureConfigured();
 
+  if (!tablesConfig.getCsSnapshotPath().empty()) {
+    enableCsSnapshot(tablesConfig.getCsSnapshotPath(), tablesConfig.getCsSnapshotInterval());
+  }
+
   // add FIB entry for NFD Management Protocol
   Name topPrefix("/localhost/nfd");
   fib::Entry* entry = m_forwarder->getFib().insert(topPrefix).first;
@@ -212,4 +217,56 @@ Nfd::reloadConfigFileFaceSection()
   }
 }
 
+void
+Nfd::enableCsSnapshot(const std::string& filename, time::nanoseconds interval)
+{
+  BOOST_ASSERT(interval > 0_ns);
+  m_csSnapshot = make_unique<cs::CsSnapshot>(m_forwarder->getCs(), filename);
+  m_csSnapshotInterval = interval;
+
+  try {
+    m_csSnapshot->load();
+    NFD_LOG_INFO("Loading Content Store from " << filename);
+  }
+  catch (const cs::CsSnapshot::Error& e) {
+    NFD_LOG_WARN("Cannot load CS snapshot: " << e.what());
+  }
+
+  scheduleCsSnapshot();
+}
+
+void
+Nfd::scheduleCsSnapshot()
+{
+  m_csSnapshotEvent = getScheduler().schedule(m_csSnapshotInterval, [this] {
+    // while loading, the CS holds only part of the snapshot, which is better left intact
+    if (!m_csSnapshot->isLoading() && !m_csSnapshot->isSaving()) {
+      try {
+        m_csSnapshot->startSave();
+      }
+      catch (const cs::CsSnapshot::Error& e) {
+        NFD_LOG_WARN("Cannot save CS snapshot: " << e.what());
+      }
+    }
+    scheduleCsSnapshot();
+  });
+}
+
+void
+Nfd::saveCsSnapshot()
+{
+  // while loading, the CS holds only part of the snapshot, which is better left intact
+  if (m_csSnapshot == nullptr || m_csSnapshot->isLoading()) {
+    return;
+  }
+
+  try {
+    size_t nSaved = m_csSnapshot->save();
+    NFD_LOG_DEBUG("Saved " << nSaved << " Data packets to " << m_csSnapshot->getFilename());
+  }
+  catch (const cs::CsSnapshot::Error& e) {
+    NFD_LOG_WARN("Cannot save CS snapshot: " << e.what());
+  }
+}
+
 } // namespace nfd
@@ -45,6 +45,10 @@ class FibManager;
 class CsManager;
 class StrategyChoiceManager;
 
+namespace cs {
+class CsSnapshot;
+} // namespace cs
+
 namespace face {
 class Face;
 class FaceSystem;
@@ -93,6 +97,26 @@ public:
   void
   reloadConfigFile();
 
+  /**
+   * \brief Get the FIB manager, which may be used from the main thread only.
+   * \pre initialize() has been invoked
+   */
+  FibManager&
+  getFibManager()
+  {
+    return *m_fibManager;
+  }
+
+  /**
+   * \brief Save the Content Store to the snapshot file, if CS snapshot is enabled.
+   *
+   * This should be invoked before NFD exits, so that the Content Store can be refilled
+   * from the snapshot when NFD is started again. Unlike the periodic save, which writes
+   * the snapshot in the background, this writes the whole snapshot before returning.
+   */
+  void
+  saveCsSnapshot();
+
 private:
   explicit
   Nfd(ndn::KeyChain& keyChain);
@@ -106,6 +130,12 @@ private:
   void
   reloadConfigFileFaceSection();
 
+  void
+  enableCsSnapshot(const std::string& filename, time::nanoseconds interval);
+
+  void
+  scheduleCsSnapshot();
+
 private:
   std::string m_configFile;
   ConfigSection m_configSection;
@@ -127,6 +157,10 @@ private:
 
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
   scheduler::ScopedEventId m_reloadConfigEvent;
+
+  unique_ptr<cs::CsSnapshot> m_csSnapshot;
+  time::nanoseconds m_csSnapshotInterval;
+  scheduler::ScopedEventId m_csSnapshotEvent;
 };
 
 } // namespace nfd
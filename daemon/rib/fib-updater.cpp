@@ -24,7 +24,9 @@
  */
 
 #include "fib-updater.hpp"
+#include "common/global.hpp"
 #include "common/logger.hpp"
+#include "mgmt/fib-manager.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 
@@ -56,12 +58,25 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
   m_inheritedRoutes.clear();
 
   // Erase previously calculated FIB updates
-  m_updatesForBatchFaceId.clear();
-  m_updatesForNonBatchFaceId.clear();
+  clearFibUpdates();
 
   computeUpdates(batch);
 
-  sendUpdatesForBatchFaceId(onSuccess, onFailure);
+  auto context = make_shared<BatchContext>();
+  context->faceId = m_batchFaceId;
+  context->updatesForBatchFaceId = std::move(m_updatesForBatchFaceId);
+  context->updatesForNonBatchFaceId = std::move(m_updatesForNonBatchFaceId);
+  clearFibUpdates();
+  context->inheritedRoutes = m_inheritedRoutes;
+  context->onSuccess = onSuccess;
+  context->onFailure = onFailure;
+
+  if (m_fibManager != nullptr) {
+    applyUpdatesInProcess(context);
+  }
+  else {
+    sendUpdatesForBatchFaceId(context);
+  }
 }
 
 void
@@ -83,6 +98,9 @@ FibUpdater::computeUpdates(const RibUpdateBatch& batch)
 
         // Do not apply updates with the same face ID as the destroyed face
         // since they will be rejected by the FIB
+        for (const FibUpdate& fibUpdate : m_updatesForBatchFaceId) {
+          m_updateIndex.erase({fibUpdate.name, fibUpdate.faceId});
+        }
         m_updatesForBatchFaceId.clear();
         break;
     }
@@ -125,19 +143,9 @@ FibUpdater::computeUpdatesForRegistration(const RibUpdate& update)
   }
   else {
     // New name in RIB
-    // Find prefix's parent
-    shared_ptr<RibEntry> parent = m_rib.findParent(prefix);
-
-    Rib::RibEntryList descendants = m_rib.findDescendantsForNonInsertedName(prefix);
-    Rib::RibEntryList children;
-
-    for (const auto& descendant : descendants) {
-      // If the child has the same parent as the new entry,
-      // the new entry must be the child's new parent
-      if (descendant->getParent() == parent) {
-        children.push_back(descendant);
-      }
-    }
+    // The nearest descendants have the same parent as the new entry,
+    // so the new entry will become their parent
+    Rib::RibEntryList children = m_rib.findNearestDescendants(prefix);
 
     createFibUpdatesForNewRibEntry(prefix, route, children);
   }
@@ -186,9 +194,7 @@ FibUpdater::computeUpdatesForUnregistration(const RibUpdate& update)
 }
 
 void
-FibUpdater::sendUpdates(const FibUpdateList& updates,
-                        const FibUpdateSuccessCallback& onSuccess,
-                        const FibUpdateFailureCallback& onFailure)
+FibUpdater::sendUpdates(const shared_ptr<BatchContext>& context, const FibUpdateList& updates)
 {
   std::string updateString = (updates.size() == 1) ? " update" : " updates";
   NFD_LOG_DEBUG("Applying " << updates.size() << updateString << " to FIB");
@@ -197,42 +203,101 @@ FibUpdater::sendUpdates(const FibUpdateList& updates,
     NFD_LOG_DEBUG("Sending FIB update: " << update);
 
     if (update.action == FibUpdate::ADD_NEXTHOP) {
-      sendAddNextHopUpdate(update, onSuccess, onFailure);
+      sendAddNextHopUpdate(update, context);
     }
     else if (update.action == FibUpdate::REMOVE_NEXTHOP) {
-      sendRemoveNextHopUpdate(update, onSuccess, onFailure);
+      sendRemoveNextHopUpdate(update, context);
     }
   }
 }
 
 void
-FibUpdater::sendUpdatesForBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
-                                      const FibUpdateFailureCallback& onFailure)
+FibUpdater::sendUpdatesForBatchFaceId(const shared_ptr<BatchContext>& context)
 {
-  if (m_updatesForBatchFaceId.size() > 0) {
-    sendUpdates(m_updatesForBatchFaceId, onSuccess, onFailure);
+  if (context->updatesForBatchFaceId.size() > 0) {
+    sendUpdates(context, context->updatesForBatchFaceId);
   }
   else {
-    sendUpdatesForNonBatchFaceId(onSuccess, onFailure);
+    sendUpdatesForNonBatchFaceId(context);
   }
 }
 
 void
-FibUpdater::sendUpdatesForNonBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
-                                         const FibUpdateFailureCallback& onFailure)
+FibUpdater::sendUpdatesForNonBatchFaceId(const shared_ptr<BatchContext>& context)
 {
-  if (m_updatesForNonBatchFaceId.size() > 0) {
-    sendUpdates(m_updatesForNonBatchFaceId, onSuccess, onFailure);
+  if (context->updatesForNonBatchFaceId.size() > 0) {
+    sendUpdates(context, context->updatesForNonBatchFaceId);
   }
   else {
-    onSuccess(m_inheritedRoutes);
+    finishWithSuccess(*context);
   }
 }
 
 void
-FibUpdater::sendAddNextHopUpdate(const FibUpdate& update,
-                                 const FibUpdateSuccessCallback& onSuccess,
-                                 const FibUpdateFailureCallback& onFailure,
+FibUpdater::applyUpdatesInProcess(const shared_ptr<BatchContext>& context)
+{
+  NFD_LOG_DEBUG("Applying " << context->updatesForBatchFaceId.size() +
+                context->updatesForNonBatchFaceId.size() << " updates to FIB in-process");
+
+  // executed on the main thread; must not access members of this FibUpdater
+  auto apply = [fibManager = m_fibManager, context] {
+    for (const FibUpdate& update : context->updatesForBatchFaceId) {
+      uint32_t code = fibManager->applyFibUpdate(update);
+      if (code != 200) {
+        return code;
+      }
+    }
+    for (const FibUpdate& update : context->updatesForNonBatchFaceId) {
+      // the face may have been destroyed in the meantime, which is not an error
+      fibManager->applyFibUpdate(update);
+    }
+    return uint32_t(200);
+  };
+
+  runOnMainIoService([this, apply, context, token = std::weak_ptr<char>(m_token)] {
+    uint32_t code = apply();
+    runOnRibIoService([this, code, context, token] {
+      // m_token is released on the RIB thread, so this check cannot race with ~FibUpdater
+      if (token.expired()) {
+        return;
+      }
+
+      if (code == 200) {
+        finishWithSuccess(*context);
+      }
+      else if (code == ERROR_FACE_NOT_FOUND) {
+        NFD_LOG_DEBUG("Failed to apply updates for face " << context->faceId << " (code: " << code << ")");
+        finishWithFailure(*context, code, "Face not found");
+      }
+      else {
+        NDN_THROW(Error("Non-recoverable error code: " + to_string(code)));
+      }
+    });
+  });
+}
+
+void
+FibUpdater::finishWithSuccess(BatchContext& context)
+{
+  if (context.isFinished) {
+    return;
+  }
+  context.isFinished = true;
+  context.onSuccess(context.inheritedRoutes);
+}
+
+void
+FibUpdater::finishWithFailure(BatchContext& context, uint32_t code, const std::string& error)
+{
+  if (context.isFinished) {
+    return;
+  }
+  context.isFinished = true;
+  context.onFailure(code, error);
+}
+
+void
+FibUpdater::sendAddNextHopUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context,
                                  uint32_t nTimeouts)
 {
   m_controller.start<ndn::nfd::FibAddNextHopCommand>(
@@ -240,49 +305,43 @@ FibUpdater::sendAddNextHopUpdate(const FibUpdate& update,
       .setName(update.name)
       .setFaceId(update.faceId)
       .setCost(update.cost),
-    bind(&FibUpdater::onUpdateSuccess, this, update, onSuccess, onFailure),
-    bind(&FibUpdater::onUpdateError, this, update, onSuccess, onFailure, _1, nTimeouts));
+    bind(&FibUpdater::onUpdateSuccess, this, update, context),
+    bind(&FibUpdater::onUpdateError, this, update, context, _1, nTimeouts));
 }
 
 void
-FibUpdater::sendRemoveNextHopUpdate(const FibUpdate& update,
-                                    const FibUpdateSuccessCallback& onSuccess,
-                                    const FibUpdateFailureCallback& onFailure,
+FibUpdater::sendRemoveNextHopUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context,
                                     uint32_t nTimeouts)
 {
   m_controller.start<ndn::nfd::FibRemoveNextHopCommand>(
     ControlParameters()
       .setName(update.name)
       .setFaceId(update.faceId),
-    bind(&FibUpdater::onUpdateSuccess, this, update, onSuccess, onFailure),
-    bind(&FibUpdater::onUpdateError, this, update, onSuccess, onFailure, _1, nTimeouts));
+    bind(&FibUpdater::onUpdateSuccess, this, update, context),
+    bind(&FibUpdater::onUpdateError, this, update, context, _1, nTimeouts));
 }
 
 void
-FibUpdater::onUpdateSuccess(const FibUpdate update,
-                            const FibUpdateSuccessCallback& onSuccess,
-                            const FibUpdateFailureCallback& onFailure)
+FibUpdater::onUpdateSuccess(const FibUpdate update, const shared_ptr<BatchContext>& context)
 {
-  if (update.faceId == m_batchFaceId) {
-    m_updatesForBatchFaceId.remove(update);
+  if (update.faceId == context->faceId) {
+    context->updatesForBatchFaceId.remove(update);
 
-    if (m_updatesForBatchFaceId.size() == 0) {
-      sendUpdatesForNonBatchFaceId(onSuccess, onFailure);
+    if (context->updatesForBatchFaceId.size() == 0) {
+      sendUpdatesForNonBatchFaceId(context);
     }
   }
   else {
-    m_updatesForNonBatchFaceId.remove(update);
+    context->updatesForNonBatchFaceId.remove(update);
 
-    if (m_updatesForNonBatchFaceId.size() == 0) {
-      onSuccess(m_inheritedRoutes);
+    if (context->updatesForNonBatchFaceId.size() == 0) {
+      finishWithSuccess(*context);
     }
   }
 }
 
 void
-FibUpdater::onUpdateError(const FibUpdate update,
-                          const FibUpdateSuccessCallback& onSuccess,
-                          const FibUpdateFailureCallback& onFailure,
+FibUpdater::onUpdateError(const FibUpdate update, const shared_ptr<BatchContext>& context,
                           const ndn::nfd::ControlResponse& response, uint32_t nTimeouts)
 {
   uint32_t code = response.getCode();
@@ -290,17 +349,17 @@ FibUpdater::onUpdateError(const FibUpdate update,
                 " (code: " << code << ", error: " << response.getText() << ")");
 
   if (code == ndn::nfd::Controller::ERROR_TIMEOUT && nTimeouts < MAX_NUM_TIMEOUTS) {
-    sendAddNextHopUpdate(update, onSuccess, onFailure, ++nTimeouts);
+    sendAddNextHopUpdate(update, context, ++nTimeouts);
   }
   else if (code == ERROR_FACE_NOT_FOUND) {
-    if (update.faceId == m_batchFaceId) {
-      onFailure(code, response.getText());
+    if (update.faceId == context->faceId) {
+      finishWithFailure(*context, code, response.getText());
     }
     else {
-      m_updatesForNonBatchFaceId.remove(update);
+      context->updatesForNonBatchFaceId.remove(update);
 
-      if (m_updatesForNonBatchFaceId.size() == 0) {
-        onSuccess(m_inheritedRoutes);
+      if (context->updatesForNonBatchFaceId.size() == 0) {
+        finishWithSuccess(*context);
       }
     }
   }
@@ -317,21 +376,27 @@ FibUpdater::addFibUpdate(FibUpdate update)
 
   // If an update with the same name and route already exists,
   // replace it
-  FibUpdateList::iterator it = std::find_if(updates.begin(), updates.end(),
-    [&update] (const FibUpdate& other) {
-      return update.name == other.name && update.faceId == other.faceId;
-    });
+  auto indexIt = m_updateIndex.find({update.name, update.faceId});
 
-  if (it != updates.end()) {
-    FibUpdate& existingUpdate = *it;
+  if (indexIt != m_updateIndex.end()) {
+    FibUpdate& existingUpdate = *indexIt->second;
     existingUpdate.action = update.action;
     existingUpdate.cost = update.cost;
   }
   else {
-    updates.push_back(update);
+    auto it = updates.insert(updates.end(), update);
+    m_updateIndex.emplace(std::make_pair(it->name, it->faceId), it);
   }
 }
 
+void
+FibUpdater::clearFibUpdates()
+{
+  m_updatesForBatchFaceId.clear();
+  m_updatesForNonBatchFaceId.clear();
+  m_updateIndex.clear();
+}
+
 void
 FibUpdater::addInheritedRoutes(const RibEntry& entry, const Rib::RouteSet& routesToAdd)
 {
@@ -34,6 +34,9 @@
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
 
 namespace nfd {
+
+class FibManager;
+
 namespace rib {
 
 /** \brief computes FibUpdates based on updates to the RIB and sends them to NFD
@@ -60,14 +63,45 @@ public:
   /** \brief computes FibUpdates using the provided RibUpdateBatch and then sends the
    *         updates to NFD's FIB
    *
-   *  \note  Caller must guarantee that the previous batch has either succeeded or failed
-   *         before calling this method
+   *  Several batches may be in progress at the same time. Exactly one of \p onSuccess and
+   *  \p onFailure is invoked for each batch.
+   *
+   *  \note  Caller must guarantee that no batch in progress has a name prefix that is equal to,
+   *         an ancestor of, or a descendant of the name prefix of \p batch
    */
   void
   computeAndSendFibUpdates(const RibUpdateBatch& batch,
                            const FibUpdateSuccessCallback& onSuccess,
                            const FibUpdateFailureCallback& onFailure);
 
+  /** \brief applies FIB updates through a FibManager in the same process
+   *
+   *  If set, the FIB updates computed from each RibUpdateBatch are handed to the main thread
+   *  in one step and applied there together, instead of being sent to NFD as signed control
+   *  commands one by one.
+   *
+   *  \param fibManager FibManager on the main thread, or nullptr to use control commands
+   */
+  void
+  setInProcessFibManager(FibManager* fibManager)
+  {
+    m_fibManager = fibManager;
+  }
+
+PROTECTED_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief FIB updates of a RibUpdateBatch that is in progress
+   */
+  struct BatchContext
+  {
+    uint64_t faceId;
+    FibUpdateList updatesForBatchFaceId;
+    FibUpdateList updatesForNonBatchFaceId;
+    RibUpdateList inheritedRoutes;
+    FibUpdateSuccessCallback onSuccess;
+    FibUpdateFailureCallback onFailure;
+    bool isFinished = false; ///< whether onSuccess or onFailure has been invoked
+  };
+
 private:
   /** \brief determines the type of action that will be performed on the RIB and calls the
   *          corresponding computation method
@@ -84,23 +118,37 @@ private:
   *   \see FibUpdater::onUpdateFailure
   */
   void
-  sendUpdates(const FibUpdateList& updates,
-              const FibUpdateSuccessCallback& onSuccess,
-              const FibUpdateFailureCallback& onFailure);
+  sendUpdates(const shared_ptr<BatchContext>& context, const FibUpdateList& updates);
 
-  /** \brief sends the updates in m_updatesForBatchFaceId to NFD if any exist,
+  /** \brief sends the updates in context->updatesForBatchFaceId to NFD if any exist,
   *          otherwise calls FibUpdater::sendUpdatesForNonBatchFaceId.
   */
   void
-  sendUpdatesForBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
-                            const FibUpdateFailureCallback& onFailure);
+  sendUpdatesForBatchFaceId(const shared_ptr<BatchContext>& context);
 
-  /** \brief sends the updates in m_updatesForNonBatchFaceId to NFD if any exist,
+  /** \brief sends the updates in context->updatesForNonBatchFaceId to NFD if any exist,
   *          otherwise calls onSuccess.
   */
   void
-  sendUpdatesForNonBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
-                               const FibUpdateFailureCallback& onFailure);
+  sendUpdatesForNonBatchFaceId(const shared_ptr<BatchContext>& context);
+
+  /** \brief applies context->updatesForBatchFaceId and then context->updatesForNonBatchFaceId
+   *         on the main thread through m_fibManager, and invokes onSuccess or onFailure on the
+   *         RIB thread
+   *
+   *  If an update with the batch's Face ID fails, no other updates are applied.
+   *  Failures of updates with a different Face ID are ignored.
+   *  If the FibUpdater is destroyed before the results are back on the RIB thread,
+   *  neither onSuccess nor onFailure is invoked.
+   */
+  void
+  applyUpdatesInProcess(const shared_ptr<BatchContext>& context);
+
+  void
+  finishWithSuccess(BatchContext& context);
+
+  void
+  finishWithFailure(BatchContext& context, uint32_t code, const std::string& error);
 
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   /** \brief sends a FibAddNextHopCommand to NFD using the parameters supplied by
@@ -109,9 +157,7 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   *   \param nTimeouts the number of times this FibUpdate has failed due to timeout
   */
   VIRTUAL_WITH_TESTS void
-  sendAddNextHopUpdate(const FibUpdate& update,
-                       const FibUpdateSuccessCallback& onSuccess,
-                       const FibUpdateFailureCallback& onFailure,
+  sendAddNextHopUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context,
                        uint32_t nTimeouts = 0);
 
   /** \brief sends a FibRemoveNextHopCommand to NFD using the parameters supplied by
@@ -120,9 +166,7 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   *   \param nTimeouts the number of times this FibUpdate has failed due to timeout
   */
   VIRTUAL_WITH_TESTS void
-  sendRemoveNextHopUpdate(const FibUpdate& update,
-                          const FibUpdateSuccessCallback& onSuccess,
-                          const FibUpdateFailureCallback& onFailure,
+  sendRemoveNextHopUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context,
                           uint32_t nTimeouts = 0);
 
 private:
@@ -141,17 +185,15 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   *          is successful.
   *
   *   If the update has the same Face ID as the batch being processed, the update is
-  *   removed from m_updatesForBatchFaceId. If m_updatesForBatchFaceId becomes empty,
+  *   removed from updatesForBatchFaceId. If updatesForBatchFaceId becomes empty,
   *   the updates with a different Face ID than the batch are sent to NFD.
   *
   *   If the update has a different Face ID than the batch being processed, the update is
-  *   removed from m_updatesForBatchNonFaceId. If m_updatesForBatchNonFaceId becomes empty,
+  *   removed from updatesForNonBatchFaceId. If updatesForNonBatchFaceId becomes empty,
   *   the FIB update process is considered a success.
   */
   void
-  onUpdateSuccess(const FibUpdate update,
-                  const FibUpdateSuccessCallback& onSuccess,
-                  const FibUpdateFailureCallback& onFailure);
+  onUpdateSuccess(const FibUpdate update, const shared_ptr<BatchContext>& context);
 
   /** \brief callback used by NfdController when a FibAddNextHopCommand or FibRemoveNextHopCommand
   *          is successful.
@@ -169,9 +211,7 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   *   Otherwise, a non-recoverable error has occurred and an exception is thrown.
   */
   void
-  onUpdateError(const FibUpdate update,
-                const FibUpdateSuccessCallback& onSuccess,
-                const FibUpdateFailureCallback& onFailure,
+  onUpdateError(const FibUpdate update, const shared_ptr<BatchContext>& context,
                 const ndn::nfd::ControlResponse& response, uint32_t nTimeouts);
 
 private:
@@ -181,10 +221,19 @@ private:
   *   to m_updatesForBatchFaceId.
   *
   *   Otherwise, the update is added to m_updatesForBatchNonFaceId.
+  *
+  *   An update for the same name and Face ID as a previously added update replaces it;
+  *   the lookup goes through m_updateIndex, so a batch touching a large subtree costs
+  *   O(log n) per update instead of a linear scan of the update list.
   */
   void
   addFibUpdate(const FibUpdate update);
 
+  /** \brief clears the calculated FIB updates of the current batch
+   */
+  void
+  clearFibUpdates();
+
   /** \brief creates records of the passed routes added to the entry and creates FIB updates
   */
   void
@@ -255,14 +304,27 @@ private:
 private:
   const Rib& m_rib;
   ndn::nfd::Controller& m_controller;
+  FibManager* m_fibManager = nullptr;
   uint64_t m_batchFaceId;
 
+  /** \brief guards completion handlers posted back to the RIB thread by applyUpdatesInProcess
+   *
+   *  It is released when the FibUpdater is destroyed on the RIB thread, so that handlers of
+   *  batches still in progress on the main thread are discarded.
+   */
+  shared_ptr<char> m_token = make_shared<char>();
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  // FIB update calculation for one batch; the results are moved into a BatchContext
   FibUpdateList m_updatesForBatchFaceId;
   FibUpdateList m_updatesForNonBatchFaceId;
 
-  /** \brief list of inherited routes generated during FIB update calculation;
-   *         passed to the RIB when updates are completed successfully
+  /** \brief index of the calculated FIB updates by name and Face ID
+   */
+  std::map<std::pair<Name, uint64_t>, FibUpdateList::iterator> m_updateIndex;
+
+  /** \brief list of inherited routes generated during FIB update calculation of the most
+   *         recent batch; passed to the RIB when updates are completed successfully
    */
   RibUpdateList m_inheritedRoutes;
 };
@@ -25,6 +25,7 @@
 
 #include "nfd-rib-readvertise-destination.hpp"
 #include "common/logger.hpp"
+#include "core/route-batch.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-command.hpp>
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
@@ -36,11 +37,15 @@ NFD_LOG_INIT(NfdRibReadvertiseDestination);
 
 using ndn::nfd::ControlResponse;
 
-NfdRibReadvertiseDestination::NfdRibReadvertiseDestination(ndn::nfd::Controller& controller,
+NfdRibReadvertiseDestination::NfdRibReadvertiseDestination(ndn::Face& face,
+                                                           ndn::KeyChain& keyChain,
+                                                           ndn::nfd::Controller& controller,
                                                            Rib& rib,
                                                            const ndn::nfd::CommandOptions& options,
                                                            const ndn::nfd::ControlParameters& parameters)
-  : m_controller(controller)
+  : m_face(face)
+  , m_signer(keyChain)
+  , m_controller(controller)
   , m_commandOptions(options)
   , m_controlParameters(parameters)
 {
@@ -78,6 +83,147 @@ NfdRibReadvertiseDestination::withdraw(const nfd::rib::ReadvertisedRoute& rr,
     getCommandOptions().setSigningInfo(rr.signer));
 }
 
+void
+NfdRibReadvertiseDestination::advertiseBatch(const std::vector<BatchItem>& items)
+{
+  sendBatch(true, items);
+}
+
+void
+NfdRibReadvertiseDestination::withdrawBatch(const std::vector<BatchItem>& items)
+{
+  sendBatch(false, items);
+}
+
+void
+NfdRibReadvertiseDestination::sendBatch(bool isRegister, const std::vector<BatchItem>& items)
+{
+  if (!m_useBatchCommands) {
+    if (isRegister) {
+      ReadvertiseDestination::advertiseBatch(items);
+    }
+    else {
+      ReadvertiseDestination::withdrawBatch(items);
+    }
+    return;
+  }
+
+  struct Command
+  {
+    std::vector<BatchItem> items;
+    RouteBatchParameters batch;
+  };
+
+  // a command is signed only once, so routes with different signers go into different commands;
+  // each command is filled up to the size limit of RouteBatchParameters
+  std::vector<Command> commands;
+  for (const auto& item : items) {
+    auto params = getControlParameters().setName(item.rr->prefix);
+    auto it = std::find_if(commands.begin(), commands.end(), [&] (const Command& cmd) {
+      return cmd.items.front().rr->signer == item.rr->signer && cmd.batch.canAddRoute(params);
+    });
+    if (it == commands.end()) {
+      it = commands.emplace(commands.end());
+    }
+    it->items.push_back(item);
+    it->batch.addRoute(params);
+  }
+
+  for (const auto& cmd : commands) {
+    if (cmd.items.size() > 1) {
+      sendBatchCommand(isRegister, cmd.items, cmd.batch);
+    }
+    else if (isRegister) {
+      advertise(*cmd.items.front().rr, cmd.items.front().successCb, cmd.items.front().failureCb);
+    }
+    else {
+      withdraw(*cmd.items.front().rr, cmd.items.front().successCb, cmd.items.front().failureCb);
+    }
+  }
+}
+
+void
+NfdRibReadvertiseDestination::sendBatchCommand(bool isRegister, const std::vector<BatchItem>& items,
+                                               const RouteBatchParameters& batch)
+{
+  BOOST_ASSERT(batch.size() == items.size() && batch.isValid());
+  const char* verb = isRegister ? "register-batch" : "unregister-batch";
+  NFD_LOG_DEBUG(verb << ' ' << items.size() << " routes on " << m_commandOptions.getPrefix());
+
+  Name requestName = m_commandOptions.getPrefix();
+  requestName.append("rib").append(verb).append(batch.wireEncode());
+  Interest interest = m_signer.makeCommandInterest(requestName, items.front().rr->signer);
+  interest.setInterestLifetime(m_commandOptions.getTimeout());
+
+  // the ReadvertisedRoute pointers are not retained, only what is needed to send the routes again
+  struct Route
+  {
+    Name prefix;
+    ndn::security::SigningInfo signer;
+    std::function<void()> successCb;
+    std::function<void(const std::string&)> failureCb;
+  };
+  auto routes = make_shared<std::vector<Route>>();
+  for (const auto& item : items) {
+    routes->push_back({item.rr->prefix, item.rr->signer, item.successCb, item.failureCb});
+  }
+
+  // the destination may not implement batch commands (e.g., NLSR, or an older NFD),
+  // so the routes are sent one by one after the batch command fails as a whole
+  auto fallBack = [this, isRegister, verb, routes, token = std::weak_ptr<char>(m_token)]
+                  (const std::string& msg) {
+    if (token.expired()) {
+      return;
+    }
+    NFD_LOG_DEBUG(verb << " failed (" << msg << "), sending routes one by one from now on");
+    m_useBatchCommands = false;
+    for (const auto& route : *routes) {
+      ReadvertisedRoute rr(route.prefix);
+      rr.signer = route.signer;
+      if (isRegister) {
+        advertise(rr, route.successCb, route.failureCb);
+      }
+      else {
+        withdraw(rr, route.successCb, route.failureCb);
+      }
+    }
+  };
+
+  m_face.expressInterest(interest,
+    [routes, fallBack] (const Interest&, const Data& data) {
+      ControlResponse resp;
+      RouteBatchResults results;
+      try {
+        resp.wireDecode(data.getContent().blockFromValue());
+        if (resp.getCode() == 200) {
+          results.wireDecode(resp.getBody());
+        }
+      }
+      catch (const tlv::Error& e) {
+        return fallBack(e.what());
+      }
+      if (resp.getCode() != 200) {
+        return fallBack(resp.getText());
+      }
+
+      const auto& perRoute = results.getResults();
+      for (size_t i = 0; i < routes->size(); ++i) {
+        const auto& route = (*routes)[i];
+        if (i >= perRoute.size()) {
+          route.failureCb("missing result");
+        }
+        else if (perRoute[i].getCode() == 200) {
+          route.successCb();
+        }
+        else {
+          route.failureCb(perRoute[i].getText());
+        }
+      }
+    },
+    [fallBack] (const Interest&, const lp::Nack&) { fallBack("network Nack received"); },
+    [fallBack] (const Interest&) { fallBack("request timed out"); });
+}
+
 ndn::nfd::ControlParameters
 NfdRibReadvertiseDestination::getControlParameters()
 {
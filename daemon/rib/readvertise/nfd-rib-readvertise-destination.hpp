@@ -29,19 +29,30 @@
 #include "readvertise-destination.hpp"
 #include "rib/rib.hpp"
 
+#include <ndn-cxx/face.hpp>
 #include <ndn-cxx/mgmt/nfd/command-options.hpp>
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+#include <ndn-cxx/security/command-interest-signer.hpp>
 
 namespace nfd {
+
+class RouteBatchParameters;
+
 namespace rib {
 
 /** \brief a readvertise destination using NFD RIB management protocol
+ *
+ *  If batch commands are enabled, batches of two or more routes are sent with the
+ *  rib/register-batch and rib/unregister-batch commands; otherwise, and for single routes,
+ *  rib/register and rib/unregister are used.
  */
 class NfdRibReadvertiseDestination : public ReadvertiseDestination
 {
 public:
-  NfdRibReadvertiseDestination(ndn::nfd::Controller& controller,
+  NfdRibReadvertiseDestination(ndn::Face& face,
+                               ndn::KeyChain& keyChain,
+                               ndn::nfd::Controller& controller,
                                Rib& rib,
                                const ndn::nfd::CommandOptions& options = ndn::nfd::CommandOptions(),
                                const ndn::nfd::ControlParameters& parameters =
@@ -62,6 +73,34 @@ public:
            std::function<void()> successCb,
            std::function<void(const std::string&)> failureCb) override;
 
+  /** \brief add name prefixes into NFD RIB with as few commands as possible
+   */
+  void
+  advertiseBatch(const std::vector<BatchItem>& items) override;
+
+  /** \brief remove name prefixes from NFD RIB with as few commands as possible
+   */
+  void
+  withdrawBatch(const std::vector<BatchItem>& items) override;
+
+  bool
+  getUseBatchCommands() const
+  {
+    return m_useBatchCommands;
+  }
+
+  /** \brief enable or disable the rib/register-batch and rib/unregister-batch commands
+   *
+   *  Batch commands are disabled by default, because NLSR and older versions of NFD do not
+   *  implement them. If a batch command times out or is rejected as a whole, batch commands
+   *  are disabled, and the routes of that batch are sent again one by one.
+   */
+  void
+  setUseBatchCommands(bool wantBatchCommands)
+  {
+    m_useBatchCommands = wantBatchCommands;
+  }
+
 protected:
   ndn::nfd::ControlParameters
   getControlParameters();
@@ -70,6 +109,16 @@ protected:
   getCommandOptions();
 
 private:
+  void
+  sendBatch(bool isRegister, const std::vector<BatchItem>& items);
+
+  /** \brief sends one batch command
+   *  \param batch parameters of \p items, in the same order
+   */
+  void
+  sendBatchCommand(bool isRegister, const std::vector<BatchItem>& items,
+                   const RouteBatchParameters& batch);
+
   void
   handleRibInsert(const Name& name);
 
@@ -77,6 +126,8 @@ private:
   handleRibErase(const Name& name);
 
 private:
+  ndn::Face& m_face;
+  ndn::security::CommandInterestSigner m_signer;
   ndn::nfd::Controller& m_controller;
 
   signal::ScopedConnection m_ribInsertConn;
@@ -84,6 +135,12 @@ private:
 
   ndn::nfd::CommandOptions m_commandOptions;
   ndn::nfd::ControlParameters m_controlParameters;
+  bool m_useBatchCommands = false;
+
+  /** \brief expires when this destination is destroyed, so that pending batch commands
+   *         do not fall back to per-route commands on a dangling destination
+   */
+  shared_ptr<char> m_token = make_shared<char>();
 };
 
 } // namespace rib
@@ -31,6 +31,22 @@ namespace rib {
 
 NFD_LOG_INIT(ReadvertiseDestination);
 
+void
+ReadvertiseDestination::advertiseBatch(const std::vector<BatchItem>& items)
+{
+  for (const auto& item : items) {
+    this->advertise(*item.rr, item.successCb, item.failureCb);
+  }
+}
+
+void
+ReadvertiseDestination::withdrawBatch(const std::vector<BatchItem>& items)
+{
+  for (const auto& item : items) {
+    this->withdraw(*item.rr, item.successCb, item.failureCb);
+  }
+}
+
 void
 ReadvertiseDestination::setAvailability(bool isAvailable)
 {
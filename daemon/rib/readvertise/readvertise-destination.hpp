@@ -36,6 +36,15 @@ namespace rib {
 class ReadvertiseDestination : noncopyable
 {
 public:
+  /** \brief a readvertised route in a batch, and the callbacks to report its outcome
+   */
+  struct BatchItem
+  {
+    const ReadvertisedRoute* rr;
+    std::function<void()> successCb;
+    std::function<void(const std::string&)> failureCb;
+  };
+
   virtual
   ~ReadvertiseDestination() = default;
 
@@ -44,6 +53,21 @@ public:
             std::function<void()> successCb,
             std::function<void(const std::string&)> failureCb) = 0;
 
+  /** \brief advertise several routes at once
+   *
+   *  The default implementation invokes advertise() for each route. A destination that can
+   *  convey multiple routes in a single command should override this.
+   */
+  virtual void
+  advertiseBatch(const std::vector<BatchItem>& items);
+
+  /** \brief withdraw several routes at once
+   *
+   *  The default implementation invokes withdraw() for each route.
+   */
+  virtual void
+  withdrawBatch(const std::vector<BatchItem>& items);
+
   virtual void
   withdraw(const ReadvertisedRoute& rr,
            std::function<void()> successCb,
@@ -36,6 +36,8 @@ NFD_LOG_INIT(Readvertise);
 
 const time::milliseconds Readvertise::RETRY_DELAY_MIN = 50_s;
 const time::milliseconds Readvertise::RETRY_DELAY_MAX = 1_h;
+const size_t Readvertise::DEFAULT_MAX_BATCH_SIZE = 64;
+const size_t Readvertise::DEFAULT_RATE_LIMIT = 100;
 
 static time::milliseconds
 randomizeTimer(time::milliseconds baseTimer)
@@ -50,6 +52,10 @@ Readvertise::Readvertise(Rib& rib,
                          unique_ptr<ReadvertiseDestination> destination)
   : m_policy(std::move(policy))
   , m_destination(std::move(destination))
+  , m_maxBatchSize(DEFAULT_MAX_BATCH_SIZE)
+  , m_rateLimit(DEFAULT_RATE_LIMIT)
+  , m_tokens(DEFAULT_MAX_BATCH_SIZE)
+  , m_lastRefill(time::steady_clock::now())
 {
   m_addRouteConn = rib.afterAddRoute.connect([this] (const auto& r) { this->afterAddRoute(r); });
   m_removeRouteConn = rib.beforeRemoveRoute.connect([this] (const auto& r) { this->beforeRemoveRoute(r); });
@@ -64,6 +70,19 @@ Readvertise::Readvertise(Rib& rib,
   });
 }
 
+void
+Readvertise::setBatchLimits(size_t maxBatchSize, size_t rateLimit)
+{
+  BOOST_ASSERT(maxBatchSize > 0);
+  m_maxBatchSize = maxBatchSize;
+  m_rateLimit = rateLimit;
+  m_tokens = std::min(m_tokens, static_cast<double>(m_maxBatchSize));
+
+  m_isFlushScheduled = false;
+  m_flushEvt.cancel();
+  this->scheduleFlush();
+}
+
 void
 Readvertise::afterAddRoute(const RibRouteRef& ribRoute)
 {
@@ -99,7 +118,7 @@ Readvertise::afterAddRoute(const RibRouteRef& ribRoute)
                 ',' << ribRoute.route->origin << ") readvertising-as " << action->prefix <<
                 " signer " << action->signer);
   rrIt->retryDelay = RETRY_DELAY_MIN;
-  this->advertise(rrIt);
+  this->enqueue(rrIt);
 }
 
 void
@@ -122,7 +141,7 @@ Readvertise::beforeRemoveRoute(const RibRouteRef& ribRoute)
   }
 
   rrIt->retryDelay = RETRY_DELAY_MIN;
-  this->withdraw(rrIt);
+  this->enqueue(rrIt);
 }
 
 void
@@ -130,16 +149,23 @@ Readvertise::afterDestinationAvailable()
 {
   for (auto rrIt = m_rrs.begin(); rrIt != m_rrs.end(); ++rrIt) {
     rrIt->retryDelay = RETRY_DELAY_MIN;
-    this->advertise(rrIt);
+    rrIt->isAdvertised = false;
+    this->enqueue(rrIt);
   }
 }
 
 void
 Readvertise::afterDestinationUnavailable()
 {
+  m_queue.clear();
+  m_isFlushScheduled = false;
+  m_flushEvt.cancel();
+
   for (auto rrIt = m_rrs.begin(); rrIt != m_rrs.end();) {
-    if (rrIt->nRibRoutes > 0) {
-      rrIt->retryEvt.cancel(); // stop retrying or refreshing
+    rrIt->retryEvt.cancel(); // stop retrying or refreshing
+    rrIt->isQueued = false;
+    rrIt->isAdvertised = false;
+    if (rrIt->nRibRoutes > 0 || rrIt->isInFlight) {
       ++rrIt;
     }
     else {
@@ -149,52 +175,192 @@ Readvertise::afterDestinationUnavailable()
 }
 
 void
-Readvertise::advertise(ReadvertisedRouteContainer::iterator rrIt)
+Readvertise::enqueue(ReadvertisedRouteContainer::iterator rrIt)
 {
-  BOOST_ASSERT(rrIt->nRibRoutes > 0);
+  rrIt->retryEvt.cancel();
 
   if (!m_destination->isAvailable()) {
-    NFD_LOG_DEBUG("advertise " << rrIt->prefix << " destination-unavailable");
+    NFD_LOG_DEBUG("enqueue " << rrIt->prefix << " destination-unavailable");
+    if (rrIt->nRibRoutes == 0 && !rrIt->isInFlight) {
+      m_rrs.erase(rrIt);
+    }
     return;
   }
 
-  m_destination->advertise(*rrIt,
-    [=] {
-      NFD_LOG_DEBUG("advertise " << rrIt->prefix << " success");
-      rrIt->retryDelay = RETRY_DELAY_MIN;
-      rrIt->retryEvt = getScheduler().schedule(randomizeTimer(m_policy->getRefreshInterval()),
-                                               [=] { advertise(rrIt); });
-    },
-    [=] (const std::string& msg) {
-      NFD_LOG_DEBUG("advertise " << rrIt->prefix << " failure " << msg);
-      rrIt->retryDelay = std::min(RETRY_DELAY_MAX, rrIt->retryDelay * 2);
-      rrIt->retryEvt = getScheduler().schedule(randomizeTimer(rrIt->retryDelay),
-                                               [=] { advertise(rrIt); });
-    });
+  if (rrIt->isQueued) {
+    // the operation is decided when the batch is formed, so one queue entry suffices
+    return;
+  }
+  rrIt->isQueued = true;
+  m_queue.push_back(rrIt);
+  this->scheduleFlush();
 }
 
-void
-Readvertise::withdraw(ReadvertisedRouteContainer::iterator rrIt)
+double
+Readvertise::refillTokens()
 {
-  BOOST_ASSERT(rrIt->nRibRoutes == 0);
+  auto now = time::steady_clock::now();
+  if (m_rateLimit > 0) {
+    auto elapsed = time::duration_cast<time::duration<double>>(now - m_lastRefill);
+    m_tokens = std::min(m_tokens + elapsed.count() * m_rateLimit,
+                        static_cast<double>(m_maxBatchSize));
+  }
+  else {
+    m_tokens = m_maxBatchSize;
+  }
+  m_lastRefill = now;
+  return m_tokens;
+}
 
-  if (!m_destination->isAvailable()) {
-    NFD_LOG_DEBUG("withdraw " << rrIt->prefix << " destination-unavailable");
-    m_rrs.erase(rrIt);
+void
+Readvertise::scheduleFlush()
+{
+  if (m_isFlushScheduled || m_queue.empty()) {
     return;
   }
 
-  m_destination->withdraw(*rrIt,
-    [=] {
-      NFD_LOG_DEBUG("withdraw " << rrIt->prefix << " success");
+  // wait until a full batch, or the whole queue if shorter, can be sent
+  double needed = std::min(m_queue.size(), m_maxBatchSize);
+  double tokens = this->refillTokens();
+  time::nanoseconds delay = 0_ns;
+  if (tokens < needed) {
+    delay = time::duration_cast<time::nanoseconds>(
+              time::duration<double>((needed - tokens) / m_rateLimit));
+  }
+
+  m_isFlushScheduled = true;
+  m_flushEvt = getScheduler().schedule(delay, [this] {
+    m_isFlushScheduled = false;
+    this->flush();
+  });
+}
+
+void
+Readvertise::flush()
+{
+  size_t budget = std::min(static_cast<size_t>(this->refillTokens()), m_maxBatchSize);
+  std::vector<ReadvertiseDestination::BatchItem> advertisements;
+  std::vector<ReadvertiseDestination::BatchItem> withdrawals;
+  std::vector<ReadvertisedRouteContainer::iterator> deferred;
+
+  // routes whose previous command has not completed are skipped, so that the destination
+  // processes the commands for each route in order; they are flushed again upon completion
+  while (!m_queue.empty() && advertisements.size() + withdrawals.size() < budget) {
+    auto rrIt = m_queue.front();
+    m_queue.pop_front();
+    if (rrIt->isInFlight) {
+      deferred.push_back(rrIt);
+      continue;
+    }
+    rrIt->isQueued = false;
+
+    if (rrIt->nRibRoutes > 0) {
+      if (rrIt->isAdvertised) {
+        NFD_LOG_DEBUG("advertise " << rrIt->prefix << " unchanged");
+        this->scheduleRefresh(rrIt);
+        continue;
+      }
+
+      rrIt->isInFlight = true;
+      rrIt->mayBeAdvertised = true;
+      advertisements.push_back({&*rrIt,
+        [=] {
+          NFD_LOG_DEBUG("advertise " << rrIt->prefix << " success");
+          rrIt->retryDelay = RETRY_DELAY_MIN;
+          rrIt->isAdvertised = true;
+          if (this->finishCommand(rrIt)) {
+            this->scheduleRefresh(rrIt);
+          }
+        },
+        [=] (const std::string& msg) {
+          NFD_LOG_DEBUG("advertise " << rrIt->prefix << " failure " << msg);
+          rrIt->retryDelay = std::min(RETRY_DELAY_MAX, rrIt->retryDelay * 2);
+          if (this->finishCommand(rrIt)) {
+            this->scheduleRetry(rrIt);
+          }
+        }});
+    }
+    else {
+      if (!rrIt->mayBeAdvertised) {
+        NFD_LOG_DEBUG("withdraw " << rrIt->prefix << " not-advertised");
+        m_rrs.erase(rrIt);
+        continue;
+      }
+
+      rrIt->isInFlight = true;
+      rrIt->isAdvertised = false;
+      withdrawals.push_back({&*rrIt,
+        [=] {
+          NFD_LOG_DEBUG("withdraw " << rrIt->prefix << " success");
+          rrIt->retryDelay = RETRY_DELAY_MIN;
+          rrIt->mayBeAdvertised = false;
+          if (this->finishCommand(rrIt)) {
+            m_rrs.erase(rrIt);
+          }
+        },
+        [=] (const std::string& msg) {
+          NFD_LOG_DEBUG("withdraw " << rrIt->prefix << " failure " << msg);
+          rrIt->retryDelay = std::min(RETRY_DELAY_MAX, rrIt->retryDelay * 2);
+          if (this->finishCommand(rrIt)) {
+            this->scheduleRetry(rrIt);
+          }
+        }});
+    }
+  }
+
+  bool isBudgetExhausted = !m_queue.empty();
+  m_queue.insert(m_queue.end(), deferred.begin(), deferred.end());
+  m_tokens -= advertisements.size() + withdrawals.size();
+
+  NFD_LOG_TRACE("flush advertise=" << advertisements.size() << " withdraw=" << withdrawals.size() <<
+                " queued=" << m_queue.size());
+  if (!advertisements.empty()) {
+    m_destination->advertiseBatch(advertisements);
+  }
+  if (!withdrawals.empty()) {
+    m_destination->withdrawBatch(withdrawals);
+  }
+
+  if (isBudgetExhausted) {
+    this->scheduleFlush();
+  }
+}
+
+void
+Readvertise::scheduleRefresh(ReadvertisedRouteContainer::iterator rrIt)
+{
+  rrIt->retryEvt = getScheduler().schedule(randomizeTimer(m_policy->getRefreshInterval()), [=] {
+    rrIt->isAdvertised = false;
+    this->enqueue(rrIt);
+  });
+}
+
+void
+Readvertise::scheduleRetry(ReadvertisedRouteContainer::iterator rrIt)
+{
+  rrIt->retryEvt = getScheduler().schedule(randomizeTimer(rrIt->retryDelay),
+                                           [=] { this->enqueue(rrIt); });
+}
+
+bool
+Readvertise::finishCommand(ReadvertisedRouteContainer::iterator rrIt)
+{
+  rrIt->isInFlight = false;
+
+  if (rrIt->isQueued) {
+    // the route has changed while the command was in progress
+    this->scheduleFlush();
+    return false;
+  }
+
+  if (!m_destination->isAvailable()) {
+    if (rrIt->nRibRoutes == 0) {
       m_rrs.erase(rrIt);
-    },
-    [=] (const std::string& msg) {
-      NFD_LOG_DEBUG("withdraw " << rrIt->prefix << " failure " << msg);
-      rrIt->retryDelay = std::min(RETRY_DELAY_MAX, rrIt->retryDelay * 2);
-      rrIt->retryEvt = getScheduler().schedule(randomizeTimer(rrIt->retryDelay),
-                                               [=] { withdraw(rrIt); });
-    });
+    }
+    return false;
+  }
+
+  return true;
 }
 
 } // namespace rib
@@ -31,6 +31,8 @@
 #include "readvertised-route.hpp"
 #include "rib/rib.hpp"
 
+#include <deque>
+
 namespace nfd {
 namespace rib {
 
@@ -40,6 +42,13 @@ namespace rib {
  *  protocol daemon or another NFD-RIB. It monitors the RIB for route additions and removals,
  *  asks the ReadvertisePolicy to make decision on whether to readvertise each new route and what
  *  prefix to readvertise as, and invokes a ReadvertiseDestination to send the commands.
+ *
+ *  Changes are not sent immediately. A readvertised route that needs to be advertised,
+ *  refreshed, or withdrawn enters a queue, and the queue is passed to the destination in
+ *  batches. The number of changes sent per second is limited by a token bucket whose capacity
+ *  equals the maximum batch size. Since the operation for a queued route is decided when its
+ *  batch is formed, a withdrawal followed by a re-advertisement (or vice versa) while the route
+ *  is still queued results in at most one command, or none at all.
  */
 class Readvertise : noncopyable
 {
@@ -48,6 +57,25 @@ public:
               unique_ptr<ReadvertisePolicy> policy,
               unique_ptr<ReadvertiseDestination> destination);
 
+  /** \brief set the limits on the changes passed to the destination
+   *  \param maxBatchSize maximum number of changes in a batch, must be positive
+   *  \param rateLimit maximum number of changes per second, or zero for no limit
+   */
+  void
+  setBatchLimits(size_t maxBatchSize, size_t rateLimit);
+
+  /** \brief number of readvertised routes whose changes are waiting to be sent
+   */
+  size_t
+  getQueueDepth() const
+  {
+    return m_queue.size();
+  }
+
+public:
+  static const size_t DEFAULT_MAX_BATCH_SIZE;
+  static const size_t DEFAULT_RATE_LIMIT;
+
 private:
   void
   afterAddRoute(const RibRouteRef& ribRoute);
@@ -61,11 +89,35 @@ private:
   void
   afterDestinationUnavailable();
 
+  /** \brief queue a readvertised route whose state must be sent to the destination
+   */
+  void
+  enqueue(ReadvertisedRouteContainer::iterator rrIt);
+
+  /** \brief compute the number of changes that may be sent now
+   */
+  double
+  refillTokens();
+
+  void
+  scheduleFlush();
+
+  /** \brief pass a batch of queued changes to the destination
+   */
   void
-  advertise(ReadvertisedRouteContainer::iterator rrIt);
+  flush();
 
   void
-  withdraw(ReadvertisedRouteContainer::iterator rrIt);
+  scheduleRefresh(ReadvertisedRouteContainer::iterator rrIt);
+
+  void
+  scheduleRetry(ReadvertisedRouteContainer::iterator rrIt);
+
+  /** \brief common processing after the destination has replied to a command
+   *  \retval false the route has been erased or has changed, and needs no further processing
+   */
+  bool
+  finishCommand(ReadvertisedRouteContainer::iterator rrIt);
 
 private:
   /** \brief maps from RIB route to readvertised route derived from RIB route(s)
@@ -81,6 +133,14 @@ private:
   ReadvertisedRouteContainer m_rrs;
   RouteRrIndex m_routeToRr;
 
+  std::deque<ReadvertisedRouteContainer::iterator> m_queue;
+  size_t m_maxBatchSize;
+  size_t m_rateLimit;
+  double m_tokens;
+  time::steady_clock::TimePoint m_lastRefill;
+  bool m_isFlushScheduled = false;
+  scheduler::ScopedEventId m_flushEvt;
+
   signal::ScopedConnection m_addRouteConn;
   signal::ScopedConnection m_removeRouteConn;
 };
@@ -44,6 +44,10 @@ public:
     : prefix(prefix)
     , nRibRoutes(0)
     , retryDelay(0)
+    , isQueued(false)
+    , isInFlight(false)
+    , isAdvertised(false)
+    , mayBeAdvertised(false)
   {
   }
 
@@ -53,6 +57,10 @@ public:
   mutable size_t nRibRoutes; ///< number of RIB routes that cause the readvertisement
   mutable time::milliseconds retryDelay; ///< retry interval (not used for refresh)
   mutable scheduler::ScopedEventId retryEvt; ///< retry or refresh event
+  mutable bool isQueued; ///< whether a change is waiting in the readvertise queue
+  mutable bool isInFlight; ///< whether a command is being processed by the destination
+  mutable bool isAdvertised; ///< whether the destination has confirmed the advertisement
+  mutable bool mayBeAdvertised; ///< whether an advertisement may have reached the destination
 };
 
 inline bool
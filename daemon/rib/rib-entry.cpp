@@ -107,6 +107,16 @@ RibEntry::removeChild(shared_ptr<RibEntry> child)
   m_children.remove(child);
 }
 
+void
+RibEntry::removeChildren(const std::list<shared_ptr<RibEntry>>& children)
+{
+  for (const auto& child : children) {
+    BOOST_ASSERT(child->getParent().get() == this);
+    child->setParent(nullptr);
+  }
+  m_children.remove_if([] (const shared_ptr<RibEntry>& child) { return child->getParent() == nullptr; });
+}
+
 RibEntry::RouteList::iterator
 RibEntry::eraseRoute(RouteList::iterator route)
 {
@@ -115,10 +125,6 @@ RibEntry::eraseRoute(RouteList::iterator route)
       m_nRoutesWithCaptureSet--;
     }
 
-    // Cancel any scheduled event
-    NFD_LOG_TRACE("Cancelling expiration event: " << route->getExpirationEvent());
-    route->cancelExpirationEvent();
-
     return m_routes.erase(route);
   }
 
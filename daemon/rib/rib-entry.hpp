@@ -65,6 +65,14 @@ public:
   void
   removeChild(shared_ptr<RibEntry> child);
 
+  /** \brief remove several children at once
+   *
+   *  Equivalent to calling removeChild() on each element of \p children,
+   *  but in a single pass over the children of this entry.
+   */
+  void
+  removeChildren(const std::list<shared_ptr<RibEntry>>& children);
+
   const std::list<shared_ptr<RibEntry>>&
   getChildren() const;
 
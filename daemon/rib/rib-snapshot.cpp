@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib-snapshot.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
+
+#include <boost/crc.hpp>
+
+#include <cerrno>
+#include <cstdio> // for std::rename()
+#include <cstring> // for memcpy(), strerror()
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace rib {
+
+const uint8_t MAGIC[] = {'N', 'F', 'D', 'R', 'I', 'B', 0x00, 0x01};
+const size_t HEADER_SIZE = sizeof(MAGIC) + 8 + 4;
+
+static std::string
+makeErrorMessage(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+static uint32_t
+computeChecksum(const uint8_t* buf, size_t size)
+{
+  boost::crc_32_type crc;
+  crc.process_bytes(buf, size);
+  return crc.checksum();
+}
+
+static void
+writeBigEndian(uint8_t* buf, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    buf[size - 1 - i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+static uint64_t
+readBigEndian(const uint8_t* buf, size_t size)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+/** \brief an open file descriptor, and optionally a memory mapping of the whole file
+ */
+class MappedFile : noncopyable
+{
+public:
+  MappedFile(const std::string& filename, int flags)
+    : m_fd(::open(filename.data(), flags, 0644))
+  {
+    if (m_fd < 0) {
+      NDN_THROW(RibSnapshot::Error(makeErrorMessage("Cannot open " + filename)));
+    }
+  }
+
+  ~MappedFile()
+  {
+    if (m_map != nullptr) {
+      ::munmap(m_map, m_size);
+    }
+    ::close(m_fd);
+  }
+
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  uint8_t*
+  map(size_t size, int prot)
+  {
+    void* p = ::mmap(nullptr, size, prot, MAP_SHARED, m_fd, 0);
+    if (p == MAP_FAILED) {
+      NDN_THROW(RibSnapshot::Error(makeErrorMessage("mmap")));
+    }
+    m_map = static_cast<uint8_t*>(p);
+    m_size = size;
+    return m_map;
+  }
+
+private:
+  int m_fd;
+  uint8_t* m_map = nullptr;
+  size_t m_size = 0;
+};
+
+static size_t
+encodeRoute(ndn::EncodingBuffer& encoder, const RibSnapshotRoute& r,
+            time::steady_clock::TimePoint steadyNow, time::system_clock::TimePoint systemNow)
+{
+  size_t len = 0;
+  if (r.route.expires) {
+    auto expirationTime = systemNow + time::duration_cast<time::system_clock::Duration>(
+                                        *r.route.expires - steadyNow);
+    auto ms = std::max<int64_t>(time::toUnixTimestamp(expirationTime).count(), 0);
+    len += ndn::encoding::prependNonNegativeIntegerBlock(encoder, TLV_RIB_SNAPSHOT_EXPIRATION_TIME, ms);
+  }
+  len += ndn::encoding::prependNonNegativeIntegerBlock(encoder, ndn::tlv::nfd::Flags, r.route.flags);
+  len += ndn::encoding::prependNonNegativeIntegerBlock(encoder, ndn::tlv::nfd::Cost, r.route.cost);
+  len += ndn::encoding::prependNonNegativeIntegerBlock(encoder, ndn::tlv::nfd::Origin, r.route.origin);
+  len += ndn::encoding::prependStringBlock(encoder, TLV_RIB_SNAPSHOT_LOCAL_URI, r.localUri);
+  len += ndn::encoding::prependStringBlock(encoder, TLV_RIB_SNAPSHOT_REMOTE_URI, r.remoteUri);
+  len += r.prefix.wireEncode(encoder);
+  len += encoder.prependVarNumber(len);
+  len += encoder.prependVarNumber(TLV_RIB_SNAPSHOT_ROUTE);
+  return len;
+}
+
+static optional<RibSnapshotRoute>
+decodeRoute(const Block& block,
+            time::steady_clock::TimePoint steadyNow, time::system_clock::TimePoint systemNow)
+{
+  block.parse();
+
+  RibSnapshotRoute r;
+  r.prefix.wireDecode(block.get(tlv::Name));
+  r.remoteUri = ndn::encoding::readString(block.get(TLV_RIB_SNAPSHOT_REMOTE_URI));
+  r.localUri = ndn::encoding::readString(block.get(TLV_RIB_SNAPSHOT_LOCAL_URI));
+  r.route.origin = ndn::encoding::readNonNegativeIntegerAs<ndn::nfd::RouteOrigin>(
+                     block.get(ndn::tlv::nfd::Origin));
+  r.route.cost = ndn::encoding::readNonNegativeInteger(block.get(ndn::tlv::nfd::Cost));
+  r.route.flags = ndn::encoding::readNonNegativeIntegerAs<decltype(r.route.flags)>(
+                    block.get(ndn::tlv::nfd::Flags));
+
+  auto expIt = block.find(TLV_RIB_SNAPSHOT_EXPIRATION_TIME);
+  if (expIt != block.elements_end()) {
+    auto ms = ndn::encoding::readNonNegativeInteger(*expIt);
+    auto expirationTime = time::fromUnixTimestamp(time::milliseconds(ms));
+    if (expirationTime <= systemNow) {
+      return nullopt;
+    }
+    r.route.expires = steadyNow + time::duration_cast<time::steady_clock::Duration>(
+                                    expirationTime - systemNow);
+  }
+  return r;
+}
+
+void
+RibSnapshot::save(const std::string& filename, const std::vector<RibSnapshotRoute>& routes)
+{
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+
+  ndn::EncodingBuffer encoder;
+  size_t len = 0;
+  for (auto it = routes.rbegin(); it != routes.rend(); ++it) {
+    len += encodeRoute(encoder, *it, steadyNow, systemNow);
+  }
+  len += encoder.prependVarNumber(len);
+  len += encoder.prependVarNumber(TLV_RIB_SNAPSHOT);
+
+  std::string tmpFilename = filename + ".tmp";
+  {
+    MappedFile file(tmpFilename, O_RDWR | O_CREAT | O_TRUNC);
+    size_t fileSize = HEADER_SIZE + encoder.size();
+    if (::ftruncate(file.getFd(), static_cast<off_t>(fileSize)) != 0) {
+      NDN_THROW(Error(makeErrorMessage("Cannot resize " + tmpFilename)));
+    }
+
+    uint8_t* buf = file.map(fileSize, PROT_READ | PROT_WRITE);
+    std::memcpy(buf, MAGIC, sizeof(MAGIC));
+    writeBigEndian(buf + sizeof(MAGIC), encoder.size(), 8);
+    writeBigEndian(buf + sizeof(MAGIC) + 8, computeChecksum(encoder.buf(), encoder.size()), 4);
+    std::memcpy(buf + HEADER_SIZE, encoder.buf(), encoder.size());
+
+    if (::msync(buf, fileSize, MS_SYNC) != 0) {
+      NDN_THROW(Error(makeErrorMessage("Cannot write " + tmpFilename)));
+    }
+  }
+
+  if (std::rename(tmpFilename.data(), filename.data()) != 0) {
+    NDN_THROW(Error(makeErrorMessage("Cannot rename " + tmpFilename + " to " + filename)));
+  }
+}
+
+std::vector<RibSnapshotRoute>
+RibSnapshot::load(const std::string& filename)
+{
+  MappedFile file(filename, O_RDONLY);
+
+  struct stat st;
+  if (::fstat(file.getFd(), &st) != 0) {
+    NDN_THROW(Error(makeErrorMessage("Cannot stat " + filename)));
+  }
+  size_t fileSize = static_cast<size_t>(st.st_size);
+  if (fileSize < HEADER_SIZE) {
+    NDN_THROW(Error(filename + " is truncated"));
+  }
+
+  const uint8_t* buf = file.map(fileSize, PROT_READ);
+  if (std::memcmp(buf, MAGIC, sizeof(MAGIC)) != 0) {
+    NDN_THROW(Error(filename + " is not a RIB snapshot"));
+  }
+  uint64_t payloadSize = readBigEndian(buf + sizeof(MAGIC), 8);
+  if (payloadSize != fileSize - HEADER_SIZE) {
+    NDN_THROW(Error(filename + " is truncated"));
+  }
+  const uint8_t* payload = buf + HEADER_SIZE;
+  if (readBigEndian(buf + sizeof(MAGIC) + 8, 4) != computeChecksum(payload, payloadSize)) {
+    NDN_THROW(Error(filename + " has a checksum mismatch"));
+  }
+
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+
+  std::vector<RibSnapshotRoute> routes;
+  try {
+    Block snapshot(payload, payloadSize);
+    if (snapshot.type() != TLV_RIB_SNAPSHOT) {
+      NDN_THROW(Error(filename + " is not a RIB snapshot"));
+    }
+    snapshot.parse();
+    for (const auto& element : snapshot.elements()) {
+      if (element.type() != TLV_RIB_SNAPSHOT_ROUTE) {
+        continue;
+      }
+      auto r = decodeRoute(element, steadyNow, systemNow);
+      if (r) {
+        routes.push_back(std::move(*r));
+      }
+    }
+  }
+  catch (const tlv::Error& e) {
+    NDN_THROW_NESTED(Error(filename + " is malformed: " + e.what()));
+  }
+  return routes;
+}
+
+} // namespace rib
+} // namespace nfd
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_RIB_RIB_SNAPSHOT_HPP
+#define NFD_DAEMON_RIB_RIB_SNAPSHOT_HPP
+
+#include "route.hpp"
+
+namespace nfd {
+namespace rib {
+
+/** \brief TLV-TYPE numbers of the RIB snapshot encoding.
+ *  \sa RibSnapshot
+ */
+enum : uint32_t {
+  TLV_RIB_SNAPSHOT                 = 205,
+  TLV_RIB_SNAPSHOT_ROUTE           = 206,
+  TLV_RIB_SNAPSHOT_REMOTE_URI      = 207,
+  TLV_RIB_SNAPSHOT_LOCAL_URI       = 208,
+  TLV_RIB_SNAPSHOT_EXPIRATION_TIME = 209,
+};
+
+/** \brief a route saved in a RIB snapshot
+ *
+ *  The nexthop is identified by the FaceUris of the face, because FaceIds are not preserved
+ *  across restarts. \c route.faceId is neither saved nor restored.
+ */
+struct RibSnapshotRoute
+{
+  Name prefix;
+  std::string remoteUri;
+  std::string localUri;
+  Route route;
+};
+
+/** \brief reads and writes RIB snapshot files
+ *
+ *  A snapshot file consists of a 20-octet header followed by the payload:
+ *  \code
+ *  Header = MAGIC (8 octets, "NFDRIB" 0x00 0x01)
+ *           PAYLOAD-LENGTH (8 octets, big endian)
+ *           PAYLOAD-CRC32 (4 octets, big endian)
+ *
+ *  RibSnapshot = RIB-SNAPSHOT-TYPE TLV-LENGTH
+ *                  *RibSnapshotRoute
+ *
+ *  RibSnapshotRoute = RIB-SNAPSHOT-ROUTE-TYPE TLV-LENGTH
+ *                       Name
+ *                       RemoteUri
+ *                       LocalUri
+ *                       Origin
+ *                       Cost
+ *                       Flags
+ *                       [ExpirationTime]
+ *
+ *  RemoteUri = RIB-SNAPSHOT-REMOTE-URI-TYPE TLV-LENGTH *OCTET
+ *  LocalUri = RIB-SNAPSHOT-LOCAL-URI-TYPE TLV-LENGTH *OCTET
+ *  ExpirationTime = RIB-SNAPSHOT-EXPIRATION-TIME-TYPE TLV-LENGTH
+ *                     NonNegativeInteger ; milliseconds since the Unix epoch
+ *  \endcode
+ *
+ *  Route expirations are stored as wall-clock time, so that the time spent while the daemon
+ *  was not running is deducted when the snapshot is loaded.
+ *
+ *  The file is written to a temporary file through a shared memory mapping and then renamed
+ *  over \p filename, so that a crash while saving leaves the previous snapshot intact.
+ *  The file is read through a memory mapping, and is rejected as a whole if the checksum
+ *  does not match.
+ */
+class RibSnapshot
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** \brief write \p routes to \p filename
+   *  \throw Error the file cannot be written
+   */
+  static void
+  save(const std::string& filename, const std::vector<RibSnapshotRoute>& routes);
+
+  /** \brief read routes from \p filename
+   *
+   *  Routes that have expired are omitted.
+   *
+   *  \throw Error the file cannot be read, or is corrupted
+   */
+  static std::vector<RibSnapshotRoute>
+  load(const std::string& filename);
+};
+
+} // namespace rib
+} // namespace nfd
+
+#endif // NFD_DAEMON_RIB_RIB_SNAPSHOT_HPP
@@ -25,13 +25,38 @@
 
 #include "rib.hpp"
 #include "fib-updater.hpp"
+#include "common/global.hpp"
 #include "common/logger.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 namespace rib {
 
 NFD_LOG_INIT(Rib);
 
+static std::tuple<Name, uint64_t, ndn::nfd::RouteOrigin>
+makeQueuedRouteUpdateKey(const RibUpdate& update)
+{
+  return std::make_tuple(update.getName(), update.getRoute().faceId, update.getRoute().origin);
+}
+
+/** \brief determines whether \p names contains \p prefix, an ancestor, or a descendant of it
+ */
+static bool
+hasRelatedName(const std::multiset<Name>& names, const Name& prefix)
+{
+  for (size_t i = 0; i <= prefix.size(); ++i) {
+    if (names.count(prefix.getPrefix(i)) > 0) {
+      return true;
+    }
+  }
+
+  // descendants of prefix sort right after it
+  auto it = names.upper_bound(prefix);
+  return it != names.end() && prefix.isPrefixOf(*it);
+}
+
 bool
 operator<(const RibRouteRef& lhs, const RibRouteRef& rhs)
 {
@@ -104,6 +129,7 @@ Rib::insert(const Name& prefix, const Route& route)
     if (didInsert) {
       // The route was new and we successfully inserted it.
       m_nItems++;
+      entryIt->expirationSlot = nullopt;
 
       afterAddRoute(RibRouteRef{entry, entryIt});
 
@@ -111,14 +137,14 @@ Rib::insert(const Name& prefix, const Route& route)
       m_faceEntries.emplace(route.faceId, entry);
     }
     else {
-      // Route exists, update fields
-      // First cancel old scheduled event, if any, then set the EventId to new one
-      if (entryIt->getExpirationEvent()) {
-        NFD_LOG_TRACE("Cancelling expiration event for " << entry->getName() << " " << *entryIt);
-        entryIt->cancelExpirationEvent();
-      }
-
+      // Route exists, update fields; it stays in its expiration wheel slot
+      auto expirationSlot = entryIt->expirationSlot;
       *entryIt = route;
+      entryIt->expirationSlot = expirationSlot;
+    }
+
+    if (entryIt->expires) {
+      scheduleExpiration(entry, *entryIt);
     }
   }
   else {
@@ -130,6 +156,7 @@ Rib::insert(const Name& prefix, const Route& route)
 
     entry->setName(prefix);
     auto routeIt = entry->insertRoute(route).first;
+    routeIt->expirationSlot = nullopt;
 
     // Find prefix's parent
     shared_ptr<RibEntry> parent = findParent(prefix);
@@ -139,17 +166,15 @@ Rib::insert(const Name& prefix, const Route& route)
       parent->addChild(entry);
     }
 
-    RibEntryList children = findDescendants(prefix);
+    // Remove nearest descendants from parent and inherit them as children
+    RibEntryList children = findNearestDescendants(prefix);
+    if (parent != nullptr) {
+      parent->removeChildren(children);
+    }
 
     for (const auto& child : children) {
-      if (child->getParent() == parent) {
-        // Remove child from parent and inherit parent's child
-        if (parent != nullptr) {
-          parent->removeChild(child);
-        }
-
-        entry->addChild(child);
-      }
+      BOOST_ASSERT(child->getParent() == nullptr);
+      entry->addChild(child);
     }
 
     // Register with face lookup table
@@ -158,6 +183,10 @@ Rib::insert(const Name& prefix, const Route& route)
     // do something after inserting an entry
     afterInsertEntry(prefix);
     afterAddRoute(RibRouteRef{entry, routeIt});
+
+    if (routeIt->expires) {
+      scheduleExpiration(entry, *routeIt);
+    }
   }
 }
 
@@ -211,6 +240,108 @@ Rib::onRouteExpiration(const Name& prefix, const Route& route)
   beginApplyUpdate(update, nullptr, nullptr);
 }
 
+void
+Rib::scheduleExpiration(const shared_ptr<RibEntry>& entry, Route& route)
+{
+  BOOST_ASSERT(route.expires);
+
+  // round up to the end of the slot, so that routes never expire early
+  auto sinceEpoch = route.expires->time_since_epoch();
+  auto nTicks = sinceEpoch / m_expirationTick + (sinceEpoch % m_expirationTick > 0_ns ? 1 : 0);
+  auto slotEnd = time::steady_clock::TimePoint(nTicks * m_expirationTick);
+
+  if (route.expirationSlot && *route.expirationSlot <= slotEnd) {
+    // refreshed or unchanged; the route is re-filed when its current slot ends
+    return;
+  }
+  route.expirationSlot = slotEnd;
+
+  auto& slot = m_expirationWheel[slotEnd];
+  slot.push_back({entry, route.faceId, route.origin});
+
+  // a new earliest slot needs an earlier timer
+  if (slot.size() == 1 && m_expirationWheel.begin()->first == slotEnd) {
+    m_expirationEvent = getScheduler().schedule(slotEnd - time::steady_clock::now(),
+                                                [this] { onExpirationTick(); });
+  }
+}
+
+void
+Rib::onExpirationTick()
+{
+  auto now = time::steady_clock::now();
+
+  RibUpdateBatch batch(ndn::nfd::INVALID_FACE_ID);
+  std::multiset<Name> batchNames;
+  std::vector<RibUpdate> relatedUpdates;
+
+  while (!m_expirationWheel.empty() && m_expirationWheel.begin()->first <= now) {
+    auto slotEnd = m_expirationWheel.begin()->first;
+    for (const ExpiringRoute& er : m_expirationWheel.begin()->second) {
+      auto entry = er.entry.lock();
+      if (entry == nullptr) {
+        continue;
+      }
+
+      Route query;
+      query.faceId = er.faceId;
+      query.origin = er.origin;
+      auto routeIt = entry->findRoute(query);
+      if (routeIt == entry->end() || routeIt->expirationSlot != slotEnd) {
+        // erased, or filed in another slot, since this element was added
+        continue;
+      }
+      Route& route = *routeIt;
+      route.expirationSlot = nullopt;
+
+      if (!route.expires) {
+        // made permanent
+        continue;
+      }
+      if (*route.expires > now) {
+        // refreshed; the new slot ends after now, so it is not visited by this loop
+        scheduleExpiration(entry, route);
+        continue;
+      }
+
+      const Name& prefix = entry->getName();
+      NFD_LOG_DEBUG(route << " for " << prefix << " has expired");
+      RibUpdate update;
+      update.setAction(RibUpdate::UNREGISTER)
+            .setName(prefix)
+            .setRoute(route);
+
+      // FibUpdater computes every update of a batch against the current RIB state,
+      // which is only correct if the updates do not affect each other's namespaces
+      if (hasRelatedName(batchNames, prefix)) {
+        relatedUpdates.push_back(update);
+      }
+      else {
+        batchNames.insert(prefix);
+        batch.add(update);
+      }
+    }
+    m_expirationWheel.erase(m_expirationWheel.begin());
+  }
+
+  if (!m_expirationWheel.empty()) {
+    m_expirationEvent = getScheduler().schedule(m_expirationWheel.begin()->first - now,
+                                                [this] { onExpirationTick(); });
+  }
+
+  if (batch.size() == 0) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("Expiring " << batch.size() + relatedUpdates.size() << " routes");
+  BOOST_ASSERT(m_fibUpdater != nullptr);
+  m_updateBatches.push_back({batch, nullptr, nullptr});
+  for (const RibUpdate& update : relatedUpdates) {
+    addUpdateToQueue(update, nullptr, nullptr);
+  }
+  sendBatchFromQueue();
+}
+
 shared_ptr<RibEntry>
 Rib::findParent(const Name& prefix) const
 {
@@ -245,18 +376,19 @@ Rib::findDescendants(const Name& prefix) const
   return children;
 }
 
-std::list<shared_ptr<RibEntry>>
-Rib::findDescendantsForNonInsertedName(const Name& prefix) const
+Rib::RibEntryList
+Rib::findNearestDescendants(const Name& prefix) const
 {
-  std::list<shared_ptr<RibEntry>> children;
+  RibEntryList descendants;
 
-  for (const auto& pair : m_rib) {
-    if (prefix.isPrefixOf(pair.first)) {
-      children.push_back(pair.second);
-    }
+  auto it = m_rib.upper_bound(prefix);
+  while (it != m_rib.end() && prefix.isPrefixOf(it->first)) {
+    descendants.push_back(it->second);
+    // all names under it->first sort before its successor
+    it = m_rib.lower_bound(it->first.getSuccessor());
   }
 
-  return children;
+  return descendants;
 }
 
 Rib::RibTable::iterator
@@ -397,6 +529,7 @@ Rib::enqueueRemoveFace(const RibEntry& entry, uint64_t faceId)
   }
 }
 
+
 void
 Rib::addUpdateToQueue(const RibUpdate& update,
                       const Rib::UpdateSuccessCallback& onSuccess,
@@ -405,37 +538,115 @@ Rib::addUpdateToQueue(const RibUpdate& update,
   RibUpdateBatch batch(update.getRoute().faceId);
   batch.add(update);
 
-  UpdateQueueItem item{batch, onSuccess, onFailure};
-  m_updateBatches.push_back(std::move(item));
+  if (update.getAction() == RibUpdate::REMOVE_FACE) {
+    m_updateBatches.push_back({batch, onSuccess, onFailure});
+    return;
+  }
+
+  auto key = makeQueuedRouteUpdateKey(update);
+  auto queued = m_queuedRouteUpdates.find(key);
+  if (queued == m_queuedRouteUpdates.end()) {
+    m_updateBatches.push_back({batch, onSuccess, onFailure});
+    m_queuedRouteUpdates.emplace(std::move(key), std::prev(m_updateBatches.end()));
+    return;
+  }
+
+  // Supersede the queued update for the same route: the outcome of REGISTER or UNREGISTER
+  // does not depend on earlier updates of the same route, so only the last one is applied
+  UpdateQueueItem& item = *queued->second;
+  NFD_LOG_DEBUG("Coalescing " << *item.batch.begin() << " with " << update);
+  item.batch = batch;
+
+  auto onSuccess1 = std::move(item.managerSuccessCallback);
+  item.managerSuccessCallback = [onSuccess1, onSuccess] {
+    if (onSuccess1 != nullptr) {
+      onSuccess1();
+    }
+    if (onSuccess != nullptr) {
+      onSuccess();
+    }
+  };
+  auto onFailure1 = std::move(item.managerFailureCallback);
+  item.managerFailureCallback = [onFailure1, onFailure] (uint32_t code, const std::string& error) {
+    if (onFailure1 != nullptr) {
+      onFailure1(code, error);
+    }
+    if (onFailure != nullptr) {
+      onFailure(code, error);
+    }
+  };
 }
 
 void
 Rib::sendBatchFromQueue()
 {
-  if (m_updateBatches.empty() || m_isUpdateInProgress) {
+  if (m_isSendingBatches) {
+    // a batch completed synchronously; the outer invocation continues scanning the queue
     return;
   }
+  m_isSendingBatches = true;
+
+  // names of queued batches that are passed over; later batches must not overtake them
+  // if related, so that updates of a namespace are applied in the order they were queued
+  std::multiset<Name> blockedPrefixes;
+  size_t nBlockedBatches = 0;
+
+  auto it = m_updateBatches.begin();
+  while (it != m_updateBatches.end() &&
+         m_nInFlightBatches < m_maxInFlightBatches &&
+         nBlockedBatches < m_maxInFlightBatches) {
+    bool isBlocked = std::any_of(it->batch.begin(), it->batch.end(),
+      [this, &blockedPrefixes] (const RibUpdate& update) {
+        return hasRelatedName(m_inFlightPrefixes, update.getName()) ||
+               hasRelatedName(blockedPrefixes, update.getName());
+      });
+    if (isBlocked) {
+      for (const RibUpdate& update : it->batch) {
+        blockedPrefixes.insert(update.getName());
+      }
+      ++nBlockedBatches;
+      ++it;
+      continue;
+    }
 
-  m_isUpdateInProgress = true;
-
-  UpdateQueueItem item = std::move(m_updateBatches.front());
-  m_updateBatches.pop_front();
-
-  RibUpdateBatch& batch = item.batch;
-
-  // Until task #1698, each RibUpdateBatch contains exactly one RIB update
-  BOOST_ASSERT(batch.size() == 1);
-
-  auto fibSuccessCb = bind(&Rib::onFibUpdateSuccess, this, batch, _1, item.managerSuccessCallback);
-  auto fibFailureCb = bind(&Rib::onFibUpdateFailure, this, item.managerFailureCallback, _1, _2);
+    // only single-update batches can be indexed for coalescing
+    if (it->batch.size() == 1) {
+      auto queued = m_queuedRouteUpdates.find(makeQueuedRouteUpdateKey(*it->batch.begin()));
+      if (queued != m_queuedRouteUpdates.end() && queued->second == it) {
+        m_queuedRouteUpdates.erase(queued);
+      }
+    }
+    UpdateQueueItem item = std::move(*it);
+    m_updateBatches.erase(it);
+
+    const RibUpdateBatch& batch = item.batch;
+    InFlightPrefixes inFlightPrefixes;
+    inFlightPrefixes.reserve(batch.size());
+    for (const RibUpdate& update : batch) {
+      inFlightPrefixes.push_back(m_inFlightPrefixes.insert(update.getName()));
+    }
+    ++m_nInFlightBatches;
+
+    auto fibSuccessCb = bind(&Rib::onFibUpdateSuccess, this, batch, _1, item.managerSuccessCallback,
+                             inFlightPrefixes);
+    auto fibFailureCb = bind(&Rib::onFibUpdateFailure, this, item.managerFailureCallback, _1, _2,
+                             inFlightPrefixes);
+    m_fibUpdater->computeAndSendFibUpdates(batch, fibSuccessCb, fibFailureCb);
+
+    // the batch may have completed synchronously, rescan from the front of the queue
+    blockedPrefixes.clear();
+    nBlockedBatches = 0;
+    it = m_updateBatches.begin();
+  }
 
-  m_fibUpdater->computeAndSendFibUpdates(batch, fibSuccessCb, fibFailureCb);
+  m_isSendingBatches = false;
 }
 
 void
 Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
                         const RibUpdateList& inheritedRoutes,
-                        const Rib::UpdateSuccessCallback& onSuccess)
+                        const Rib::UpdateSuccessCallback& onSuccess,
+                        const InFlightPrefixes& inFlightPrefixes)
 {
   for (const RibUpdate& update : batch) {
     switch (update.getAction()) {
@@ -452,7 +663,7 @@ Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
   // Add and remove precalculated inherited routes to RibEntries
   modifyInheritedRoutes(inheritedRoutes);
 
-  m_isUpdateInProgress = false;
+  releaseInFlightPrefixes(inFlightPrefixes);
 
   if (onSuccess != nullptr) {
     onSuccess();
@@ -464,9 +675,10 @@ Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
 
 void
 Rib::onFibUpdateFailure(const Rib::UpdateFailureCallback& onFailure,
-                        uint32_t code, const std::string& error)
+                        uint32_t code, const std::string& error,
+                        const InFlightPrefixes& inFlightPrefixes)
 {
-  m_isUpdateInProgress = false;
+  releaseInFlightPrefixes(inFlightPrefixes);
 
   if (onFailure != nullptr) {
     onFailure(code, error);
@@ -476,6 +688,15 @@ Rib::onFibUpdateFailure(const Rib::UpdateFailureCallback& onFailure,
   sendBatchFromQueue();
 }
 
+void
+Rib::releaseInFlightPrefixes(const InFlightPrefixes& inFlightPrefixes)
+{
+  for (auto it : inFlightPrefixes) {
+    m_inFlightPrefixes.erase(it);
+  }
+  --m_nInFlightBatches;
+}
+
 void
 Rib::modifyInheritedRoutes(const RibUpdateList& inheritedRoutes)
 {
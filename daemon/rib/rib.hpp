@@ -31,6 +31,8 @@
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 
+#include <tuple>
+
 namespace nfd {
 namespace rib {
 
@@ -81,6 +83,22 @@ public:
     return m_rib.begin();
   }
 
+  /** \return an iterator to the first entry whose name is not less than \p name
+   */
+  const_iterator
+  lower_bound(const Name& name) const
+  {
+    return m_rib.lower_bound(name);
+  }
+
+  /** \return an iterator to the first entry whose name is greater than \p name
+   */
+  const_iterator
+  upper_bound(const Name& name) const
+  {
+    return m_rib.upper_bound(name);
+  }
+
   const_iterator
   end() const
   {
@@ -127,17 +145,63 @@ public:
   void
   beginRemoveFailedFaces(const std::set<uint64_t>& activeFaceIds);
 
+  /** \brief starts removing an expired route
+   */
   void
   onRouteExpiration(const Name& prefix, const Route& route);
 
   void
   insert(const Name& prefix, const Route& route);
 
+  /** \brief sets the maximum number of update batches whose FIB updates are in progress
+   *
+   *  Batches are started in queue order, except that a batch may overtake queued batches whose
+   *  name prefixes are unrelated to its own, i.e., neither equal, ancestors, nor descendants.
+   *  Batches with related name prefixes are never in progress at the same time.
+   */
+  void
+  setMaxInFlightBatches(size_t n)
+  {
+    BOOST_ASSERT(n > 0);
+    m_maxInFlightBatches = n;
+  }
+
+  size_t
+  getMaxInFlightBatches() const
+  {
+    return m_maxInFlightBatches;
+  }
+
+  /** \brief sets the granularity of route expiration
+   *
+   *  Routes are not expired by individual timers. Every route with an expiration time is
+   *  placed in the slot of a coarse-grained expiration wheel that ends at or after that time.
+   *  When a slot ends, all of its expired routes are removed together, and routes that were
+   *  refreshed in the meantime are moved to a later slot. A route therefore expires up to one
+   *  tick late, but never early.
+   */
+  void
+  setExpirationTick(time::nanoseconds tick)
+  {
+    BOOST_ASSERT(tick > 0_ns);
+    m_expirationTick = tick;
+  }
+
+  time::nanoseconds
+  getExpirationTick() const
+  {
+    return m_expirationTick;
+  }
+
 private:
   void
   enqueueRemoveFace(const RibEntry& entry, uint64_t faceId);
 
   /** \brief Append the RIB update to the update queue.
+   *
+   *  If a REGISTER or UNREGISTER update for the same name and route is queued but has not
+   *  started, it is superseded by \p update: \p update takes its place in the queue, and
+   *  the callbacks of both are invoked when it completes.
    *
    *  To start updates, invoke sendBatchFromQueue() .
    */
@@ -146,19 +210,48 @@ private:
                    const Rib::UpdateSuccessCallback& onSuccess,
                    const Rib::UpdateFailureCallback& onFailure);
 
-  /** \brief Send the first update batch in the queue, if no other update is in progress.
+  /** \brief Send update batches from the queue, while fewer than m_maxInFlightBatches
+   *         batches are in progress.
+   *  \sa setMaxInFlightBatches
    */
   void
   sendBatchFromQueue();
 
+  /// names of the updates of a batch in progress, as positions in m_inFlightPrefixes
+  using InFlightPrefixes = std::vector<std::multiset<Name>::iterator>;
+
   void
   onFibUpdateSuccess(const RibUpdateBatch& batch,
                      const RibUpdateList& inheritedRoutes,
-                     const Rib::UpdateSuccessCallback& onSuccess);
+                     const Rib::UpdateSuccessCallback& onSuccess,
+                     const InFlightPrefixes& inFlightPrefixes);
 
   void
   onFibUpdateFailure(const Rib::UpdateFailureCallback& onFailure,
-                     uint32_t code, const std::string& error);
+                     uint32_t code, const std::string& error,
+                     const InFlightPrefixes& inFlightPrefixes);
+
+  void
+  releaseInFlightPrefixes(const InFlightPrefixes& inFlightPrefixes);
+
+  /** \brief file \p route of \p entry in the expiration wheel
+   *
+   *  Nothing is done if the route is already filed in a slot that ends no later than its
+   *  expiration time: a refreshed route is moved to a later slot only when its current slot ends.
+   *
+   *  \pre route.expires is set
+   *  \pre route is stored in \p entry
+   */
+  void
+  scheduleExpiration(const shared_ptr<RibEntry>& entry, Route& route);
+
+  /** \brief remove the expired routes of all slots that have ended
+   *
+   *  Expired routes with mutually unrelated names are removed in a single RibUpdateBatch;
+   *  the remaining ones are queued as individual updates.
+   */
+  void
+  onExpirationTick();
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
@@ -174,11 +267,15 @@ private:
   std::list<shared_ptr<RibEntry>>
   findDescendants(const Name& prefix) const;
 
-  /** \brief find entries under \p prefix
-   *  \pre a RIB entry does not exist at \p prefix
+  /** \brief find the topmost entries under \p prefix, i.e. those without an ancestor entry
+   *         that is also under \p prefix
+   *
+   *  The subtree below each returned entry is skipped, so the cost is proportional to the
+   *  number of returned entries rather than to the number of entries under \p prefix.
+   *  An entry at \p prefix itself, if any, is not returned.
    */
-  std::list<shared_ptr<RibEntry>>
-  findDescendantsForNonInsertedName(const Name& prefix) const;
+  RibEntryList
+  findNearestDescendants(const Name& prefix) const;
 
   RibTable::iterator
   eraseEntry(RibTable::iterator it);
@@ -240,13 +337,40 @@ private:
   struct UpdateQueueItem
   {
     RibUpdateBatch batch;
-    const Rib::UpdateSuccessCallback managerSuccessCallback;
-    const Rib::UpdateFailureCallback managerFailureCallback;
+    Rib::UpdateSuccessCallback managerSuccessCallback;
+    Rib::UpdateFailureCallback managerFailureCallback;
   };
 
   using UpdateQueue = std::list<UpdateQueueItem>;
   UpdateQueue m_updateBatches;
-  bool m_isUpdateInProgress = false;
+
+  /// queued REGISTER and UNREGISTER updates, indexed by name, FaceId, and origin
+  std::map<std::tuple<Name, uint64_t, ndn::nfd::RouteOrigin>, UpdateQueue::iterator> m_queuedRouteUpdates;
+
+  std::multiset<Name> m_inFlightPrefixes; ///< names of the updates of batches in progress
+  size_t m_nInFlightBatches = 0;
+  size_t m_maxInFlightBatches = 32;
+  bool m_isSendingBatches = false;
+
+  struct ExpiringRoute
+  {
+    weak_ptr<RibEntry> entry;
+    uint64_t faceId;
+    ndn::nfd::RouteOrigin origin;
+  };
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief routes that may expire in each slot, indexed by the end of the slot
+   *
+   *  Each route in the RIB with an expiration time has one element in the slot recorded in
+   *  Route::expirationSlot. Elements of erased routes, and the element left behind in a later
+   *  slot when a route's expiration time is moved earlier, are dropped when their slot ends.
+   */
+  std::map<time::steady_clock::TimePoint, std::vector<ExpiringRoute>> m_expirationWheel;
+
+private:
+  time::nanoseconds m_expirationTick = 1_s;
+  scheduler::ScopedEventId m_expirationEvent;
 
   friend class FibUpdater;
 };
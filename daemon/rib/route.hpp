@@ -31,7 +31,6 @@
 #include <ndn-cxx/encoding/nfd-constants.hpp>
 #include <ndn-cxx/mgmt/nfd/route-flags-traits.hpp>
 #include <ndn-cxx/prefix-announcement.hpp>
-#include <ndn-cxx/util/scheduler.hpp>
 
 #include <type_traits>
 
@@ -53,24 +52,6 @@ public:
    */
   Route(const ndn::PrefixAnnouncement& ann, uint64_t faceId);
 
-  const scheduler::EventId&
-  getExpirationEvent() const
-  {
-    return m_expirationEvent;
-  }
-
-  void
-  setExpirationEvent(const scheduler::EventId& eid)
-  {
-    m_expirationEvent = eid;
-  }
-
-  void
-  cancelExpirationEvent()
-  {
-    m_expirationEvent.cancel();
-  }
-
   std::underlying_type_t<ndn::nfd::RouteFlags>
   getFlags() const
   {
@@ -100,8 +81,12 @@ public:
    */
   time::steady_clock::TimePoint annExpires;
 
-private:
-  scheduler::EventId m_expirationEvent;
+  /** \brief End of the expiration wheel slot in which this route is filed.
+   *
+   *  This is maintained by Rib, and is nullopt if the route is not in the expiration wheel.
+   *  It is not considered by operator==.
+   */
+  optional<time::steady_clock::TimePoint> expirationSlot;
 };
 
 bool
@@ -50,9 +50,49 @@ const std::string CFG_LOCALHOST_SECURITY = "localhost_security";
 const std::string CFG_LOCALHOP_SECURITY = "localhop_security";
 const std::string CFG_PREFIX_PROPAGATE = "auto_prefix_propagate";
 const std::string CFG_READVERTISE_NLSR = "readvertise_nlsr";
+const std::string CFG_MAX_INFLIGHT_UPDATES = "max_inflight_updates";
+const std::string CFG_READVERTISE_BATCH_SIZE = "readvertise_batch_size";
+const std::string CFG_READVERTISE_RATE_LIMIT = "readvertise_rate_limit";
+const std::string CFG_SNAPSHOT_PATH = "snapshot_path";
+const std::string CFG_SNAPSHOT_INTERVAL = "snapshot_interval";
 const Name READVERTISE_NLSR_PREFIX = "/localhost/nlsr";
 const uint64_t PROPAGATE_DEFAULT_COST = 15;
 const time::milliseconds PROPAGATE_DEFAULT_TIMEOUT = 10_s;
+const size_t DEFAULT_MAX_INFLIGHT_UPDATES = 32;
+const time::seconds DEFAULT_SNAPSHOT_INTERVAL = 60_s;
+
+static size_t
+parseMaxInFlightUpdates(const ConfigSection::value_type& item)
+{
+  auto n = ConfigFile::parseNumber<size_t>(item, CFG_SECTION);
+  if (n == 0) {
+    NDN_THROW(ConfigFile::Error("Invalid value '0' for option '" + CFG_MAX_INFLIGHT_UPDATES +
+                                "' in section '" + CFG_SECTION + "'"));
+  }
+  return n;
+}
+
+static size_t
+parseReadvertiseBatchSize(const ConfigSection::value_type& item)
+{
+  auto n = ConfigFile::parseNumber<size_t>(item, CFG_SECTION);
+  if (n == 0) {
+    NDN_THROW(ConfigFile::Error("Invalid value '0' for option '" + CFG_READVERTISE_BATCH_SIZE +
+                                "' in section '" + CFG_SECTION + "'"));
+  }
+  return n;
+}
+
+static time::seconds
+parseSnapshotInterval(const ConfigSection::value_type& item)
+{
+  auto n = ConfigFile::parseNumber<uint32_t>(item, CFG_SECTION);
+  if (n == 0) {
+    NDN_THROW(ConfigFile::Error("Invalid value '0' for option '" + CFG_SNAPSHOT_INTERVAL +
+                                "' in section '" + CFG_SECTION + "'"));
+  }
+  return time::seconds(n);
+}
 
 static ConfigSection
 loadConfigSectionFromFile(const std::string& filename)
@@ -178,6 +218,23 @@ Service::checkConfig(const ConfigSection& section, const std::string& filename)
     else if (key == CFG_READVERTISE_NLSR) {
       ConfigFile::parseYesNo(item, CFG_SECTION + "." + CFG_READVERTISE_NLSR);
     }
+    else if (key == CFG_MAX_INFLIGHT_UPDATES) {
+      parseMaxInFlightUpdates(item);
+    }
+    else if (key == CFG_READVERTISE_BATCH_SIZE) {
+      parseReadvertiseBatchSize(item);
+    }
+    else if (key == CFG_READVERTISE_RATE_LIMIT) {
+      ConfigFile::parseNumber<size_t>(item, CFG_SECTION);
+    }
+    else if (key == CFG_SNAPSHOT_PATH) {
+      if (value.get_value<std::string>().empty()) {
+        NDN_THROW(ConfigFile::Error("Empty value for option " + CFG_SECTION + "." + key));
+      }
+    }
+    else if (key == CFG_SNAPSHOT_INTERVAL) {
+      parseSnapshotInterval(item);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_SECTION + "." + key));
     }
@@ -194,6 +251,11 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
 {
   bool wantPrefixPropagate = false;
   bool wantReadvertiseNlsr = false;
+  size_t maxInFlightUpdates = DEFAULT_MAX_INFLIGHT_UPDATES;
+  size_t readvertiseBatchSize = Readvertise::DEFAULT_MAX_BATCH_SIZE;
+  size_t readvertiseRateLimit = Readvertise::DEFAULT_RATE_LIMIT;
+  std::string snapshotPath;
+  time::seconds snapshotInterval = DEFAULT_SNAPSHOT_INTERVAL;
 
   for (const auto& item : section) {
     const std::string& key = item.first;
@@ -220,20 +282,54 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
                        .setPrefix(RibManager::LOCALHOP_TOP_PREFIX)
                        .setTimeout(timeout ? time::milliseconds(*timeout) : PROPAGATE_DEFAULT_TIMEOUT);
 
+        auto destination = make_unique<NfdRibReadvertiseDestination>(m_face, m_keyChain,
+                                                                     m_nfdController, m_rib,
+                                                                     options, parameters);
+        for (const auto& option : value) {
+          if (option.first == "batch_commands") {
+            destination->setUseBatchCommands(
+              ConfigFile::parseYesNo(option, CFG_SECTION + "." + CFG_PREFIX_PROPAGATE));
+          }
+        }
+
         m_readvertisePropagation = make_unique<Readvertise>(
           m_rib,
           make_unique<HostToGatewayReadvertisePolicy>(m_keyChain, item.second),
-          make_unique<NfdRibReadvertiseDestination>(m_nfdController, m_rib, options, parameters));
+          std::move(destination));
       }
     }
     else if (key == CFG_READVERTISE_NLSR) {
       wantReadvertiseNlsr = ConfigFile::parseYesNo(item, CFG_SECTION + "." + CFG_READVERTISE_NLSR);
     }
+    else if (key == CFG_MAX_INFLIGHT_UPDATES) {
+      maxInFlightUpdates = parseMaxInFlightUpdates(item);
+    }
+    else if (key == CFG_READVERTISE_BATCH_SIZE) {
+      readvertiseBatchSize = parseReadvertiseBatchSize(item);
+    }
+    else if (key == CFG_READVERTISE_RATE_LIMIT) {
+      readvertiseRateLimit = ConfigFile::parseNumber<size_t>(item, CFG_SECTION);
+    }
+    else if (key == CFG_SNAPSHOT_PATH) {
+      snapshotPath = value.get_value<std::string>();
+    }
+    else if (key == CFG_SNAPSHOT_INTERVAL) {
+      snapshotInterval = parseSnapshotInterval(item);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_SECTION + "." + key));
     }
   }
 
+  m_rib.setMaxInFlightBatches(maxInFlightUpdates);
+
+  if (!snapshotPath.empty()) {
+    m_ribManager.enableSnapshot(snapshotPath, snapshotInterval);
+  }
+  else {
+    m_ribManager.disableSnapshot();
+  }
+
   if (!wantPrefixPropagate && m_readvertisePropagation != nullptr) {
     NFD_LOG_DEBUG("Disabling automatic prefix propagation");
     m_readvertisePropagation.reset();
@@ -245,12 +341,18 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     m_readvertiseNlsr = make_unique<Readvertise>(
       m_rib,
       make_unique<ClientToNlsrReadvertisePolicy>(),
-      make_unique<NfdRibReadvertiseDestination>(m_nfdController, m_rib, options));
+      make_unique<NfdRibReadvertiseDestination>(m_face, m_keyChain, m_nfdController, m_rib, options));
   }
   else if (!wantReadvertiseNlsr && m_readvertiseNlsr != nullptr) {
     NFD_LOG_DEBUG("Disabling readvertise-to-nlsr");
     m_readvertiseNlsr.reset();
   }
+
+  for (auto* readvertise : {m_readvertisePropagation.get(), m_readvertiseNlsr.get()}) {
+    if (readvertise != nullptr) {
+      readvertise->setBatchLimits(readvertiseBatchSize, readvertiseRateLimit);
+    }
+  }
 }
 
 } // namespace rib
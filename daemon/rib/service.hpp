@@ -92,6 +92,20 @@ public:
     return m_ribManager;
   }
 
+  /**
+   * \brief Apply FIB updates directly through a FibManager running in the same process
+   *
+   * This bypasses signing and validation of FIB control commands for updates computed by
+   * this RIB service. Other controllers continue to use the FIB management protocol.
+   *
+   * \param fibManager FibManager on the main thread; it must outlive this Service
+   */
+  void
+  enableInProcessFibUpdates(FibManager& fibManager)
+  {
+    m_fibUpdater.setInProcessFibManager(&fibManager);
+  }
+
 private:
   template<typename ConfigParseFunc>
   Service(ndn::KeyChain& keyChain, shared_ptr<ndn::Transport> localNfdTransport,
@@ -86,6 +86,22 @@ public: // used by ContentStore implementation
   void
   updateFreshUntil();
 
+  /** \brief return when the entry would become non-fresh
+   */
+  time::steady_clock::TimePoint
+  getFreshUntil() const
+  {
+    return m_freshUntil;
+  }
+
+  /** \brief set when the entry would become non-fresh
+   */
+  void
+  setFreshUntil(time::steady_clock::TimePoint freshUntil)
+  {
+    m_freshUntil = freshUntil;
+  }
+
   /** \brief clear 'unsolicited' flag
    */
   void
@@ -75,6 +75,14 @@ LruPolicy::evictEntries()
   }
 }
 
+void
+LruPolicy::doVisitEntries(const std::function<void(EntryRef)>& visitor) const
+{
+  for (EntryRef i : m_queue) {
+    visitor(i);
+  }
+}
+
 void
 LruPolicy::insertToQueue(EntryRef i, bool isNewEntry)
 {
@@ -70,6 +70,9 @@ private:
   void
   evictEntries() override;
 
+  void
+  doVisitEntries(const std::function<void(EntryRef)>& visitor) const override;
+
 private:
   /** \brief moves an entry to the end of queue
    */
@@ -104,6 +104,16 @@ PriorityFifoPolicy::evictOne()
   this->emitSignal(beforeEvict, i);
 }
 
+void
+PriorityFifoPolicy::doVisitEntries(const std::function<void(EntryRef)>& visitor) const
+{
+  for (const Queue& queue : m_queues) {
+    for (EntryRef i : queue) {
+      visitor(i);
+    }
+  }
+}
+
 void
 PriorityFifoPolicy::attachQueue(EntryRef i)
 {
@@ -118,7 +128,7 @@ PriorityFifoPolicy::attachQueue(EntryRef i)
   }
   else {
     entryInfo->queueType = QUEUE_FIFO;
-    entryInfo->moveStaleEventId = getScheduler().schedule(i->getData().getFreshnessPeriod(),
+    entryInfo->moveStaleEventId = getScheduler().schedule(i->getFreshUntil() - time::steady_clock::now(),
                                                           [=] { moveToStaleQueue(i); });
   }
 
@@ -88,6 +88,9 @@ private:
   void
   evictEntries() override;
 
+  void
+  doVisitEntries(const std::function<void(EntryRef)>& visitor) const override;
+
 private:
   /** \brief evicts one entry
    *  \pre CS is not empty
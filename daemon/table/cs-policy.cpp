@@ -100,5 +100,20 @@ Policy::beforeUse(EntryRef i)
   this->doBeforeUse(i);
 }
 
+void
+Policy::visitEntries(const std::function<void(EntryRef)>& visitor) const
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  this->doVisitEntries(visitor);
+}
+
+void
+Policy::doVisitEntries(const std::function<void(EntryRef)>& visitor) const
+{
+  for (auto i = m_cs->begin(); i != m_cs->end(); ++i) {
+    visitor(i);
+  }
+}
+
 } // namespace cs
 } // namespace nfd
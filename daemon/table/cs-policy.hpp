@@ -146,6 +146,14 @@ public:
   void
   beforeUse(EntryRef i);
 
+  /** \brief invokes \p visitor on every entry, in the order the policy would evict them
+   *
+   *  Inserting the entries into an empty CS in this order approximately reproduces
+   *  the eviction order of this policy.
+   */
+  void
+  visitEntries(const std::function<void(EntryRef)>& visitor) const;
+
 protected:
   /** \brief invoked after a new entry is created in CS
    *
@@ -189,6 +197,14 @@ protected:
   virtual void
   evictEntries() = 0;
 
+  /** \brief invokes \p visitor on every entry, in eviction order
+   *
+   *  The default implementation visits entries in name order, which is appropriate
+   *  for a policy that has no inherent ordering.
+   */
+  virtual void
+  doVisitEntries(const std::function<void(EntryRef)>& visitor) const;
+
 protected:
   DECLARE_SIGNAL_EMIT(beforeEvict)
 
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-snapshot.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <cerrno>
+#include <cstdio> // for std::rename()
+#include <cstring> // for memcmp(), strerror()
+#include <fstream>
+
+namespace nfd {
+namespace cs {
+
+NFD_LOG_INIT(CsSnapshot);
+
+const char MAGIC[] = {'N', 'F', 'D', 'C', 'S', 0x00, 0x00, 0x01};
+
+const size_t CsSnapshot::DEFAULT_CHUNK_SIZE = 256;
+
+static std::string
+makeErrorMessage(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+CsSnapshot::CsSnapshot(Cs& cs, const std::string& filename, size_t chunkSize)
+  : m_cs(cs)
+  , m_filename(filename)
+  , m_chunkSize(chunkSize)
+{
+  BOOST_ASSERT(chunkSize > 0);
+}
+
+CsSnapshot::~CsSnapshot() = default;
+
+void
+CsSnapshot::load()
+{
+  auto input = make_unique<std::ifstream>(m_filename, std::ios::binary);
+  if (!*input) {
+    NDN_THROW(Error(makeErrorMessage("Cannot open " + m_filename)));
+  }
+
+  char magic[sizeof(MAGIC)];
+  if (!input->read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    NDN_THROW(Error(m_filename + " is not a CS snapshot"));
+  }
+
+  m_input = std::move(input);
+  m_nLoaded = 0;
+  m_loadEvent = getScheduler().schedule(0_ns, [this] { loadChunk(); });
+}
+
+void
+CsSnapshot::loadChunk()
+{
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+
+  for (size_t i = 0; i < m_chunkSize; ++i) {
+    if (m_input->peek() == std::istream::traits_type::eof()) {
+      finishLoading();
+      return;
+    }
+
+    Block record;
+    try {
+      record = Block::fromStream(*m_input);
+    }
+    catch (const tlv::Error&) {
+      NFD_LOG_WARN(m_filename << " is truncated");
+      finishLoading();
+      return;
+    }
+    if (record.type() != TLV_CS_SNAPSHOT_ENTRY) {
+      continue;
+    }
+
+    try {
+      record.parse();
+      auto data = make_shared<Data>(record.get(tlv::Data));
+
+      auto freshUntil = time::steady_clock::TimePoint::min();
+      auto freshUntilIt = record.find(TLV_CS_SNAPSHOT_FRESH_UNTIL);
+      if (freshUntilIt != record.elements_end()) {
+        auto ms = ndn::encoding::readNonNegativeInteger(*freshUntilIt);
+        auto freshUntilSystem = time::fromUnixTimestamp(time::milliseconds(ms));
+        if (freshUntilSystem > systemNow) {
+          freshUntil = steadyNow + time::duration_cast<time::steady_clock::Duration>(
+                                     freshUntilSystem - systemNow);
+        }
+      }
+      bool isUnsolicited = record.find(TLV_CS_SNAPSHOT_UNSOLICITED) != record.elements_end();
+
+      if (m_cs.insert(*data, isUnsolicited, freshUntil)) {
+        ++m_nLoaded;
+      }
+    }
+    catch (const tlv::Error& e) {
+      NFD_LOG_DEBUG("Skipping malformed record: " << e.what());
+    }
+  }
+
+  m_loadEvent = getScheduler().schedule(0_ns, [this] { loadChunk(); });
+}
+
+void
+CsSnapshot::finishLoading()
+{
+  NFD_LOG_INFO("Loaded " << m_nLoaded << " Data packets from " << m_filename);
+  m_input.reset();
+  m_loadEvent.cancel();
+}
+
+static void
+writeRecord(std::ostream& output, const Block& data,
+            time::system_clock::TimePoint freshUntil, bool isUnsolicited)
+{
+  ndn::EncodingBuffer encoder;
+  size_t len = 0;
+  if (isUnsolicited) {
+    len += ndn::encoding::prependEmptyBlock(encoder, TLV_CS_SNAPSHOT_UNSOLICITED);
+  }
+  if (freshUntil != time::system_clock::TimePoint::min()) {
+    auto ms = std::max<int64_t>(time::toUnixTimestamp(freshUntil).count(), 0);
+    len += ndn::encoding::prependNonNegativeIntegerBlock(encoder, TLV_CS_SNAPSHOT_FRESH_UNTIL, ms);
+  }
+  len += ndn::encoding::prependBlock(encoder, data);
+  len += encoder.prependVarNumber(len);
+  encoder.prependVarNumber(TLV_CS_SNAPSHOT_ENTRY);
+  output.write(reinterpret_cast<const char*>(encoder.buf()), encoder.size());
+}
+
+std::vector<CsSnapshot::Record>
+CsSnapshot::collectRecords() const
+{
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+
+  // Data::wireEncode() returns the cached encoding, so each record only shares its buffer
+  std::vector<Record> records;
+  records.reserve(m_cs.size());
+  m_cs.getPolicy()->visitEntries([&] (Policy::EntryRef i) {
+    auto freshUntil = time::system_clock::TimePoint::min();
+    if (i->isFresh()) {
+      freshUntil = systemNow + time::duration_cast<time::system_clock::Duration>(
+                                 i->getFreshUntil() - steadyNow);
+    }
+    records.push_back({i->getData().wireEncode(), freshUntil, i->isUnsolicited()});
+  });
+  return records;
+}
+
+unique_ptr<std::ofstream>
+CsSnapshot::openOutput() const
+{
+  std::string tmpFilename = m_filename + ".tmp";
+  auto output = make_unique<std::ofstream>(tmpFilename, std::ios::binary | std::ios::trunc);
+  if (!*output) {
+    NDN_THROW(Error(makeErrorMessage("Cannot open " + tmpFilename)));
+  }
+  output->write(MAGIC, sizeof(MAGIC));
+  return output;
+}
+
+void
+CsSnapshot::commitOutput(std::ofstream& output) const
+{
+  std::string tmpFilename = m_filename + ".tmp";
+  output.close();
+  if (!output) {
+    NDN_THROW(Error(makeErrorMessage("Cannot write " + tmpFilename)));
+  }
+
+  if (std::rename(tmpFilename.data(), m_filename.data()) != 0) {
+    NDN_THROW(Error(makeErrorMessage("Cannot rename " + tmpFilename + " to " + m_filename)));
+  }
+}
+
+void
+CsSnapshot::startSave()
+{
+  // an unfinished save would write to the same temporary file
+  finishSaving();
+
+  m_output = openOutput();
+  m_records = collectRecords();
+  m_nSaved = 0;
+  m_saveEvent = getScheduler().schedule(0_ns, [this] { saveChunk(); });
+}
+
+void
+CsSnapshot::saveChunk()
+{
+  size_t end = std::min(m_nSaved + m_chunkSize, m_records.size());
+  for (; m_nSaved < end; ++m_nSaved) {
+    const Record& record = m_records[m_nSaved];
+    writeRecord(*m_output, record.data, record.freshUntil, record.isUnsolicited);
+  }
+
+  if (m_nSaved < m_records.size()) {
+    m_saveEvent = getScheduler().schedule(0_ns, [this] { saveChunk(); });
+    return;
+  }
+
+  try {
+    commitOutput(*m_output);
+    NFD_LOG_DEBUG("Saved " << m_nSaved << " Data packets to " << m_filename);
+  }
+  catch (const Error& e) {
+    NFD_LOG_WARN("Cannot save CS snapshot: " << e.what());
+  }
+  finishSaving();
+}
+
+void
+CsSnapshot::finishSaving()
+{
+  m_output.reset();
+  std::vector<Record>().swap(m_records); // release the Data buffers
+  m_saveEvent.cancel();
+}
+
+size_t
+CsSnapshot::save()
+{
+  finishSaving();
+
+  auto output = openOutput();
+  auto records = collectRecords();
+  for (const Record& record : records) {
+    writeRecord(*output, record.data, record.freshUntil, record.isUnsolicited);
+  }
+  commitOutput(*output);
+  return records.size();
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
+#define NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
+
+#include "cs.hpp"
+
+#include <iosfwd>
+
+namespace nfd {
+namespace cs {
+
+/** \brief TLV-TYPE numbers of the CS snapshot encoding.
+ *  \sa CsSnapshot
+ */
+enum : uint32_t {
+  TLV_CS_SNAPSHOT_ENTRY       = 210,
+  TLV_CS_SNAPSHOT_FRESH_UNTIL = 211,
+  TLV_CS_SNAPSHOT_UNSOLICITED = 212,
+};
+
+/** \brief saves the Content Store to a file, and refills it from that file after a restart
+ *
+ *  A snapshot file is a sequence of records following an 8-octet header:
+ *  \code
+ *  Header = MAGIC (8 octets, "NFDCS" 0x00 0x00 0x01)
+ *
+ *  CsSnapshotEntry = CS-SNAPSHOT-ENTRY-TYPE TLV-LENGTH
+ *                      Data
+ *                      [FreshUntil]
+ *                      [Unsolicited]
+ *
+ *  FreshUntil = CS-SNAPSHOT-FRESH-UNTIL-TYPE TLV-LENGTH
+ *                 NonNegativeInteger ; milliseconds since the Unix epoch
+ *  Unsolicited = CS-SNAPSHOT-UNSOLICITED-TYPE TLV-LENGTH(=0)
+ *  \endcode
+ *
+ *  Records are written in the eviction order of the CS policy, so that inserting them in file
+ *  order retains the most valuable entries if the CS is smaller than the snapshot, and
+ *  approximately restores the eviction order otherwise. FreshUntil is present only if the
+ *  entry was fresh when the snapshot was taken; it is stored as wall-clock time, so that the
+ *  time spent while the daemon was not running is deducted when the snapshot is loaded.
+ *
+ *  The file is written to a temporary file and then renamed over the snapshot file, so that
+ *  a crash while saving leaves the previous snapshot intact. Loading, as well as saving with
+ *  startSave(), happens in the background, a bounded number of records per io_service turn,
+ *  so that forwarding is not held up. Loading stops at the first truncated record.
+ */
+class CsSnapshot : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  CsSnapshot(Cs& cs, const std::string& filename, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+  ~CsSnapshot();
+
+  const std::string&
+  getFilename() const
+  {
+    return m_filename;
+  }
+
+  /** \brief start inserting the Data in the snapshot file into the CS
+   *
+   *  The first chunk is inserted on the next io_service turn.
+   *
+   *  \throw Error the file cannot be opened, or is not a CS snapshot
+   */
+  void
+  load();
+
+  /** \brief whether load() is still in progress
+   */
+  bool
+  isLoading() const
+  {
+    return m_input != nullptr;
+  }
+
+  /** \brief number of Data packets inserted by load() so far
+   */
+  size_t
+  getNLoaded() const
+  {
+    return m_nLoaded;
+  }
+
+  /** \brief start writing the CS entries to the snapshot file
+   *
+   *  The set of entries and their freshness are taken when this function is called; the records
+   *  are written in the background, a chunk per io_service turn. Errors encountered after this
+   *  function returns are logged.
+   *
+   *  \throw Error the temporary file cannot be opened
+   */
+  void
+  startSave();
+
+  /** \brief whether startSave() is still in progress
+   */
+  bool
+  isSaving() const
+  {
+    return m_output != nullptr;
+  }
+
+  /** \brief write all CS entries to the snapshot file before returning
+   *
+   *  A save in progress from startSave() is abandoned.
+   *
+   *  \return number of Data packets written
+   *  \throw Error the file cannot be written
+   */
+  size_t
+  save();
+
+public:
+  /** \brief default number of records inserted or written per io_service turn
+   */
+  static const size_t DEFAULT_CHUNK_SIZE;
+
+private:
+  struct Record
+  {
+    Block data;
+    time::system_clock::TimePoint freshUntil; ///< TimePoint::min() if not fresh
+    bool isUnsolicited;
+  };
+
+  void
+  loadChunk();
+
+  void
+  finishLoading();
+
+  std::vector<Record>
+  collectRecords() const;
+
+  unique_ptr<std::ofstream>
+  openOutput() const;
+
+  void
+  commitOutput(std::ofstream& output) const;
+
+  void
+  saveChunk();
+
+  void
+  finishSaving();
+
+private:
+  Cs& m_cs;
+  std::string m_filename;
+  size_t m_chunkSize;
+
+  unique_ptr<std::istream> m_input;
+  size_t m_nLoaded = 0;
+  scheduler::ScopedEventId m_loadEvent;
+
+  unique_ptr<std::ofstream> m_output;
+  std::vector<Record> m_records;
+  size_t m_nSaved = 0;
+  scheduler::ScopedEventId m_saveEvent;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
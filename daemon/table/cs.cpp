@@ -49,9 +49,22 @@ Cs::Cs(size_t nMaxPackets)
 
 void
 Cs::insert(const Data& data, bool isUnsolicited)
+{
+  insertImpl(data, isUnsolicited, nullopt);
+}
+
+bool
+Cs::insert(const Data& data, bool isUnsolicited, time::steady_clock::TimePoint freshUntil)
+{
+  return insertImpl(data, isUnsolicited, freshUntil);
+}
+
+bool
+Cs::insertImpl(const Data& data, bool isUnsolicited,
+               optional<time::steady_clock::TimePoint> freshUntil)
 {
   if (!m_shouldAdmit || m_policy->getLimit() == 0) {
-    return;
+    return false;
   }
   NFD_LOG_DEBUG("insert " << data.getName());
 
@@ -60,7 +73,20 @@ Cs::insert(const Data& data, bool isUnsolicited)
   if (tag != nullptr) {
     lp::CachePolicyType policy = tag->get().getPolicy();
     if (policy == lp::CachePolicyType::NO_CACHE) {
-      return;
+      return false;
+    }
+  }
+
+  if (freshUntil) {
+    // Entries are keyed by full name, so a live Data with the same Name but different content
+    // is a different entry. It is newer than the restored Data, which must not be served
+    // instead of it. Entries with the same Name, if any, come first in the prefix range,
+    // because ImplicitSha256DigestComponent sorts before all other name component types.
+    const_iterator first, last;
+    std::tie(first, last) = findPrefixRange(data.getName());
+    if (first != last && first->getName() == data.getName()) {
+      NFD_LOG_DEBUG("skip restoring " << data.getName() << ": newer Data exists");
+      return false;
     }
   }
 
@@ -69,7 +95,13 @@ Cs::insert(const Data& data, bool isUnsolicited)
   std::tie(it, isNewEntry) = m_table.emplace(data.shared_from_this(), isUnsolicited);
   Entry& entry = const_cast<Entry&>(*it);
 
-  entry.updateFreshUntil();
+  if (freshUntil) {
+    BOOST_ASSERT(isNewEntry);
+    entry.setFreshUntil(*freshUntil);
+  }
+  else {
+    entry.updateFreshUntil();
+  }
 
   if (!isNewEntry) { // existing entry
     // XXX This doesn't forbid unsolicited Data from refreshing a solicited entry.
@@ -82,6 +114,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
   else {
     m_policy->afterInsert(it);
   }
+  return true;
 }
 
 std::pair<Cs::const_iterator, Cs::const_iterator>
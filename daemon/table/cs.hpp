@@ -52,6 +52,17 @@ public:
   void
   insert(const Data& data, bool isUnsolicited = false);
 
+  /** \brief inserts a Data packet with a known freshness deadline
+   *  \param freshUntil when the Data becomes non-fresh; it may be in the past
+   *
+   *  This is used to restore Data from a snapshot. Unlike the other overload, nothing is
+   *  inserted if there is an entry with the same Name, even if its content differs, because
+   *  that entry is newer than the snapshot.
+   *  \return whether \p data was inserted
+   */
+  bool
+  insert(const Data& data, bool isUnsolicited, time::steady_clock::TimePoint freshUntil);
+
   /** \brief asynchronously erases entries under \p prefix
    *  \tparam AfterEraseCallback `void f(size_t nErased)`
    *  \param prefix name prefix of entries
@@ -173,6 +184,9 @@ public: // enumeration
   }
 
 private:
+  bool
+  insertImpl(const Data& data, bool isUnsolicited, optional<time::steady_clock::TimePoint> freshUntil);
+
   std::pair<const_iterator, const_iterator>
   findPrefixRange(const Name& prefix) const;
 
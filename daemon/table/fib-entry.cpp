@@ -62,7 +62,8 @@ Entry::addOrUpdateNextHop(Face& face, uint64_t cost)
   it->setCost(cost);
   this->sortNextHops();
 
-  return std::make_pair(it, isNew);
+  // sorting may have moved the nexthop
+  return std::make_pair(this->findNextHop(face), isNew);
 }
 
 bool
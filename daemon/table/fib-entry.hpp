@@ -62,6 +62,11 @@ public:
     return m_prefix;
   }
 
+  /** \brief Get the nexthop list
+   *
+   *  The returned reference and iterators into the list are invalidated when a nexthop
+   *  of this entry is added, updated, or removed, and when the entry is erased.
+   */
   const NextHopList&
   getNextHops() const
   {
@@ -67,13 +67,52 @@ Fib::findLongestPrefixMatch(const Name& prefix) const
 const Entry&
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
-  return this->findLongestPrefixMatchImpl(pitEntry);
+  const name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+  if (nte->getName().size() < pitEntry.getName().size()) {
+    // PIT entry name either exceeds depth limit or ends with an implicit digest:
+    // a deeper FIB entry may exist, which the cache on nte cannot reflect
+    ++m_nCacheMisses;
+    return this->findLongestPrefixMatchImpl(pitEntry);
+  }
+  return this->findLongestPrefixMatchCached(*nte);
 }
 
 const Entry&
 Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 {
-  return this->findLongestPrefixMatchImpl(measurementsEntry);
+  const name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findLongestPrefixMatchCached(*nte);
+}
+
+const Entry&
+Fib::findLongestPrefixMatchCached(const name_tree::Entry& nte) const
+{
+  bool isHit = false;
+  const Entry& entry = this->lookupCache(nte, isHit);
+  ++(isHit ? m_nCacheHits : m_nCacheMisses);
+  return entry;
+}
+
+const Entry&
+Fib::lookupCache(const name_tree::Entry& nte, bool& isHit) const
+{
+  const Entry* entry = nte.getCachedFibEntry(m_generation);
+  if (entry != nullptr) {
+    isHit = true;
+    return *entry;
+  }
+
+  // Fill the cache from the parent, whose cache is shared by all its children,
+  // e.g., by all segments of an object
+  entry = nte.getFibEntry();
+  if (entry == nullptr) {
+    const name_tree::Entry* parent = nte.getParent();
+    entry = parent == nullptr ? s_emptyEntry.get() : &this->lookupCache(*parent, isHit);
+  }
+  nte.setCachedFibEntry(*entry, m_generation);
+  return *entry;
 }
 
 Entry*
@@ -97,6 +136,7 @@ Fib::insert(const Name& prefix)
 
   nte.setFibEntry(make_unique<Entry>(prefix));
   ++m_nItems;
+  ++m_generation;
   return {nte.getFibEntry(), true};
 }
 
@@ -110,6 +150,7 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
     m_nameTree.eraseIfEmpty(nte);
   }
   --m_nItems;
+  ++m_generation;
 }
 
 void
@@ -161,6 +202,21 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   }
 }
 
+optional<size_t>
+Fib::visitSlice(size_t cursor, size_t maxBuckets,
+                const std::function<bool(const Entry&)>& visitor) const
+{
+  size_t next = m_nameTree.visitBuckets(cursor, maxBuckets, [&] (const name_tree::Entry& nte) {
+    const Entry* entry = nte.getFibEntry();
+    return entry == nullptr || visitor(*entry);
+  });
+
+  if (next >= m_nameTree.getNBuckets()) {
+    return nullopt;
+  }
+  return next;
+}
+
 Fib::Range
 Fib::getRange() const
 {
@@ -81,6 +81,24 @@ public: // lookup
   Entry*
   findExactMatch(const Name& prefix);
 
+  /** \brief Number of lookups with a PIT or Measurements entry that were answered from
+   *         a FIB entry cached on its name tree entry or on one of the ancestors
+   */
+  uint64_t
+  getNCacheHits() const
+  {
+    return m_nCacheHits;
+  }
+
+  /** \brief Number of lookups with a PIT or Measurements entry that found no valid cached
+   *         FIB entry along the way, including lookups that cannot use the cache
+   */
+  uint64_t
+  getNCacheMisses() const
+  {
+    return m_nCacheMisses;
+  }
+
 public: // mutation
   /** \brief Maximum number of components in a FIB entry prefix.
    */
@@ -145,6 +163,18 @@ public: // enumeration
     return this->getRange().end();
   }
 
+  /** \brief Enumerate a slice of the FIB
+   *  \param cursor where to start: 0 for the beginning, or a value returned by a previous call
+   *  \param maxBuckets maximum number of name tree hashtable buckets to examine
+   *  \param visitor invoked for each FIB entry; return false to stop the enumeration
+   *  \return a cursor to resume the enumeration from, or nullopt if it has reached the end
+   *  \note Unlike begin() and end(), the table may be modified between two slices,
+   *        with the consistency guarantees described in NameTree::visitBuckets.
+   */
+  optional<size_t>
+  visitSlice(size_t cursor, size_t maxBuckets,
+             const std::function<bool(const Entry&)>& visitor) const;
+
 public: // signal
   /** \brief signals on Fib entry nexthop creation
    */
@@ -157,6 +187,18 @@ private:
   const Entry&
   findLongestPrefixMatchImpl(const K& key) const;
 
+  /** \brief Performs a longest prefix match for \p nte, using and updating the FIB entries
+   *         cached on \p nte and its ancestors
+   */
+  const Entry&
+  findLongestPrefixMatchCached(const name_tree::Entry& nte) const;
+
+  /** \brief Implements findLongestPrefixMatchCached
+   *  \param[out] isHit set to true if a valid cached FIB entry was found on the way
+   */
+  const Entry&
+  lookupCache(const name_tree::Entry& nte, bool& isHit) const;
+
   void
   erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
@@ -167,6 +209,14 @@ private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
 
+  /** \brief incremented whenever a FIB entry is inserted or erased;
+   *         invalidates all FIB entries cached on name tree entries
+   */
+  uint64_t m_generation = 1;
+
+  mutable uint64_t m_nCacheHits = 0;
+  mutable uint64_t m_nCacheMisses = 0;
+
   /** \brief The empty FIB entry.
    *
    *  This entry has no nexthops.
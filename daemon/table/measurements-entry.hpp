@@ -56,7 +56,6 @@ public:
 private:
   Name m_name;
   time::steady_clock::TimePoint m_expiry = time::steady_clock::TimePoint::min();
-  scheduler::EventId m_cleanup;
 
   name_tree::Entry* m_nameTreeEntry = nullptr;
 
@@ -29,9 +29,13 @@
 #include "fib-entry.hpp"
 #include "common/global.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 namespace measurements {
 
+constexpr size_t Measurements::SWEEP_BATCH_SIZE;
+
 Measurements::Measurements(NameTree& nameTree)
   : m_nameTree(nameTree)
 {
@@ -50,7 +54,7 @@ Measurements::get(name_tree::Entry& nte)
   entry = nte.getMeasurementsEntry();
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = getScheduler().schedule(getInitialLifetime(), [=] { cleanup(*entry); });
+  enqueueExpiry(*entry, entry->m_expiry);
 
   return *entry;
 }
@@ -134,9 +138,55 @@ Measurements::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
     return;
   }
 
-  entry.m_cleanup.cancel();
+  // the queued item fires no later than the old expiry time, and will be re-queued then
   entry.m_expiry = expiry;
-  entry.m_cleanup = getScheduler().schedule(lifetime, [&] { cleanup(entry); });
+}
+
+void
+Measurements::enqueueExpiry(Entry& entry, time::steady_clock::TimePoint expiry)
+{
+  m_expiryQueue.push_back({expiry, &entry});
+  std::push_heap(m_expiryQueue.begin(), m_expiryQueue.end(), std::greater<ExpiryQueueItem>());
+
+  if (expiry < m_nextSweep) {
+    m_nextSweep = expiry;
+    auto delay = std::max(expiry - time::steady_clock::now(), time::nanoseconds::zero());
+    m_sweepEvent = getScheduler().schedule(delay, [this] { sweep(); });
+  }
+}
+
+void
+Measurements::sweep()
+{
+  auto now = time::steady_clock::now();
+  m_nextSweep = time::steady_clock::TimePoint::max();
+
+  for (size_t i = 0; i < SWEEP_BATCH_SIZE; ++i) {
+    if (m_expiryQueue.empty() || m_expiryQueue.front().expiry > now) {
+      break;
+    }
+
+    std::pop_heap(m_expiryQueue.begin(), m_expiryQueue.end(), std::greater<ExpiryQueueItem>());
+    Entry& entry = *m_expiryQueue.back().entry;
+    m_expiryQueue.pop_back();
+
+    if (entry.m_expiry <= now) {
+      cleanup(entry);
+    }
+    else {
+      // lifetime was extended after the entry was queued
+      m_expiryQueue.push_back({entry.m_expiry, &entry});
+      std::push_heap(m_expiryQueue.begin(), m_expiryQueue.end(), std::greater<ExpiryQueueItem>());
+    }
+  }
+
+  if (!m_expiryQueue.empty()) {
+    // continue with the next batch, or wait for the earliest expiry
+    auto nextExpiry = m_expiryQueue.front().expiry;
+    m_nextSweep = nextExpiry;
+    auto delay = std::max(nextExpiry - now, time::nanoseconds::zero());
+    m_sweepEvent = getScheduler().schedule(delay, [this] { sweep(); });
+  }
 }
 
 void
@@ -141,6 +141,7 @@ public:
   /** \brief Extend lifetime of an entry
    *
    *  The entry will be kept until at least now()+lifetime.
+   *  This only updates the expiry time of the entry and does not interact with the scheduler.
    */
   void
   extendLifetime(Entry& entry, const time::nanoseconds& lifetime);
@@ -155,6 +156,19 @@ private:
   void
   cleanup(Entry& entry);
 
+  /** \brief Add \p entry to the expiry queue at time \p expiry
+   */
+  void
+  enqueueExpiry(Entry& entry, time::steady_clock::TimePoint expiry);
+
+  /** \brief Erase expired entries, at most SWEEP_BATCH_SIZE per invocation
+   *
+   *  A queued entry whose lifetime has been extended since it was queued is re-queued at its
+   *  current expiry time, instead of being erased.
+   */
+  void
+  sweep();
+
   Entry&
   get(name_tree::Entry& nte);
 
@@ -164,9 +178,34 @@ private:
   Entry*
   findLongestPrefixMatchImpl(const K& key, const EntryPredicate& pred) const;
 
+public:
+  /** \brief maximum number of expiry queue items processed by one sweep
+   */
+  static constexpr size_t SWEEP_BATCH_SIZE = 1024;
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+
+  struct ExpiryQueueItem
+  {
+    time::steady_clock::TimePoint expiry;
+    Entry* entry;
+
+    bool
+    operator>(const ExpiryQueueItem& other) const
+    {
+      return expiry > other.expiry;
+    }
+  };
+
+  /** \brief min-heap on expiry time, containing exactly one item for each entry
+   *
+   *  An item's expiry time is never later than the expiry time of its entry.
+   */
+  std::vector<ExpiryQueueItem> m_expiryQueue;
+  time::steady_clock::TimePoint m_nextSweep = time::steady_clock::TimePoint::max();
+  scheduler::ScopedEventId m_sweepEvent;
 };
 
 } // namespace measurements
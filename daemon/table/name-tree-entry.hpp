@@ -32,6 +32,11 @@
 #include "table/strategy-choice-entry.hpp"
 
 namespace nfd {
+
+namespace fw {
+class Strategy;
+} // namespace fw
+
 namespace name_tree {
 
 class Node;
@@ -151,6 +156,44 @@ public: // attached table entries
   void
   setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceEntry);
 
+public: // effective strategy cache
+  /** \brief Get the cached effective strategy
+   *  \param generation current generation of the Strategy Choice table
+   *  \return cached strategy, or nullptr if nothing was cached during \p generation
+   *  \note This cache is maintained by StrategyChoice.
+   */
+  fw::Strategy*
+  getCachedStrategy(uint64_t generation) const
+  {
+    return m_cachedStrategyGeneration == generation ? m_cachedStrategy : nullptr;
+  }
+
+  void
+  setCachedStrategy(fw::Strategy& strategy, uint64_t generation) const
+  {
+    m_cachedStrategy = &strategy;
+    m_cachedStrategyGeneration = generation;
+  }
+
+public: // FIB longest prefix match cache
+  /** \brief Get the cached FIB longest prefix match
+   *  \param generation current generation of the FIB
+   *  \return cached FIB entry, or nullptr if nothing was cached during \p generation
+   *  \note This cache is maintained by Fib.
+   */
+  const fib::Entry*
+  getCachedFibEntry(uint64_t generation) const
+  {
+    return m_cachedFibEntryGeneration == generation ? m_cachedFibEntry : nullptr;
+  }
+
+  void
+  setCachedFibEntry(const fib::Entry& fibEntry, uint64_t generation) const
+  {
+    m_cachedFibEntry = &fibEntry;
+    m_cachedFibEntryGeneration = generation;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    *  \note This function is for NameTree internal use. Other components
@@ -174,6 +217,11 @@ private:
   unique_ptr<measurements::Entry> m_measurementsEntry;
   unique_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  mutable fw::Strategy* m_cachedStrategy = nullptr;
+  mutable uint64_t m_cachedStrategyGeneration = 0;
+  mutable const fib::Entry* m_cachedFibEntry = nullptr;
+  mutable uint64_t m_cachedFibEntryGeneration = 0;
+
   friend Node* getNode(const Entry& entry);
 };
 
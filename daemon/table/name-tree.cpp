@@ -236,5 +236,25 @@ NameTree::partialEnumerate(const Name& prefix,
   return {Iterator(make_shared<PartialEnumerationImpl>(*this, entrySubTreeSelector), entry), end()};
 }
 
+size_t
+NameTree::visitBuckets(size_t firstBucket, size_t maxBuckets,
+                       const std::function<bool(const Entry&)>& visitor) const
+{
+  size_t nBuckets = m_ht.getNBuckets();
+  if (firstBucket >= nBuckets) {
+    return nBuckets;
+  }
+
+  size_t lastBucket = firstBucket + std::min(nBuckets - firstBucket, maxBuckets);
+  size_t bucket = firstBucket;
+  bool wantMore = true;
+  for (; wantMore && bucket < lastBucket; ++bucket) {
+    for (const Node* node = m_ht.getBucket(bucket); node != nullptr; node = node->next) {
+      wantMore = visitor(node->entry) && wantMore;
+    }
+  }
+  return bucket;
+}
+
 } // namespace name_tree
 } // namespace nfd
@@ -254,6 +254,24 @@ public: // enumeration
   partialEnumerate(const Name& prefix,
                    const EntrySubTreeSelector& entrySubTreeSelector = AnyEntrySubTree()) const;
 
+  /** \brief Visit all entries in a range of hashtable buckets
+   *  \param firstBucket index of the first bucket to visit
+   *  \param maxBuckets maximum number of buckets to visit
+   *  \param visitor invoked for every entry; if it returns false, the visit stops after the
+   *                 remaining entries of the current bucket have been visited
+   *  \return index of the first bucket that has not been visited; \c getNBuckets() means
+   *          the enumeration has reached the end
+   *
+   *  This allows a long enumeration to be split into slices of bounded cost, each resuming from
+   *  the bucket index returned by the previous slice.
+   *  \note Iteration order is implementation-defined.
+   *  \warning If a name tree entry is inserted or deleted between two slices, or the hashtable
+   *           is resized, later slices may skip entries or visit some entries twice.
+   */
+  size_t
+  visitBuckets(size_t firstBucket, size_t maxBuckets,
+               const std::function<bool(const Entry&)>& visitor) const;
+
   /** \return an iterator to the beginning
    *  \sa fullEnumerate
    */
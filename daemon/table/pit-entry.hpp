@@ -237,8 +237,10 @@ private:
   OutRecordCollection m_outRecords;
 
   name_tree::Entry* m_nameTreeEntry = nullptr;
+  uint32_t m_tokenSlot = 0; ///< index into the PIT token slab, assigned by Pit
 
   friend class name_tree::Entry;
+  friend class Pit;
 };
 
 } // namespace pit
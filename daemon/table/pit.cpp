@@ -28,6 +28,13 @@
 namespace nfd {
 namespace pit {
 
+/** \brief length of PIT tokens issued by Pit::getToken
+ *
+ *  A token consists of a 32-bit slot index followed by the 32-bit generation number of
+ *  the slot, both in network byte order.
+ */
+const size_t TOKEN_LENGTH = 2 * sizeof(uint32_t);
+
 static inline bool
 nteHasPitEntries(const name_tree::Entry& nte)
 {
@@ -79,17 +86,30 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   auto entry = make_shared<Entry>(interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
+
+  // assign a slot in the token slab
+  if (m_freeTokenSlots.empty()) {
+    entry->m_tokenSlot = static_cast<uint32_t>(m_tokenSlots.size());
+    m_tokenSlots.emplace_back();
+  }
+  else {
+    entry->m_tokenSlot = m_freeTokenSlots.back();
+    m_freeTokenSlots.pop_back();
+  }
+  m_tokenSlots[entry->m_tokenSlot].entry = entry;
+
   return {entry, true};
 }
 
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
-
   DataMatchResult matches;
-  for (const auto& nte : ntMatches) {
-    for (const auto& pitEntry : nte.getPitEntries()) {
+
+  // walk up the parent pointers from the longest match, without NameTree iterator allocation
+  const name_tree::Entry* nte = m_nameTree.findLongestPrefixMatch(data.getName(), &nteHasPitEntries);
+  for (; nte != nullptr; nte = nte->getParent()) {
+    for (const auto& pitEntry : nte->getPitEntries()) {
       if (pitEntry->getInterest().matchesData(data))
         matches.emplace_back(pitEntry);
     }
@@ -98,12 +118,78 @@ Pit::findAllDataMatches(const Data& data) const
   return matches;
 }
 
+shared_ptr<lp::PitToken>
+Pit::getToken(const Entry& entry)
+{
+  TokenSlot& slot = m_tokenSlots.at(entry.m_tokenSlot);
+  BOOST_ASSERT(slot.entry.get() == &entry);
+
+  if (slot.token == nullptr) {
+    ndn::Buffer buf(TOKEN_LENGTH);
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+      buf[i] = static_cast<uint8_t>(entry.m_tokenSlot >> (8 * (3 - i)));
+      buf[i + sizeof(uint32_t)] = static_cast<uint8_t>(slot.generation >> (8 * (3 - i)));
+    }
+    const ndn::Buffer& cbuf = buf;
+    slot.token = make_shared<lp::PitToken>(std::make_pair(cbuf.begin(), cbuf.end()));
+  }
+  return slot.token;
+}
+
+shared_ptr<Entry>
+Pit::findByToken(const lp::PitToken& token, const Data& data) const
+{
+  if (token.size() != TOKEN_LENGTH) {
+    return nullptr;
+  }
+
+  uint32_t index = 0;
+  uint32_t generation = 0;
+  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+    index = (index << 8) | token[i];
+    generation = (generation << 8) | token[i + sizeof(uint32_t)];
+  }
+
+  if (index >= m_tokenSlots.size()) {
+    return nullptr;
+  }
+  const TokenSlot& slot = m_tokenSlots[index];
+  if (slot.entry == nullptr || slot.generation != generation ||
+      !slot.entry->getInterest().matchesData(data)) {
+    return nullptr;
+  }
+
+  // the token identifies one entry, but the Data may satisfy others as well:
+  // same-name entries with different selectors, or CanBePrefix entries on ancestors
+  const name_tree::Entry* nte = m_nameTree.getEntry(*slot.entry);
+  BOOST_ASSERT(nte != nullptr);
+  if (nte->getName().size() != data.getName().size() || nte->getPitEntries().size() != 1) {
+    return nullptr;
+  }
+  for (nte = nte->getParent(); nte != nullptr; nte = nte->getParent()) {
+    for (const auto& pitEntry : nte->getPitEntries()) {
+      if (pitEntry->getInterest().matchesData(data)) {
+        return nullptr;
+      }
+    }
+  }
+  return slot.entry;
+}
+
 void
 Pit::erase(Entry* entry, bool canDeleteNte)
 {
   name_tree::Entry* nte = m_nameTree.getEntry(*entry);
   BOOST_ASSERT(nte != nullptr);
 
+  // release the token slot; bumping the generation invalidates tokens issued for this entry
+  TokenSlot& slot = m_tokenSlots.at(entry->m_tokenSlot);
+  BOOST_ASSERT(slot.entry.get() == entry);
+  ++slot.generation;
+  slot.token.reset();
+  m_freeTokenSlots.push_back(entry->m_tokenSlot);
+  auto entryRef = std::move(slot.entry); // keep entry alive until it's detached from NameTree
+
   nte->erasePitEntry(entry);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
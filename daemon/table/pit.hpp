@@ -29,6 +29,9 @@
 #include "pit-entry.hpp"
 #include "pit-iterator.hpp"
 
+#include <boost/container/small_vector.hpp>
+#include <ndn-cxx/lp/pit-token.hpp>
+
 namespace nfd {
 namespace pit {
 
@@ -39,8 +42,10 @@ namespace pit {
  *  - `iterator<shared_ptr<Entry>> begin()`
  *  - `iterator<shared_ptr<Entry>> end()`
  *  - `size_t size() const`
+ *
+ *  A single match, which is the common case, is stored without heap allocation.
  */
-using DataMatchResult = std::vector<shared_ptr<Entry>>;
+using DataMatchResult = boost::container::small_vector<shared_ptr<Entry>, 1>;
 
 /** \brief Represents the Interest Table
  */
@@ -85,6 +90,27 @@ public:
   DataMatchResult
   findAllDataMatches(const Data& data) const;
 
+  /** \brief Obtains the PIT token that identifies \p entry
+   *
+   *  The token is attached to Interests forwarded from \p entry, so that an upstream that
+   *  echoes it in the returned Data allows the entry to be found with findByToken().
+   *  The token encodes an index into a slab of entries and a generation number of the slot.
+   *  The returned object is shared by all Interests forwarded from the same entry.
+   */
+  shared_ptr<lp::PitToken>
+  getToken(const Entry& entry);
+
+  /** \brief Finds the PIT entry identified by a PIT token
+   *  \return the entry identified by \p token if it matches \p data and is the only entry that
+   *          findAllDataMatches() would return; otherwise nullptr, e.g., if the token was not
+   *          issued by getToken(), its entry has been deleted, or other entries may also be
+   *          satisfied by \p data, in which case the caller should use findAllDataMatches()
+   *  \note The lookup cost does not depend on the length of the Data name, except for a walk
+   *        over ancestor name tree entries that have PIT entries.
+   */
+  shared_ptr<Entry>
+  findByToken(const lp::PitToken& token, const Data& data) const;
+
   /** \brief Deletes an entry
    */
   void
@@ -136,6 +162,16 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+
+  struct TokenSlot
+  {
+    shared_ptr<Entry> entry;
+    uint32_t generation = 0;
+    shared_ptr<lp::PitToken> token; ///< created on first use
+  };
+
+  std::vector<TokenSlot> m_tokenSlots; ///< slab of entries, indexed by Entry::m_tokenSlot
+  std::vector<uint32_t> m_freeTokenSlots;
 };
 
 } // namespace pit
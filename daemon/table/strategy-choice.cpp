@@ -65,6 +65,7 @@ StrategyChoice::setDefaultStrategy(const Name& strategyName)
   name_tree::Entry& nte = m_nameTree.lookup(Name());
   nte.setStrategyChoiceEntry(std::move(entry));
   ++m_nItems;
+  ++m_generation;
 }
 
 StrategyChoice::InsertResult
@@ -111,6 +112,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(std::move(strategy));
+  ++m_generation;
   return InsertResult::OK;
 }
 
@@ -160,6 +162,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  ++m_generation;
 }
 
 std::pair<bool, Name>
@@ -196,13 +199,44 @@ StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
-  return this->findEffectiveStrategyImpl(pitEntry);
+  const name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+  if (nte->getName().size() < pitEntry.getName().size()) {
+    // PIT entry name either exceeds depth limit or ends with an implicit digest:
+    // a deeper StrategyChoice entry may exist, which the cache on nte cannot reflect
+    return this->findEffectiveStrategyImpl(pitEntry);
+  }
+  return this->findEffectiveStrategyCached(*nte);
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
 {
-  return this->findEffectiveStrategyImpl(measurementsEntry);
+  const name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findEffectiveStrategyCached(*nte);
+}
+
+Strategy&
+StrategyChoice::findEffectiveStrategyCached(const name_tree::Entry& nte) const
+{
+  Strategy* strategy = nte.getCachedStrategy(m_generation);
+  if (strategy != nullptr) {
+    return *strategy;
+  }
+
+  // Fill the cache from the parent, whose cache is shared by all its children,
+  // e.g., by all segments of an object. The root entry always has a StrategyChoice entry.
+  const strategy_choice::Entry* entry = nte.getStrategyChoiceEntry();
+  if (entry != nullptr) {
+    strategy = &entry->getStrategy();
+  }
+  else {
+    BOOST_ASSERT(nte.getParent() != nullptr);
+    strategy = &this->findEffectiveStrategyCached(*nte.getParent());
+  }
+  nte.setCachedStrategy(*strategy, m_generation);
+  return *strategy;
 }
 
 static inline void
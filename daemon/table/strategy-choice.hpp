@@ -139,14 +139,17 @@ public: // effective strategy
 
   /** \brief Get effective strategy for \p pitEntry
    *
-   *  This is equivalent to `findEffectiveStrategy(pitEntry.getName())`
+   *  This is equivalent to `findEffectiveStrategy(pitEntry.getName())`.
+   *  The result is cached on the name tree entry until the next change of this table,
+   *  so that repeated lookups do not probe the name tree.
    */
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
 
   /** \brief Get effective strategy for \p measurementsEntry
    *
-   *  This is equivalent to `findEffectiveStrategy(measurementsEntry.getName())`
+   *  This is equivalent to `findEffectiveStrategy(measurementsEntry.getName())`.
+   *  The result is cached in the same way as for a PIT entry.
    */
   fw::Strategy&
   findEffectiveStrategy(const measurements::Entry& measurementsEntry) const;
@@ -187,6 +190,11 @@ private:
   fw::Strategy&
   findEffectiveStrategyImpl(const K& key) const;
 
+  /** \brief Get effective strategy for \p nte, using and updating its cached strategy
+   */
+  fw::Strategy&
+  findEffectiveStrategyCached(const name_tree::Entry& nte) const;
+
   Range
   getRange() const;
 
@@ -194,6 +202,11 @@ private:
   Forwarder& m_forwarder;
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+
+  /** \brief incremented whenever the effective strategy of any name may have changed;
+   *         invalidates all strategies cached on name tree entries
+   */
+  uint64_t m_generation = 1;
 };
 
 std::ostream&
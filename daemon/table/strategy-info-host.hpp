@@ -28,9 +28,15 @@
 
 #include "fw/strategy-info.hpp"
 
+#include <algorithm>
+#include <array>
+
 namespace nfd {
 
 /** \brief Base class for an entity onto which StrategyInfo items may be placed
+ *
+ *  Most hosts carry zero, one, or two items. Up to two items are kept inline in the host;
+ *  further items are stored in a separately allocated vector. Lookup is a linear scan.
  */
 class StrategyInfoHost
 {
@@ -46,11 +52,7 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto it = m_items.find(T::getTypeId());
-    if (it == m_items.end()) {
-      return nullptr;
-    }
-    return static_cast<T*>(it->second.get());
+    return static_cast<T*>(findItem(T::getTypeId()));
   }
 
   /** \brief Insert a StrategyInfo item
@@ -65,12 +67,15 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto& item = m_items[T::getTypeId()];
-    bool isNew = item == nullptr;
-    if (isNew) {
-      item = make_unique<T>(std::forward<A>(args)...);
+    T* existing = getStrategyInfo<T>();
+    if (existing != nullptr) {
+      return {existing, false};
     }
-    return {static_cast<T*>(item.get()), isNew};
+
+    auto info = make_unique<T>(std::forward<A>(args)...);
+    T* item = info.get();
+    insertItem(T::getTypeId(), std::move(info));
+    return {item, true};
   }
 
   /** \brief Erase a StrategyInfo item
@@ -84,7 +89,7 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    return m_items.erase(T::getTypeId());
+    return eraseItem(T::getTypeId());
   }
 
   /** \brief Clear all StrategyInfo items
@@ -92,11 +97,76 @@ public:
   void
   clearStrategyInfo()
   {
-    m_items.clear();
+    for (auto& item : m_inlineItems) {
+      item.info.reset();
+    }
+    m_overflowItems.reset();
+  }
+
+private:
+  struct Item
+  {
+    int typeId = 0;
+    unique_ptr<fw::StrategyInfo> info; ///< nullptr indicates an unused slot
+  };
+
+  fw::StrategyInfo*
+  findItem(int typeId) const
+  {
+    for (const auto& item : m_inlineItems) {
+      if (item.info != nullptr && item.typeId == typeId) {
+        return item.info.get();
+      }
+    }
+    if (m_overflowItems != nullptr) {
+      for (const auto& item : *m_overflowItems) {
+        if (item.typeId == typeId) {
+          return item.info.get();
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  void
+  insertItem(int typeId, unique_ptr<fw::StrategyInfo> info)
+  {
+    for (auto& item : m_inlineItems) {
+      if (item.info == nullptr) {
+        item.typeId = typeId;
+        item.info = std::move(info);
+        return;
+      }
+    }
+    if (m_overflowItems == nullptr) {
+      m_overflowItems = make_unique<std::vector<Item>>();
+    }
+    m_overflowItems->push_back({typeId, std::move(info)});
+  }
+
+  size_t
+  eraseItem(int typeId)
+  {
+    for (auto& item : m_inlineItems) {
+      if (item.info != nullptr && item.typeId == typeId) {
+        item.info.reset();
+        return 1;
+      }
+    }
+    if (m_overflowItems != nullptr) {
+      auto it = std::find_if(m_overflowItems->begin(), m_overflowItems->end(),
+                             [typeId] (const Item& item) { return item.typeId == typeId; });
+      if (it != m_overflowItems->end()) {
+        m_overflowItems->erase(it);
+        return 1;
+      }
+    }
+    return 0;
   }
 
 private:
-  std::unordered_map<int, unique_ptr<fw::StrategyInfo>> m_items;
+  std::array<Item, 2> m_inlineItems;
+  unique_ptr<std::vector<Item>> m_overflowItems;
 };
 
 } // namespace nfd
@@ -153,6 +153,36 @@ BOOST_AUTO_TEST_CASE(McastNormal)
   BOOST_CHECK_EQUAL(this->countEtherMcastFaces(), netifs.size());
 }
 
+BOOST_AUTO_TEST_CASE(McastIoBackend)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        listen no
+        io_backend mmap
+        mcast yes
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  auto etherMcastFaces = this->listEtherMcastFaces();
+  BOOST_CHECK_EQUAL(etherMcastFaces.size(), netifs.size());
+#if defined(__linux__)
+  for (const auto* face : etherMcastFaces) {
+    auto transport = dynamic_cast<const EthernetTransport*>(face->getTransport());
+    BOOST_REQUIRE(transport != nullptr);
+    BOOST_CHECK(transport->getIoBackend() == EthernetTransport::IoBackend::MMAP);
+  }
+#endif
+}
+
 BOOST_AUTO_TEST_CASE(EnableDisableMcast)
 {
   const std::string CONFIG_WITH_MCAST = R"CONFIG(
@@ -366,6 +396,22 @@ BOOST_AUTO_TEST_CASE(BadIdleTimeout)
   BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadIoBackend)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        io_backend xdp
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadMcast)
 {
   const std::string CONFIG = R"CONFIG(
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/ethernet-ring.hpp"
+#include "face/ethernet-protocol.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <cstdlib> // for std::getenv()
+#include <cstring> // for memcpy()
+#include <limits>
+
+#include <arpa/inet.h> // for htons()
+#include <net/if.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+class EthernetRingFixture
+{
+protected:
+  /** \brief create a ring on \p ifname, or return nullptr if this is not permitted
+   */
+  static unique_ptr<EthernetRing>
+  makeRing(const std::string& ifname)
+  {
+    unsigned int ifindex = ::if_nametoindex(ifname.data());
+    if (ifindex == 0) {
+      return nullptr;
+    }
+    try {
+      return make_unique<EthernetRing>(static_cast<int>(ifindex));
+    }
+    catch (const EthernetRing::Error& e) {
+      BOOST_TEST_MESSAGE("cannot create EthernetRing on " << ifname << ": " << e.what());
+      return nullptr;
+    }
+  }
+
+  static std::vector<uint8_t>
+  makeFrame(uint32_t id)
+  {
+    Block payload = ndn::encoding::makeNonNegativeIntegerBlock(300, id);
+    std::vector<uint8_t> frame(ethernet::HDR_LEN + payload.size());
+    ether_header eh;
+    std::fill_n(eh.ether_dhost, ethernet::ADDR_LEN, 0xff);
+    std::fill_n(eh.ether_shost, ethernet::ADDR_LEN, 0x02);
+    eh.ether_type = htons(ethernet::ETHERTYPE_NDN);
+    std::memcpy(frame.data(), &eh, ethernet::HDR_LEN);
+    std::copy(payload.begin(), payload.end(), frame.begin() + ethernet::HDR_LEN);
+    return frame;
+  }
+
+  static uint32_t
+  parseFrame(const uint8_t* frame, size_t length)
+  {
+    BOOST_REQUIRE_GT(length, ethernet::HDR_LEN);
+    bool isOk = false;
+    Block payload;
+    std::tie(isOk, payload) = Block::fromBuffer(frame + ethernet::HDR_LEN, length - ethernet::HDR_LEN);
+    BOOST_REQUIRE(isOk);
+    return ndn::encoding::readNonNegativeIntegerAs<uint32_t>(payload);
+  }
+
+  static void
+  send(EthernetRing& ring, uint32_t firstId, uint32_t lastId)
+  {
+    for (uint32_t id = firstId; id <= lastId; ++id) {
+      auto frame = makeFrame(id);
+      BOOST_REQUIRE(ring.enqueueFrame(frame.data(), frame.size()));
+    }
+    ring.flush();
+  }
+
+  /** \brief receive frames from \p ring until \p ids has \p nExpected elements or 1 second elapsed
+   *  \param nMaxPerCall stop each receiveFrames() call after this many frames
+   */
+  static void
+  receive(EthernetRing& ring, std::vector<uint32_t>& ids, size_t nExpected,
+          size_t nMaxPerCall = std::numeric_limits<size_t>::max())
+  {
+    int fd = ring.getFd();
+    for (int i = 0; i < 100 && ids.size() < nExpected; ++i) {
+      pollfd pfd{fd, POLLIN, 0};
+      ::poll(&pfd, 1, 10);
+
+      size_t nThisCall = 0;
+      ring.receiveFrames([&] (const uint8_t* frame, size_t length) {
+        ids.push_back(parseFrame(frame, length));
+        return ++nThisCall < nMaxPerCall;
+      });
+    }
+    ::close(fd);
+  }
+};
+
+#define SKIP_IF_NO_RING(ring) \
+  do { \
+    if ((ring) == nullptr) { \
+      BOOST_WARN_MESSAGE(false, "skipping test case that requires PACKET_MMAP rings"); \
+      return; \
+    } \
+  } while (false)
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestEthernetRing, EthernetRingFixture)
+
+BOOST_AUTO_TEST_CASE(StopAndResume)
+{
+  // frames sent on the loopback interface are received by packet sockets bound to it
+  auto ring = makeRing("lo");
+  SKIP_IF_NO_RING(ring);
+
+  send(*ring, 1, 5);
+
+  // frames left in the current block after an early stop are delivered by the next call
+  std::vector<uint32_t> ids;
+  receive(*ring, ids, 5, 2);
+  std::vector<uint32_t> expected{1, 2, 3, 4, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(ring->getNPendingFrames(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(VethPair)
+{
+  // NFD_TEST_VETH_PAIR names the two ends of a veth pair, e.g., created with
+  // `ip link add nfdtest0 type veth peer name nfdtest1`, both ends must be up
+  const char* pair = std::getenv("NFD_TEST_VETH_PAIR");
+  std::string names = pair != nullptr ? pair : "";
+  auto comma = names.find(',');
+  if (comma == std::string::npos) {
+    BOOST_WARN_MESSAGE(false, "skipping test case that requires NFD_TEST_VETH_PAIR=<ifname>,<ifname>");
+    return;
+  }
+  auto txRing = makeRing(names.substr(0, comma));
+  auto rxRing = makeRing(names.substr(comma + 1));
+  SKIP_IF_NO_RING(txRing);
+  SKIP_IF_NO_RING(rxRing);
+
+  const uint32_t N_FRAMES = 2000;
+  const uint32_t BATCH = 100;
+  std::vector<uint32_t> ids;
+  for (uint32_t id = 1; id <= N_FRAMES; id += BATCH) {
+    send(*txRing, id, id + BATCH - 1);
+    receive(*rxRing, ids, id + BATCH - 1);
+  }
+
+  BOOST_REQUIRE_EQUAL(ids.size(), N_FRAMES);
+  for (uint32_t i = 0; i < N_FRAMES; ++i) {
+    BOOST_CHECK_EQUAL(ids[i], i + 1);
+  }
+  BOOST_CHECK_EQUAL(rxRing->getNDropped(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEthernetRing
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
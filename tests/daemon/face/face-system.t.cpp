@@ -24,7 +24,9 @@
  */
 
 #include "face/face-system.hpp"
+#include "face/generic-link-service.hpp"
 #include "face-system-fixture.hpp"
+#include "dummy-transport.hpp"
 
 #include "tests/test-common.hpp"
 
@@ -159,6 +161,53 @@ BOOST_AUTO_TEST_CASE(ChangeProvidedSchemes)
   BOOST_CHECK_EQUAL(faceSystem.getFactoryByScheme("s3"), f1);
 }
 
+BOOST_AUTO_TEST_CASE(PitToken)
+{
+  auto getAllowPitToken = [] (const Face& face) {
+    return static_cast<const GenericLinkService*>(face.getLinkService())->getOptions().allowPitToken;
+  };
+
+  auto face1 = make_shared<Face>(make_unique<GenericLinkService>(), make_unique<DummyTransport>());
+  faceTable.add(face1);
+  BOOST_CHECK_EQUAL(getAllowPitToken(*face1), false);
+
+  const std::string CONFIG_YES = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        enable_pit_token yes
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG_YES, true);
+  BOOST_CHECK_EQUAL(getAllowPitToken(*face1), false);
+
+  // existing faces are updated
+  parseConfig(CONFIG_YES, false);
+  BOOST_CHECK_EQUAL(getAllowPitToken(*face1), true);
+
+  // new faces get the configured option
+  auto face2 = make_shared<Face>(make_unique<GenericLinkService>(), make_unique<DummyTransport>());
+  faceTable.add(face2);
+  BOOST_CHECK_EQUAL(getAllowPitToken(*face2), true);
+
+  const std::string CONFIG_NO = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        enable_pit_token no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG_NO, false);
+  BOOST_CHECK_EQUAL(getAllowPitToken(*face1), false);
+  BOOST_CHECK_EQUAL(getAllowPitToken(*face2), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestFaceSystem
@@ -71,8 +71,13 @@ BOOST_AUTO_TEST_CASE(StaticProperties)
   BOOST_CHECK_EQUAL(face->getPersistency(), ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
   BOOST_CHECK_EQUAL(face->getLinkType(), ndn::nfd::LINK_TYPE_POINT_TO_POINT);
 
+  BOOST_REQUIRE(face->getIncomingFaceIdTag() != nullptr);
+  BOOST_CHECK_EQUAL(*face->getIncomingFaceIdTag(), INVALID_FACEID);
+
   face->setId(222);
   BOOST_CHECK_EQUAL(face->getId(), 222);
+  BOOST_REQUIRE(face->getIncomingFaceIdTag() != nullptr);
+  BOOST_CHECK_EQUAL(*face->getIncomingFaceIdTag(), 222);
 
   face->setPersistency(ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
   BOOST_CHECK_EQUAL(face->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
@@ -118,6 +118,29 @@ BOOST_AUTO_TEST_CASE(SendQueueLength)
   BOOST_CHECK_EQUAL(transport->getSendQueueLength(), QUEUE_UNSUPPORTED);
 }
 
+BOOST_AUTO_TEST_CASE(MmapBackend)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+  initializeMulticast(ndn::nfd::LINK_TYPE_MULTI_ACCESS, {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e},
+                      EthernetTransport::IoBackend::MMAP);
+
+  checkStaticPropertiesInitialized(*transport);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+#if defined(__linux__)
+  BOOST_CHECK(transport->getIoBackend() == EthernetTransport::IoBackend::MMAP);
+#else
+  BOOST_CHECK(transport->getIoBackend() == EthernetTransport::IoBackend::PCAP);
+#endif
+
+  // frames are enqueued in the TX ring and flushed at the end of the io_service turn
+  Block pkt = ndn::encoding::makeStringBlock(300, "hello");
+  transport->send(pkt);
+  transport->send(pkt);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 2);
+  limitedIo.defer(10_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestMulticastEthernetTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shm-client.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+#if defined(__linux__)
+
+// how long to wait for NFD to answer the request
+const int RESPONSE_TIMEOUT_MS = 5000;
+
+static std::string
+makeErrorMessage(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+ShmClient::ShmClient(int socketFd, size_t ringCapacity)
+{
+  Block request(shm_tlv::Request);
+  request.push_back(ndn::encoding::makeNonNegativeIntegerBlock(shm_tlv::RingCapacity, ringCapacity));
+  request.encode();
+  ssize_t nSent = ::send(socketFd, request.wire(), request.size(), MSG_NOSIGNAL);
+  if (nSent != static_cast<ssize_t>(request.size())) {
+    NDN_THROW(Error(makeErrorMessage("Cannot send shared memory request")));
+  }
+
+  // the file descriptors are attached to the first octet of the response
+  uint8_t buf[64];
+  size_t bufSize = 0;
+  int fds[3] = {-1, -1, -1};
+  auto closeFds = [&fds] {
+    for (int fd : fds) {
+      if (fd >= 0)
+        ::close(fd);
+    }
+  };
+
+  Block response;
+  bool isOk = false;
+  while (!isOk) {
+    pollfd pfd{socketFd, POLLIN, 0};
+    if (::poll(&pfd, 1, RESPONSE_TIMEOUT_MS) <= 0) {
+      closeFds();
+      NDN_THROW(Error("No shared memory response from NFD"));
+    }
+
+    iovec iov{buf + bufSize, sizeof(buf) - bufSize};
+    union {
+      char buf[CMSG_SPACE(sizeof(fds))];
+      cmsghdr align;
+    } control;
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    ssize_t nRead = ::recvmsg(socketFd, &msg, MSG_CMSG_CLOEXEC);
+    if (nRead <= 0) {
+      closeFds();
+      NDN_THROW(Error(nRead < 0 ? makeErrorMessage("Cannot receive shared memory response") :
+                                  "Connection closed by NFD"));
+    }
+    bufSize += static_cast<size_t>(nRead);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+        cmsg->cmsg_len == CMSG_LEN(sizeof(fds))) {
+      std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    }
+
+    std::tie(isOk, response) = Block::fromBuffer(buf, bufSize);
+    if (!isOk && bufSize == sizeof(buf)) {
+      break;
+    }
+  }
+
+  size_t capacity = 0;
+  try {
+    if (!isOk || response.type() != shm_tlv::Response) {
+      NDN_THROW(Error("Unexpected shared memory response from NFD"));
+    }
+    response.parse();
+    capacity = ndn::encoding::readNonNegativeInteger(response.get(shm_tlv::RingCapacity));
+  }
+  catch (const tlv::Error& e) {
+    closeFds();
+    NDN_THROW_NESTED(Error("Malformed shared memory response from NFD: "s + e.what()));
+  }
+  catch (const Error&) {
+    closeFds();
+    throw;
+  }
+  if (fds[0] < 0 || capacity != ShmRing::adjustCapacity(capacity)) {
+    closeFds();
+    NDN_THROW(Error("Invalid shared memory response from NFD"));
+  }
+
+  size_t ringRegionSize = ShmRing::computeRegionSize(capacity);
+  void* region = ::mmap(nullptr, 2 * ringRegionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+  ::close(fds[0]);
+  if (region == MAP_FAILED) {
+    fds[0] = -1;
+    closeFds();
+    NDN_THROW(Error(makeErrorMessage("Cannot map shared memory")));
+  }
+  m_region = static_cast<uint8_t*>(region);
+  m_regionSize = 2 * ringRegionSize;
+  m_txDoorbell = fds[1];
+  m_rxDoorbell = fds[2];
+
+  try {
+    // NFD has initialized the rings: the first one carries packets towards NFD
+    m_txRing = make_unique<ShmRing>(m_region, capacity, false);
+    m_rxRing = make_unique<ShmRing>(m_region + ringRegionSize, capacity, false);
+  }
+  catch (const ShmRing::Error& e) {
+    release();
+    NDN_THROW_NESTED(Error("Invalid shared memory rings: "s + e.what()));
+  }
+}
+
+ShmClient::~ShmClient()
+{
+  release();
+}
+
+void
+ShmClient::release()
+{
+  m_txRing.reset();
+  m_rxRing.reset();
+  if (m_region != nullptr) {
+    ::munmap(m_region, m_regionSize);
+    m_region = nullptr;
+  }
+  if (m_txDoorbell >= 0) {
+    ::close(m_txDoorbell);
+    m_txDoorbell = -1;
+  }
+  if (m_rxDoorbell >= 0) {
+    ::close(m_rxDoorbell);
+    m_rxDoorbell = -1;
+  }
+}
+
+bool
+ShmClient::send(const Block& packet)
+{
+  try {
+    if (!m_txRing->push(packet.wire(), packet.size())) {
+      return false;
+    }
+  }
+  catch (const ShmRing::Error& e) {
+    NDN_THROW_NESTED(Error("Shared memory ring is corrupted: "s + e.what()));
+  }
+
+  if (m_txRing->needsWakeup()) {
+    uint64_t one = 1;
+    if (::write(m_txDoorbell, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+      NDN_THROW(Error(makeErrorMessage("Cannot wake up NFD")));
+    }
+  }
+  return true;
+}
+
+size_t
+ShmClient::receive(const PacketCallback& onPacket, size_t maxPackets)
+{
+  try {
+    return m_rxRing->consume([&] (const uint8_t* record, size_t length) {
+      // Block::fromBuffer copies the record out of shared memory
+      bool isOk = false;
+      Block packet;
+      std::tie(isOk, packet) = Block::fromBuffer(record, length);
+      if (isOk && packet.size() == length) {
+        onPacket(packet);
+      }
+    }, maxPackets);
+  }
+  catch (const ShmRing::Error& e) {
+    NDN_THROW_NESTED(Error("Shared memory ring is corrupted: "s + e.what()));
+  }
+}
+
+bool
+ShmClient::wait(time::milliseconds timeout)
+{
+  if (!m_rxRing->prepareToWait()) {
+    return true;
+  }
+
+  pollfd pfd{m_rxDoorbell, POLLIN, 0};
+  int ret = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+  if (ret > 0) {
+    // reset the eventfd counter, the value itself is irrelevant
+    uint64_t value = 0;
+    ssize_t nRead = ::read(m_rxDoorbell, &value, sizeof(value));
+    BOOST_UNUSED(nRead);
+  }
+  m_rxRing->endWait();
+  return ret > 0;
+}
+
+#else // __linux__
+
+ShmClient::ShmClient(int, size_t)
+{
+  NDN_THROW(Error("Shared memory faces are not supported on this platform"));
+}
+
+ShmClient::~ShmClient() = default;
+
+void
+ShmClient::release()
+{
+}
+
+bool
+ShmClient::send(const Block&)
+{
+  return false;
+}
+
+size_t
+ShmClient::receive(const PacketCallback&, size_t)
+{
+  return 0;
+}
+
+bool
+ShmClient::wait(time::milliseconds)
+{
+  return false;
+}
+
+#endif // __linux__
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
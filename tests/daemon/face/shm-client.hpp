@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_TESTS_DAEMON_FACE_SHM_CLIENT_HPP
+#define NFD_TESTS_DAEMON_FACE_SHM_CLIENT_HPP
+
+#include "face/shm-ring.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+/**
+ * @brief Application side of the shared-memory data path of a Unix stream face.
+ *
+ * The constructor performs the negotiation described in UnixStreamTransport on a connected
+ * Unix stream socket, and maps the rings that NFD allocated. Afterwards, packets are sent and
+ * received through the rings; the socket must be kept open for as long as the rings are used,
+ * and must not be used for anything else.
+ *
+ * All operations are blocking or non-blocking system calls on the calling thread, so that this
+ * class can be used by an application regardless of its event loop. It also serves as the
+ * reference for implementing the same protocol in a client library.
+ *
+ * @note This class is only functional on Linux. On other platforms the constructor throws.
+ */
+class ShmClient : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Invoked for each packet received from NFD
+   */
+  using PacketCallback = std::function<void(const Block& packet)>;
+
+  /**
+   * @brief Negotiate shared-memory rings on @p socketFd.
+   * @param socketFd a connected Unix stream socket to NFD, on which nothing has been sent yet;
+   *                 the caller retains ownership
+   * @param ringCapacity requested capacity of each ring, NFD may adjust it
+   * @throw Error the negotiation failed, e.g., NFD does not support shared memory
+   */
+  explicit
+  ShmClient(int socketFd, size_t ringCapacity = ShmRing::MIN_CAPACITY);
+
+  ~ShmClient();
+
+  size_t
+  getRingCapacity() const
+  {
+    return m_txRing->getCapacity();
+  }
+
+  /**
+   * @brief File descriptor that becomes readable when NFD rings the doorbell,
+   *        for use with poll(2) or an event loop.
+   */
+  int
+  getRxDoorbell() const
+  {
+    return m_rxDoorbell;
+  }
+
+  /**
+   * @brief Append a packet to the application-to-NFD ring, and wake up NFD if necessary.
+   * @return false if the ring is full; the packet should be sent again later
+   * @throw Error the ring is corrupted
+   */
+  bool
+  send(const Block& packet);
+
+  /**
+   * @brief Consume up to @p maxPackets packets from the NFD-to-application ring, without blocking.
+   * @return number of packets passed to @p onPacket
+   * @throw Error the ring is corrupted
+   */
+  size_t
+  receive(const PacketCallback& onPacket, size_t maxPackets);
+
+  /**
+   * @brief Wait until NFD has sent packets, or until @p timeout has elapsed.
+   * @return false if the wait timed out
+   */
+  bool
+  wait(time::milliseconds timeout);
+
+private:
+  void
+  release();
+
+private:
+  uint8_t* m_region = nullptr;
+  size_t m_regionSize = 0;
+  unique_ptr<ShmRing> m_txRing;
+  unique_ptr<ShmRing> m_rxRing;
+  int m_txDoorbell = -1;
+  int m_rxDoorbell = -1;
+};
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_TESTS_DAEMON_FACE_SHM_CLIENT_HPP
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/shm-ring.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <cstring>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+class ShmRingFixture
+{
+protected:
+  ShmRingFixture()
+    : capacity(ShmRing::MIN_CAPACITY)
+    , region(ShmRing::computeRegionSize(capacity) + 64)
+    , alignedRegion(reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(region.data()) + 63) & ~uintptr_t(63)))
+    , producer(alignedRegion, capacity, true)
+    , consumer(alignedRegion, capacity, false)
+  {
+  }
+
+  std::vector<std::vector<uint8_t>>
+  consumeAll(size_t maxRecords = std::numeric_limits<size_t>::max())
+  {
+    std::vector<std::vector<uint8_t>> records;
+    consumer.consume([&] (const uint8_t* rec, size_t len) { records.emplace_back(rec, rec + len); },
+                     maxRecords);
+    return records;
+  }
+
+protected:
+  size_t capacity;
+  std::vector<uint8_t> region;
+  uint8_t* alignedRegion;
+  ShmRing producer;
+  ShmRing consumer;
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestShmRing, ShmRingFixture)
+
+BOOST_AUTO_TEST_CASE(AdjustCapacity)
+{
+  BOOST_CHECK_EQUAL(ShmRing::adjustCapacity(0), ShmRing::MIN_CAPACITY);
+  BOOST_CHECK_EQUAL(ShmRing::adjustCapacity(ShmRing::MIN_CAPACITY + 1), 2 * ShmRing::MIN_CAPACITY);
+  BOOST_CHECK_EQUAL(ShmRing::adjustCapacity(1 << 20), 1 << 20);
+  BOOST_CHECK_EQUAL(ShmRing::adjustCapacity(std::numeric_limits<size_t>::max()), ShmRing::MAX_CAPACITY);
+}
+
+BOOST_AUTO_TEST_CASE(Attach)
+{
+  BOOST_CHECK_THROW(ShmRing(alignedRegion, 2 * capacity, false), ShmRing::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PushConsume)
+{
+  const std::vector<uint8_t> rec1{0x05, 0x01, 0xAA};
+  const std::vector<uint8_t> rec2(1000, 0x42);
+  BOOST_CHECK(producer.push(rec1.data(), rec1.size()));
+  BOOST_CHECK(producer.push(rec2.data(), rec2.size()));
+  BOOST_CHECK_EQUAL(producer.getUsedBytes(), 8 + 1008);
+
+  auto records = consumeAll(1);
+  BOOST_REQUIRE_EQUAL(records.size(), 1);
+  BOOST_CHECK(records[0] == rec1);
+
+  records = consumeAll();
+  BOOST_REQUIRE_EQUAL(records.size(), 1);
+  BOOST_CHECK(records[0] == rec2);
+  BOOST_CHECK_EQUAL(producer.getUsedBytes(), 0);
+  BOOST_CHECK_EQUAL(consumeAll().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FullAndWrap)
+{
+  const std::vector<uint8_t> rec(ndn::MAX_NDN_PACKET_SIZE, 0x33);
+  BOOST_CHECK_EQUAL(producer.push(rec.data(), rec.size() + 1), false);
+
+  size_t nPushed = 0;
+  while (producer.push(rec.data(), rec.size())) {
+    ++nPushed;
+  }
+  BOOST_CHECK_EQUAL(nPushed, capacity / (rec.size() + 8));
+
+  // free one record, then the next push must wrap around the end of the buffer
+  BOOST_CHECK_EQUAL(consumeAll(1).size(), 1);
+  BOOST_CHECK(producer.push(rec.data(), rec.size()));
+  BOOST_CHECK_EQUAL(producer.push(rec.data(), rec.size()), false);
+
+  auto records = consumeAll();
+  BOOST_CHECK_EQUAL(records.size(), nPushed);
+  for (const auto& r : records) {
+    BOOST_CHECK(r == rec);
+  }
+  BOOST_CHECK_EQUAL(producer.getUsedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Wakeup)
+{
+  const uint8_t rec[] = {0x06, 0x00};
+
+  // consumer is not waiting
+  BOOST_CHECK(producer.push(rec, sizeof(rec)));
+  BOOST_CHECK_EQUAL(producer.needsWakeup(), false);
+
+  // ring is not empty, consumer must not sleep
+  BOOST_CHECK_EQUAL(consumer.prepareToWait(), false);
+  BOOST_CHECK_EQUAL(producer.needsWakeup(), false);
+  BOOST_CHECK_EQUAL(consumeAll().size(), 1);
+
+  // only the first push after the consumer went to sleep needs a wakeup
+  BOOST_CHECK_EQUAL(consumer.prepareToWait(), true);
+  BOOST_CHECK(producer.push(rec, sizeof(rec)));
+  BOOST_CHECK_EQUAL(producer.needsWakeup(), true);
+  BOOST_CHECK(producer.push(rec, sizeof(rec)));
+  BOOST_CHECK_EQUAL(producer.needsWakeup(), false);
+  consumer.endWait();
+  BOOST_CHECK_EQUAL(consumeAll().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Corrupted)
+{
+  const uint8_t rec[] = {0x06, 0x00};
+  BOOST_CHECK(producer.push(rec, sizeof(rec)));
+
+  // overwrite the record length with a value that exceeds the producer index
+  uint8_t* data = alignedRegion + ShmRing::computeRegionSize(capacity) - capacity;
+  uint32_t badLength = 1000;
+  std::memcpy(data, &badLength, sizeof(badLength));
+  BOOST_CHECK_THROW(consumeAll(), ShmRing::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmRing
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/socket-utils.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+namespace ip = boost::asio::ip;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestSocketUtils, GlobalIoFixture)
+
+#if defined(__linux__)
+BOOST_AUTO_TEST_CASE(NdnDatagramFilter)
+{
+  ip::udp::socket rx(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket tx(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  BOOST_REQUIRE(attachNdnDatagramFilter(rx.native_handle()));
+  ssize_t nDroppedBefore = getSocketDropCount(rx.native_handle());
+  BOOST_REQUIRE_GE(nDroppedBefore, 0);
+
+  auto interest = makeInterest("/A")->wireEncode();
+  std::vector<uint8_t> longLength{0x06, 0xFD, 0x01, 0x00, 0x07, 0x00};
+  std::vector<uint8_t> truncated(interest.begin(), interest.end() - 1);
+  std::vector<uint8_t> trailing(interest.begin(), interest.end());
+  trailing.push_back(0x00);
+  std::vector<uint8_t> wrongType(interest.begin(), interest.end());
+  wrongType[0] = 0x07;
+  std::vector<uint8_t> http{'G', 'E', 'T', ' ', '/'};
+
+  for (const auto& junk : {longLength, truncated, trailing, wrongType, http}) {
+    tx.send_to(boost::asio::buffer(junk), rx.local_endpoint());
+  }
+  tx.send_to(boost::asio::buffer(interest.wire(), interest.size()), rx.local_endpoint());
+
+  std::vector<uint8_t> buf(ndn::MAX_NDN_PACKET_SIZE);
+  size_t nReceived = rx.receive(boost::asio::buffer(buf));
+  BOOST_CHECK_EQUAL_COLLECTIONS(buf.begin(), buf.begin() + nReceived, interest.begin(), interest.end());
+  BOOST_CHECK_EQUAL(rx.available(), 0);
+  BOOST_CHECK_EQUAL(getSocketDropCount(rx.native_handle()) - nDroppedBefore, 5);
+}
+#endif // __linux__
+
+BOOST_AUTO_TEST_SUITE_END() // TestSocketUtils
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
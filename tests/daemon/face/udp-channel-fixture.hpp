@@ -44,7 +44,8 @@ protected:
     if (port == 0)
       port = getNextPort();
 
-    return make_unique<UdpChannel>(udp::Endpoint(addr, port), 2_s, false);
+    return make_unique<UdpChannel>(udp::Endpoint(addr, port), 2_s, false,
+                                   nListenSockets, wantConnectedFaces);
   }
 
   void
@@ -65,6 +66,8 @@ protected:
 
 protected:
   std::vector<shared_ptr<Face>> clientFaces;
+  size_t nListenSockets = 1;
+  bool wantConnectedFaces = true;
 };
 
 } // namespace tests
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "udp-channel-fixture.hpp"
+
+#include "face/shared-udp-transport.hpp"
+#include "face/unicast-udp-transport.hpp"
+
+#include "test-ip.hpp"
+#include <boost/mpl/vector.hpp>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestUdpChannel, UdpChannelFixture)
+
+using AddressFamilies = boost::mpl::vector<
+  std::integral_constant<AddressFamily, AddressFamily::V4>,
+  std::integral_constant<AddressFamily, AddressFamily::V6>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ShardedListen, F, AddressFamilies)
+{
+  auto address = getTestIp(F::value, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+  this->nListenSockets = 4;
+  this->listen(address);
+  BOOST_CHECK_EQUAL(this->listenerChannel->isListening(), true);
+
+  std::vector<unique_ptr<UdpChannel>> clientChannels;
+  for (int i = 0; i < 8; ++i) {
+    clientChannels.push_back(this->makeChannel(typename IpAddressFromFamily<F::value>::type()));
+    this->connect(*clientChannels.back());
+  }
+
+  BOOST_CHECK_EQUAL(this->limitedIo.run(16, 2_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(this->listenerChannel->size(), 8);
+  BOOST_CHECK_EQUAL(this->listenerFaces.size(), 8);
+  for (const auto& face : this->listenerFaces) {
+    BOOST_CHECK(dynamic_cast<UnicastUdpTransport*>(face->getTransport()) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(UnconnectedFaces, F, AddressFamilies)
+{
+  auto address = getTestIp(F::value, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+  this->wantConnectedFaces = false;
+  this->listen(address);
+
+  auto clientChannel = this->makeChannel(typename IpAddressFromFamily<F::value>::type());
+  this->connect(*clientChannel);
+
+  BOOST_CHECK_EQUAL(this->limitedIo.run(2, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(this->listenerFaces.size(), 1);
+  BOOST_REQUIRE_EQUAL(this->clientFaces.size(), 1);
+
+  auto listenerFace = this->listenerFaces.front();
+  auto clientFace = this->clientFaces.front();
+  BOOST_CHECK(dynamic_cast<SharedUdpTransport*>(listenerFace->getTransport()) != nullptr);
+  BOOST_CHECK_EQUAL(listenerFace->getRemoteUri(), clientFace->getLocalUri());
+  BOOST_CHECK_EQUAL(listenerFace->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+
+  // subsequent datagrams from the same peer are dispatched to the existing face
+  clientFace->getTransport()->send(ndn::encoding::makeStringBlock(300, "world"));
+  this->limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(this->listenerChannel->size(), 1);
+  BOOST_CHECK_EQUAL(listenerFace->getTransport()->getCounters().nInPackets, 2);
+
+  // replies are sent from the listening socket
+  listenerFace->getTransport()->send(ndn::encoding::makeStringBlock(300, "hello"));
+  this->limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(clientFace->getTransport()->getCounters().nInPackets, 1);
+
+  // closing the face does not close the listening socket
+  listenerFace->close();
+  BOOST_CHECK_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(this->listenerChannel->size(), 0);
+  BOOST_CHECK_EQUAL(this->listenerChannel->isListening(), true);
+
+  clientFace->getTransport()->send(ndn::encoding::makeStringBlock(300, "again"));
+  BOOST_CHECK_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(this->listenerChannel->size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestUdpChannel
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
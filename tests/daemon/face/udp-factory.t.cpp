@@ -24,9 +24,11 @@
  */
 
 #include "face/udp-factory.hpp"
+#include "face/unicast-udp-transport.hpp"
 
 #include "face-system-fixture.hpp"
 #include "factory-test-common.hpp"
+#include "tests/daemon/limited-io.hpp"
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -223,6 +225,193 @@ BOOST_AUTO_TEST_CASE(DisableListen)
                            [] (const auto& ch) { return ch->isListening(); }));
 }
 
+BOOST_AUTO_TEST_CASE(ShardedUnconnected)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7001
+        listen_sockets 4
+        connected_faces no
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, {"udp4://0.0.0.0:7001", "udp6://[::]:7001"});
+  auto channels = factory.getChannels();
+  BOOST_CHECK(std::all_of(channels.begin(), channels.end(),
+                          [] (const auto& ch) { return ch->isListening(); }));
+}
+
+BOOST_AUTO_TEST_CASE(ChangeChannelSockets)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7001
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG1, true);
+  parseConfig(CONFIG1, false);
+
+  // the sockets of existing channels cannot be rearranged on reload
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7001
+        listen_sockets 4
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
+
+  const std::string CONFIG3 = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7001
+        connected_faces no
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG3, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG3, false), ConfigFile::Error);
+
+  // a channel on another port can use different settings
+  const std::string CONFIG4 = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7002
+        listen_sockets 4
+        connected_faces no
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_NO_THROW(parseConfig(CONFIG4, true));
+  BOOST_CHECK_NO_THROW(parseConfig(CONFIG4, false));
+}
+
+BOOST_AUTO_TEST_CASE(KernelFilter)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7001
+        kernel_filter yes
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, {"udp4://0.0.0.0:7001", "udp6://[::]:7001"});
+
+#if defined(__linux__)
+  shared_ptr<const UdpChannel> channel;
+  for (const auto& ch : factory.getChannels()) {
+    if (ch->getUri().toString() == "udp4://0.0.0.0:7001") {
+      channel = dynamic_pointer_cast<const UdpChannel>(ch);
+    }
+  }
+  BOOST_REQUIRE(channel != nullptr);
+  BOOST_CHECK_EQUAL(channel->getNInKernelDropped(), 0);
+
+  namespace ip = boost::asio::ip;
+  const ip::udp::endpoint channelEp(ip::address_v4::loopback(), 7001);
+  ip::udp::socket junkPeer(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket ndnPeer(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  const std::vector<uint8_t> junk{'G', 'E', 'T', ' ', '/'};
+  auto interest = makeInterest("/A")->wireEncode();
+  LimitedIo limitedIo;
+
+  // the listening socket drops the malformed datagram, so no face is created for its sender
+  junkPeer.send_to(boost::asio::buffer(junk), channelEp);
+  ndnPeer.send_to(boost::asio::buffer(interest.wire(), interest.size()), channelEp);
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(channel->size(), 1);
+  BOOST_CHECK_EQUAL(channel->getNInKernelDropped(), 1);
+
+  auto faces = listFacesByScheme("udp4");
+  BOOST_REQUIRE_EQUAL(faces.size(), 1);
+  const Transport* transport = faces.front()->getTransport();
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 1);
+  BOOST_CHECK_EQUAL(dynamic_cast<const UnicastUdpTransport::Counters&>(transport->getCounters())
+                    .nInKernelDropped, 0);
+
+  // the connected socket of the face drops it as well, and the count is read when requested
+  ndnPeer.send_to(boost::asio::buffer(junk), channelEp);
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 1);
+  BOOST_CHECK_EQUAL(dynamic_cast<const UnicastUdpTransport::Counters&>(transport->getCounters())
+                    .nInKernelDropped, 1);
+  BOOST_CHECK_EQUAL(channel->getNInKernelDropped(), 1);
+#endif // __linux__
+}
+
+BOOST_AUTO_TEST_CASE(IoUring)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        port 7001
+        io_uring yes
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, {"udp4://0.0.0.0:7001", "udp6://[::]:7001"});
+
+  // the face receives on its connected socket, with io_uring if the kernel supports it
+  namespace ip = boost::asio::ip;
+  const ip::udp::endpoint channelEp(ip::address_v4::loopback(), 7001);
+  ip::udp::socket peer(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  auto interest1 = makeInterest("/A")->wireEncode();
+  auto interest2 = makeInterest("/B")->wireEncode();
+  LimitedIo limitedIo;
+
+  peer.send_to(boost::asio::buffer(interest1.wire(), interest1.size()), channelEp);
+  limitedIo.defer(100_ms);
+  auto faces = listFacesByScheme("udp4");
+  BOOST_REQUIRE_EQUAL(faces.size(), 1);
+
+  peer.send_to(boost::asio::buffer(interest2.wire(), interest2.size()), channelEp);
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(faces.front()->getCounters().nInInterests, 2);
+}
+
 BOOST_AUTO_TEST_CASE(DisableV4)
 {
   const std::string CONFIG = R"CONFIG(
@@ -657,6 +846,37 @@ BOOST_AUTO_TEST_CASE(BadIdleTimeout)
   BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadListenSockets)
+{
+  // zero
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        listen_sockets 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG1, false), ConfigFile::Error);
+
+  // too large
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        listen_sockets 1000
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadMcast)
 {
   const std::string CONFIG = R"CONFIG(
@@ -77,6 +77,40 @@ BOOST_AUTO_TEST_CASE(Omitted)
   BOOST_CHECK_EQUAL(factory.getChannels().size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ShmLimit)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        shm_limit 0
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(factory.getChannels().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(BadShmLimit)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        shm_limit -1
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownOption)
 {
   const std::string CONFIG = R"CONFIG(
@@ -95,7 +95,7 @@ protected:
   }
 
   void
-  initialize()
+  initialize(shared_ptr<ShmQuota> shmQuota = nullptr)
   {
     unix_stream::socket sock(g_io);
     acceptor.async_accept(sock, [this] (const boost::system::error_code& error) {
@@ -113,7 +113,7 @@ protected:
 
     localEp = sock.local_endpoint();
     face = make_unique<Face>(make_unique<DummyLinkService>(),
-                             make_unique<UnixStreamTransport>(std::move(sock)));
+                             make_unique<UnixStreamTransport>(std::move(sock), std::move(shmQuota)));
     transport = static_cast<UnixStreamTransport*>(face->getTransport());
     receivedPackets = &static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
 
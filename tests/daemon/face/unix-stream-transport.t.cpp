@@ -25,8 +25,21 @@
 
 #include "transport-test-common.hpp"
 
+#include "shm-client.hpp"
 #include "unix-stream-transport-fixture.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 namespace nfd {
 namespace face {
 namespace tests {
@@ -60,6 +73,149 @@ BOOST_AUTO_TEST_CASE(PersistencyChange)
   BOOST_CHECK_EQUAL(transport->canChangePersistencyTo(ndn::nfd::FACE_PERSISTENCY_PERMANENT), false);
 }
 
+#if defined(__linux__)
+BOOST_AUTO_TEST_CASE(SharedMemory)
+{
+  initialize();
+
+  Block request(shm_tlv::Request);
+  request.push_back(ndn::encoding::makeNonNegativeIntegerBlock(shm_tlv::RingCapacity, 1));
+  request.encode();
+  remoteWrite(ndn::Buffer(request.wire(), request.size()));
+  BOOST_REQUIRE(transport->isUsingSharedMemory());
+
+  // receive the response and the attached file descriptors
+  uint8_t buf[64];
+  iovec iov{buf, sizeof(buf)};
+  union {
+    char buf[CMSG_SPACE(3 * sizeof(int))];
+    cmsghdr align;
+  } control;
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t nRead = ::recvmsg(remoteSocket.native_handle(), &msg, 0);
+  BOOST_REQUIRE_GT(nRead, 0);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  BOOST_REQUIRE(cmsg != nullptr);
+  BOOST_REQUIRE_EQUAL(cmsg->cmsg_type, SCM_RIGHTS);
+  int fds[3];
+  std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+  // the application cannot resize the shared memory
+  BOOST_CHECK_EQUAL(::fcntl(fds[0], F_GET_SEALS), F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+  BOOST_CHECK_LT(::ftruncate(fds[0], 0), 0);
+
+  Block response(make_shared<ndn::Buffer>(buf, nRead));
+  BOOST_CHECK_EQUAL(response.type(), shm_tlv::Response);
+  response.parse();
+  size_t capacity = ndn::encoding::readNonNegativeInteger(response.get(shm_tlv::RingCapacity));
+  BOOST_CHECK_EQUAL(capacity, ShmRing::MIN_CAPACITY);
+
+  size_t ringRegionSize = ShmRing::computeRegionSize(capacity);
+  void* region = ::mmap(nullptr, 2 * ringRegionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+  BOOST_REQUIRE(region != MAP_FAILED);
+  ShmRing appToNfd(static_cast<uint8_t*>(region), capacity, false);
+  ShmRing nfdToApp(static_cast<uint8_t*>(region) + ringRegionSize, capacity, false);
+
+  // application to NFD: NFD is sleeping, so the first packet needs a wakeup
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  BOOST_CHECK(appToNfd.push(pkt1.wire(), pkt1.size()));
+  BOOST_CHECK_EQUAL(appToNfd.needsWakeup(), true);
+  BOOST_CHECK(appToNfd.push(pkt2.wire(), pkt2.size()));
+  BOOST_CHECK_EQUAL(appToNfd.needsWakeup(), false);
+  uint64_t one = 1;
+  BOOST_CHECK_EQUAL(::write(fds[1], &one, sizeof(one)), sizeof(one));
+  limitedIo.defer(100_ms);
+
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 2);
+  BOOST_CHECK_EQUAL(receivedPackets->at(0).packet, pkt1);
+  BOOST_CHECK_EQUAL(receivedPackets->at(1).packet, pkt2);
+
+  // NFD to application
+  BOOST_CHECK_EQUAL(nfdToApp.prepareToWait(), true);
+  transport->send(pkt1);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 1);
+  uint64_t value = 0;
+  BOOST_CHECK_EQUAL(::read(fds[2], &value, sizeof(value)), sizeof(value));
+  nfdToApp.endWait();
+  std::vector<Block> sent;
+  nfdToApp.consume([&] (const uint8_t* rec, size_t len) { sent.emplace_back(rec, len); }, 16);
+  BOOST_REQUIRE_EQUAL(sent.size(), 1);
+  BOOST_CHECK_EQUAL(sent[0], pkt1);
+
+  // the face goes down when the application closes the socket
+  remoteSocket.close();
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::CLOSED);
+
+  ::munmap(region, 2 * ringRegionSize);
+  for (int fd : fds) {
+    ::close(fd);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SharedMemoryQuota)
+{
+  size_t regionSize = 2 * ShmRing::computeRegionSize(ShmRing::MIN_CAPACITY);
+  auto quota = make_shared<ShmQuota>(regionSize - 1);
+  initialize(quota);
+
+  Block request(shm_tlv::Request);
+  request.push_back(ndn::encoding::makeNonNegativeIntegerBlock(shm_tlv::RingCapacity, 1));
+  request.encode();
+
+  // the request is ignored if it would exceed the limit
+  remoteWrite(ndn::Buffer(request.wire(), request.size()));
+  BOOST_CHECK(!transport->isUsingSharedMemory());
+  BOOST_CHECK_EQUAL(quota->getUsage(), 0);
+
+  quota->setLimit(regionSize);
+  remoteWrite(ndn::Buffer(request.wire(), request.size()));
+  BOOST_CHECK(transport->isUsingSharedMemory());
+  BOOST_CHECK_EQUAL(quota->getUsage(), regionSize);
+  BOOST_CHECK_EQUAL(quota->reserve(1), false);
+}
+
+BOOST_AUTO_TEST_CASE(SharedMemoryClient)
+{
+  initialize();
+
+  // ShmClient blocks until NFD answers, while NFD runs on the io_service of this thread
+  unique_ptr<ShmClient> client;
+  std::thread app([&] { client = make_unique<ShmClient>(remoteSocket.native_handle()); });
+  limitedIo.defer(100_ms);
+  app.join();
+  BOOST_REQUIRE(client != nullptr);
+  BOOST_CHECK(transport->isUsingSharedMemory());
+  BOOST_CHECK_EQUAL(client->getRingCapacity(), ShmRing::MIN_CAPACITY);
+
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  BOOST_CHECK(client->send(pkt1));
+  BOOST_CHECK(client->send(pkt2));
+  limitedIo.defer(100_ms);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 2);
+  BOOST_CHECK_EQUAL(receivedPackets->at(0).packet, pkt1);
+  BOOST_CHECK_EQUAL(receivedPackets->at(1).packet, pkt2);
+
+  transport->send(pkt2);
+  transport->send(pkt1);
+  BOOST_CHECK_EQUAL(client->wait(1_s), true);
+  std::vector<Block> received;
+  BOOST_CHECK_EQUAL(client->receive([&] (const Block& pkt) { received.push_back(pkt); }, 16), 2);
+  BOOST_REQUIRE_EQUAL(received.size(), 2);
+  BOOST_CHECK_EQUAL(received[0], pkt2);
+  BOOST_CHECK_EQUAL(received[1], pkt1);
+
+  // nothing more to receive
+  BOOST_CHECK_EQUAL(client->wait(10_ms), false);
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnixStreamTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
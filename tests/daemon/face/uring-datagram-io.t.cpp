@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/uring-datagram-io.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/limited-io.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+namespace ip = boost::asio::ip;
+using ip::udp;
+
+class UringDatagramIoFixture : public GlobalIoFixture
+{
+protected:
+  UringDatagramIoFixture()
+    : localSocket(g_io)
+    , remoteSocket(g_io)
+  {
+    localSocket.open(udp::v4());
+    localSocket.bind(udp::endpoint(ip::address_v4::loopback(), 0));
+    remoteSocket.open(udp::v4());
+    remoteSocket.bind(udp::endpoint(ip::address_v4::loopback(), 0));
+    localSocket.connect(remoteSocket.local_endpoint());
+    remoteSocket.connect(localSocket.local_endpoint());
+  }
+
+  void
+  initialize()
+  {
+    io = make_unique<UringDatagramIo>(localSocket.native_handle(),
+      [this] (const uint8_t* buffer, size_t nBytesReceived, const boost::system::error_code& error) {
+        BOOST_CHECK_EQUAL(error, boost::system::errc::success);
+        received.emplace_back(buffer, buffer + nBytesReceived);
+        limitedIo.afterOp();
+      },
+      [this] (const boost::system::error_code& error, size_t nBytesSent) {
+        BOOST_CHECK_EQUAL(error, boost::system::errc::success);
+        sent.push_back(nBytesSent);
+        limitedIo.afterOp();
+      });
+  }
+
+protected:
+  LimitedIo limitedIo;
+  udp::socket localSocket;
+  udp::socket remoteSocket;
+  unique_ptr<UringDatagramIo> io;
+  std::vector<std::vector<uint8_t>> received;
+  std::vector<size_t> sent;
+};
+
+#define SKIP_IF_URING_UNSUPPORTED() \
+  do { \
+    if (!UringDatagramIo::isSupported()) { \
+      BOOST_WARN_MESSAGE(false, "skipping assertions that require io_uring support"); \
+      return; \
+    } \
+  } while (false)
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestUringDatagramIo, UringDatagramIoFixture)
+
+BOOST_AUTO_TEST_CASE(Unsupported)
+{
+  if (UringDatagramIo::isSupported()) {
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require io_uring to be unavailable");
+    return;
+  }
+
+  BOOST_CHECK_THROW(initialize(), UringDatagramIo::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Receive)
+{
+  SKIP_IF_URING_UNSUPPORTED();
+  initialize();
+
+  // more datagrams than receive buffers, so that the buffers are recycled and
+  // the multishot request is rearmed after the kernel runs out of buffers
+  const size_t nDatagrams = UringDatagramIo::N_RECEIVE_BUFFERS * 2 + 1;
+  for (size_t i = 0; i < nDatagrams; ++i) {
+    uint8_t payload[] = {0x05, 0x02, static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8)};
+    remoteSocket.send(boost::asio::buffer(payload));
+  }
+  BOOST_REQUIRE_EQUAL(limitedIo.run(nDatagrams, 1_s), LimitedIo::EXCEED_OPS);
+
+  BOOST_REQUIRE_EQUAL(received.size(), nDatagrams);
+  for (size_t i = 0; i < nDatagrams; ++i) {
+    BOOST_REQUIRE_EQUAL(received[i].size(), 4);
+    BOOST_CHECK_EQUAL(received[i][2] | (received[i][3] << 8), i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SendBatch)
+{
+  SKIP_IF_URING_UNSUPPORTED();
+  initialize();
+
+  // sends queued in the same event loop turn are submitted together
+  auto block1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto block2 = ndn::encoding::makeStringBlock(301, "world!");
+  io->send(block1);
+  io->send(block2);
+  BOOST_CHECK_EQUAL(sent.size(), 0);
+
+  BOOST_REQUIRE_EQUAL(limitedIo.run(2, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(sent.size(), 2);
+  BOOST_CHECK_EQUAL(sent[0], block1.size());
+  BOOST_CHECK_EQUAL(sent[1], block2.size());
+
+  std::vector<uint8_t> buf(ndn::MAX_NDN_PACKET_SIZE);
+  size_t nBytes = remoteSocket.receive(boost::asio::buffer(buf));
+  BOOST_CHECK_EQUAL_COLLECTIONS(buf.begin(), buf.begin() + nBytes, block1.begin(), block1.end());
+  nBytes = remoteSocket.receive(boost::asio::buffer(buf));
+  BOOST_CHECK_EQUAL_COLLECTIONS(buf.begin(), buf.begin() + nBytes, block2.begin(), block2.end());
+}
+
+BOOST_AUTO_TEST_CASE(Close)
+{
+  SKIP_IF_URING_UNSUPPORTED();
+  initialize();
+
+  io->close();
+  uint8_t payload[] = {0x05, 0x00};
+  remoteSocket.send(boost::asio::buffer(payload));
+  io->send(ndn::encoding::makeEmptyBlock(300));
+
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 100_ms), LimitedIo::EXCEED_TIME);
+  BOOST_CHECK_EQUAL(received.size(), 0);
+  BOOST_CHECK_EQUAL(sent.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestUringDatagramIo
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
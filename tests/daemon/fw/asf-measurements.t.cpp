@@ -89,6 +89,12 @@ BOOST_FIXTURE_TEST_CASE(NamespaceInfo, GlobalIoTimeFixture)
 
   this->advanceClocks(AsfMeasurements::MEASUREMENTS_LIFETIME + 1_s);
   BOOST_CHECK(info.getFaceInfo(1234) == nullptr); // expired
+
+  auto& faceInfo2 = info.getOrCreateFaceInfo(1234);
+  this->advanceClocks(AsfMeasurements::MEASUREMENTS_LIFETIME - 1_s);
+  info.extendFaceInfoLifetime(faceInfo2);
+  this->advanceClocks(2_s);
+  BOOST_CHECK(info.getFaceInfo(1234) == &faceInfo2); // extended
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestAsfStrategy
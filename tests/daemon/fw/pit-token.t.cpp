@@ -23,6 +23,8 @@
  * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "face/generic-link-service.hpp"
+
 #include "tests/daemon/global-io-fixture.hpp"
 #include "topology-tester.hpp"
 
@@ -71,6 +73,138 @@ BOOST_FIXTURE_TEST_CASE(Downstream, GlobalIoTimeFixture)
   BOOST_CHECK(tokenD == tokenI);
 }
 
+// Upstream echoes PIT token.
+BOOST_FIXTURE_TEST_CASE(Upstream, GlobalIoTimeFixture)
+{
+  TopologyTester topo;
+  TopologyNode nodeR = topo.addForwarder("R");
+  auto linkC = topo.addBareLink("C", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto linkS = topo.addBareLink("S", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto serviceS = dynamic_cast<face::GenericLinkService*>(linkS->getForwarderFace().getLinkService());
+  BOOST_REQUIRE(serviceS != nullptr);
+  auto options = serviceS->getOptions();
+  options.allowPitToken = true;
+  serviceS->setOptions(options);
+  topo.registerPrefix(nodeR, linkS->getForwarderFace(), "/U", 5);
+  // Client --- Router --- Server
+  // Client disallows PIT token; Router assigns PIT token; Server echoes PIT token.
+
+  // C sends Interests /U/0 and /U/1 without PIT token
+  linkC->receivePacket(makeInterest("/U/0", false, nullopt, 1)->wireEncode());
+  linkC->receivePacket(makeInterest("/U/1", false, nullopt, 2)->wireEncode());
+  advanceClocks(5_ms, 30_ms);
+
+  // S should receive Interests with distinct PIT tokens
+  BOOST_REQUIRE_EQUAL(linkS->sentPackets.size(), 2);
+  lp::Packet lppS0(linkS->sentPackets.at(0));
+  lp::Packet lppS1(linkS->sentPackets.at(1));
+  BOOST_REQUIRE_EQUAL(lppS0.count<lp::PitTokenField>(), 1);
+  BOOST_REQUIRE_EQUAL(lppS1.count<lp::PitTokenField>(), 1);
+  BOOST_CHECK(lp::PitToken(lppS0.get<lp::PitTokenField>()) !=
+              lp::PitToken(lppS1.get<lp::PitTokenField>()));
+
+  // S responds Data /U/0 with its PIT token, and Data /U/1 with the PIT token of /U/0,
+  // which is stale after /U/0 is satisfied, so that /U/1 is matched by name
+  lp::Packet lppD0(makeData("/U/0")->wireEncode());
+  lppD0.add<lp::PitTokenField>(lppS0.get<lp::PitTokenField>());
+  linkS->receivePacket(lppD0.wireEncode());
+  advanceClocks(5_ms, 300_ms);
+  lp::Packet lppD1(makeData("/U/1")->wireEncode());
+  lppD1.add<lp::PitTokenField>(lppS0.get<lp::PitTokenField>());
+  linkS->receivePacket(lppD1.wireEncode());
+  advanceClocks(5_ms, 300_ms);
+
+  // C should receive both Data without PIT token
+  BOOST_REQUIRE_EQUAL(linkC->sentPackets.size(), 2);
+  for (const Block& packet : linkC->sentPackets) {
+    lp::Packet lppD(packet);
+    BOOST_CHECK_EQUAL(lppD.count<lp::PitTokenField>(), 0);
+  }
+  BOOST_CHECK_EQUAL(topo.getForwarder(nodeR).getCounters().nSatisfiedInterests, 2);
+}
+
+// Upstream receives the PIT token of the router, not the one from downstream.
+BOOST_FIXTURE_TEST_CASE(DownstreamAndUpstream, GlobalIoTimeFixture)
+{
+  TopologyTester topo;
+  TopologyNode nodeR = topo.addForwarder("R");
+  auto linkC = topo.addBareLink("C", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto linkS = topo.addBareLink("S", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto serviceS = dynamic_cast<face::GenericLinkService*>(linkS->getForwarderFace().getLinkService());
+  BOOST_REQUIRE(serviceS != nullptr);
+  auto options = serviceS->getOptions();
+  options.allowPitToken = true;
+  serviceS->setOptions(options);
+  topo.registerPrefix(nodeR, linkS->getForwarderFace(), "/U", 5);
+  // Client --- Router --- Server
+  // Client requires PIT token; Router assigns PIT token; Server echoes PIT token.
+
+  // C sends Interest /U/0 with PIT token
+  lp::Packet lppI("6414 pit-token=6206A0A1A2A3A4A5 payload=500A interest=0508 0706080155080130"_block);
+  lp::PitToken tokenI(lppI.get<lp::PitTokenField>());
+  linkC->receivePacket(lppI.wireEncode());
+  advanceClocks(5_ms, 30_ms);
+
+  // S should receive Interest with the PIT token of R
+  BOOST_REQUIRE_EQUAL(linkS->sentPackets.size(), 1);
+  lp::Packet lppS(linkS->sentPackets.front());
+  BOOST_REQUIRE_EQUAL(lppS.count<lp::PitTokenField>(), 1);
+  lp::PitToken tokenS(lppS.get<lp::PitTokenField>());
+  BOOST_CHECK(tokenS != tokenI);
+
+  // S responds Data with the PIT token of R
+  lp::Packet lppD0(makeData("/U/0")->wireEncode());
+  lppD0.add<lp::PitTokenField>(lppS.get<lp::PitTokenField>());
+  linkS->receivePacket(lppD0.wireEncode());
+  advanceClocks(5_ms, 30_ms);
+
+  // C should receive Data with its own PIT token
+  BOOST_REQUIRE_EQUAL(linkC->sentPackets.size(), 1);
+  lp::Packet lppD(linkC->sentPackets.front());
+  BOOST_CHECK(lp::PitToken(lppD.get<lp::PitTokenField>()) == tokenI);
+}
+
+// Data carrying a PIT token also satisfies other matching PIT entries.
+BOOST_FIXTURE_TEST_CASE(UpstreamMultiMatch, GlobalIoTimeFixture)
+{
+  TopologyTester topo;
+  TopologyNode nodeR = topo.addForwarder("R");
+  auto linkC = topo.addBareLink("C", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto linkD = topo.addBareLink("D", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto linkS = topo.addBareLink("S", nodeR, ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto serviceS = dynamic_cast<face::GenericLinkService*>(linkS->getForwarderFace().getLinkService());
+  BOOST_REQUIRE(serviceS != nullptr);
+  auto options = serviceS->getOptions();
+  options.allowPitToken = true;
+  serviceS->setOptions(options);
+  topo.registerPrefix(nodeR, linkS->getForwarderFace(), "/U", 5);
+  // Client C --- Router --- Server
+  // Client D ---/
+  // Router assigns PIT token; Server echoes PIT token.
+
+  // C sends Interest /U/0, D sends Interest /U with CanBePrefix
+  linkC->receivePacket(makeInterest("/U/0", false, nullopt, 1)->wireEncode());
+  linkD->receivePacket(makeInterest("/U", true, nullopt, 2)->wireEncode());
+  advanceClocks(5_ms, 30_ms);
+
+  // S should receive both Interests with PIT tokens
+  BOOST_REQUIRE_EQUAL(linkS->sentPackets.size(), 2);
+  lp::Packet lppS0(linkS->sentPackets.at(0));
+  BOOST_REQUIRE_EQUAL(lppS0.count<lp::PitTokenField>(), 1);
+
+  // S responds Data /U/0 with the PIT token of /U/0
+  lp::Packet lppD0(makeData("/U/0")->wireEncode());
+  lppD0.add<lp::PitTokenField>(lppS0.get<lp::PitTokenField>());
+  linkS->receivePacket(lppD0.wireEncode());
+  advanceClocks(5_ms, 30_ms);
+
+  // both C and D should receive the Data
+  BOOST_CHECK_EQUAL(linkC->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(linkD->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(topo.getForwarder(nodeR).getCounters().nSatisfiedInterests, 2);
+  BOOST_CHECK_EQUAL(topo.getForwarder(nodeR).getPit().size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPitToken
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
@@ -29,6 +29,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <thread>
+
 namespace nfd {
 namespace tests {
 
@@ -66,7 +68,12 @@ protected:
     if (modifyInterest != nullptr) {
       modifyInterest(interest);
     }
+    return authorizeInterest(module, interest);
+  }
 
+  bool
+  authorizeInterest(const std::string& module, const Interest& interest)
+  {
     ndn::mgmt::Authorization authorization = authorizations.at(module);
 
     bool isAccepted = false;
@@ -368,6 +375,96 @@ BOOST_FIXTURE_TEST_CASE(MissingAuthorizationsSection, CommandAuthenticatorFixtur
 
 BOOST_AUTO_TEST_SUITE_END() // Rejects
 
+BOOST_FIXTURE_TEST_SUITE(KeyCache, IdentityAuthorizedFixture)
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  BOOST_CHECK_EQUAL(authorize1(nullptr), true); // validated by Validator, key is cached
+
+  Interest interest;
+  BOOST_CHECK_EQUAL(authorize1([&interest] (const Interest& i) { interest = i; }), true);
+  BOOST_CHECK_EQUAL(authorizeInterest("module1", interest), false); // same command again
+  BOOST_CHECK(lastRejectReply == ndn::mgmt::RejectReply::STATUS403);
+
+  BOOST_CHECK_EQUAL(authorize1(nullptr), true);
+}
+
+BOOST_AUTO_TEST_CASE(BadSigWithCachedKey)
+{
+  BOOST_CHECK_EQUAL(authorize1(nullptr), true);
+  BOOST_CHECK_EQUAL(authorize1(
+    [] (Interest& interest) {
+      setNameComponent(interest, ndn::command_interest::POS_SIG_VALUE, "bad-signature-bits");
+    }
+  ), false);
+  BOOST_CHECK(lastRejectReply == ndn::mgmt::RejectReply::STATUS403);
+  BOOST_CHECK_EQUAL(authorize1(nullptr), true);
+}
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  Interest interest;
+  BOOST_CHECK_EQUAL(authorize1([&interest] (const Interest& i) { interest = i; }), true);
+  BOOST_CHECK_EQUAL(authorize1(nullptr), true);
+
+  this->advanceClocks(1_s, CommandAuthenticator::DEFAULT_KEY_CACHE_LIFETIME + 1_s);
+  BOOST_CHECK_EQUAL(authorize1(nullptr), true); // validated by Validator again
+  BOOST_CHECK_EQUAL(authorizeInterest("module1", interest), false); // still no replay
+}
+
+BOOST_AUTO_TEST_SUITE_END() // KeyCache
+
+BOOST_FIXTURE_TEST_CASE(VerificationThread, CommandAuthenticatorFixture)
+{
+  Name id1("/localhost/CommandAuthenticator/1");
+  BOOST_REQUIRE(saveIdentityCertificate(id1, "1.ndncert", true));
+
+  makeModules({"module1"});
+  const std::string& config = R"CONFIG(
+    authorizations
+    {
+      key_cache_lifetime 60
+      verification_thread yes
+      authorize
+      {
+        certfile "1.ndncert"
+        privileges
+        {
+          module1
+        }
+      }
+    }
+  )CONFIG";
+  loadConfig(config);
+
+  const size_t nCommands = 8;
+  std::vector<Interest> interests;
+  for (size_t i = 0; i < nCommands; ++i) {
+    interests.push_back(this->makeControlCommandRequest(Name("/prefix/module1/verb").appendNumber(i),
+                                                        ControlParameters(), id1));
+  }
+  setNameComponent(interests[5], ndn::command_interest::POS_SIG_VALUE, "bad-signature-bits");
+
+  // results must be delivered in arrival order, regardless of which thread verified the command
+  std::vector<std::pair<size_t, bool>> results;
+  auto authorization = authorizations.at("module1");
+  for (size_t i = 0; i < nCommands; ++i) {
+    authorization(Name("/prefix"), interests[i], nullptr,
+      [&results, i] (const std::string&) { results.emplace_back(i, true); },
+      [&results, i] (ndn::mgmt::RejectReply) { results.emplace_back(i, false); });
+  }
+  for (int i = 0; i < 5000 && results.size() < nCommands; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    this->advanceClocks(1_ms);
+  }
+
+  BOOST_REQUIRE_EQUAL(results.size(), nCommands);
+  for (size_t i = 0; i < nCommands; ++i) {
+    BOOST_CHECK_EQUAL(results[i].first, i);
+    BOOST_CHECK_EQUAL(results[i].second, i != 5);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(BadConfig)
 
 BOOST_AUTO_TEST_CASE(EmptyAuthorizationsSection)
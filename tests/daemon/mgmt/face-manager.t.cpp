@@ -24,12 +24,16 @@
  */
 
 #include "mgmt/face-manager.hpp"
+#include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
+#include "face/socket-utils.hpp"
+#include "face/unicast-udp-transport.hpp"
 
 #include "manager-common-fixture.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
 #include "tests/daemon/face/dummy-transport.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/encoding/tlv-nfd.hpp>
 #include <ndn-cxx/mgmt/nfd/channel-status.hpp>
@@ -207,6 +211,48 @@ BOOST_AUTO_TEST_CASE(FaceDataset)
   BOOST_CHECK_EQUAL(status.getNOutBytes(), face->getCounters().nOutBytes);
 }
 
+BOOST_AUTO_TEST_CASE(FaceDatasetKernelDropCount)
+{
+  namespace ip = boost::asio::ip;
+  ip::udp::socket peer(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket socket(g_io, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  socket.connect(peer.local_endpoint());
+  bool hasFilter = face::attachNdnDatagramFilter(socket.native_handle());
+  auto localEp = socket.local_endpoint();
+  auto udpFace = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                   make_unique<face::UnicastUdpTransport>(std::move(socket),
+                                                                          ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                                                                          0_s));
+  m_faceTable.add(udpFace);
+
+  // a datagram that is not an NDN packet is dropped by the socket filter
+  const std::vector<uint8_t> junk{'G', 'E', 'T', ' ', '/'};
+  peer.send_to(boost::asio::buffer(junk), localEp);
+  // the drop count is only available where the kernel reports it
+  uint64_t expectedDropCount = hasFilter && face::getSocketDropCount(peer.native_handle()) >= 0;
+  auto dummyFace = addFace(REMOVE_LAST_NOTIFICATION);
+  m_responses.clear();
+
+  receiveInterest(Interest("/localhost/nfd/faces/list").setCanBePrefix(true));
+
+  Block content = concatenateResponses();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+  for (Block element : content.elements()) {
+    ndn::nfd::FaceStatus status(element); // the extension does not break decoding
+    element.parse();
+    auto ext = element.find(TLV_N_IN_KERNEL_DROPPED);
+    if (status.getFaceId() == static_cast<uint64_t>(udpFace->getId())) {
+      BOOST_REQUIRE(ext != element.elements_end());
+      BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(*ext), expectedDropCount);
+    }
+    else {
+      BOOST_CHECK_EQUAL(status.getFaceId(), dummyFace->getId());
+      BOOST_CHECK(ext == element.elements_end());
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(FaceQuery)
 {
   using ndn::nfd::FaceQueryFilter;
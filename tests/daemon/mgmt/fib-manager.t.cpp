@@ -24,6 +24,7 @@
  */
 
 #include "mgmt/fib-manager.hpp"
+#include "core/dataset-page.hpp"
 #include "table/fib-nexthop.hpp"
 
 #include "manager-common-fixture.hpp"
@@ -398,6 +399,33 @@ BOOST_AUTO_TEST_CASE(RecordNotExist)
 
 BOOST_AUTO_TEST_SUITE_END() // RemoveNextHop
 
+BOOST_AUTO_TEST_CASE(ApplyFibUpdate)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdate(rib::FibUpdate::createAddUpdate("/hello", face1, 101)), 200);
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdate(rib::FibUpdate::createAddUpdate("/hello", face2, 202)), 200);
+  BOOST_CHECK_EQUAL(checkNextHop("/hello", 2, face1, 101), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop("/hello", 2, face2, 202), CheckNextHopResult::OK);
+
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdate(rib::FibUpdate::createAddUpdate("/hello", face2 + 100, 1)), 410);
+  BOOST_CHECK_EQUAL(checkNextHop("/hello", 2), CheckNextHopResult::OK);
+
+  Name prefix;
+  for (size_t i = 0; i < Fib::getMaxDepth() + 1; ++i) {
+    prefix.append("A");
+  }
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdate(rib::FibUpdate::createAddUpdate(prefix, face1, 1)), 414);
+
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdate(rib::FibUpdate::createRemoveUpdate("/hello", face1)), 200);
+  BOOST_CHECK_EQUAL(checkNextHop("/hello", 1, face1), CheckNextHopResult::NO_NEXTHOP);
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdate(rib::FibUpdate::createRemoveUpdate("/hello", face2)), 200);
+  BOOST_CHECK_EQUAL(checkNextHop("/hello"), CheckNextHopResult::NO_FIB_ENTRY);
+
+  BOOST_CHECK_EQUAL(m_responses.size(), 0); // no control commands involved
+}
+
 BOOST_AUTO_TEST_SUITE(List)
 
 BOOST_AUTO_TEST_CASE(FibDataset)
@@ -441,6 +469,90 @@ BOOST_AUTO_TEST_CASE(FibDataset)
                                 expectedRecords.begin(), expectedRecords.end());
 }
 
+BOOST_AUTO_TEST_CASE(FibDatasetPaged)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+  std::set<Name> expectedAll, expectedFace2, expectedEvenFace2;
+  for (size_t i = 0; i < 108; ++i) {
+    Name prefix = Name(i % 2 == 0 ? "/even" : "/odd").appendSegment(i);
+    fib::Entry* fibEntry = m_fib.insert(prefix).first;
+    m_fib.addOrUpdateNextHop(*fibEntry, *m_faceTable.get(face1), 10);
+    expectedAll.insert(prefix);
+    if (i % 3 == 0) {
+      m_fib.addOrUpdateNextHop(*fibEntry, *m_faceTable.get(face2), 20);
+      expectedFace2.insert(prefix);
+      if (i % 2 == 0) {
+        expectedEvenFace2.insert(prefix);
+      }
+    }
+  }
+
+  auto fetchAllPages = [this] (DatasetPageQuery query) {
+    std::vector<ndn::nfd::FibEntry> entries;
+    for (size_t nPages = 1; ; ++nPages) {
+      BOOST_REQUIRE_LT(nPages, 1000);
+      receiveInterest(Interest(Name("/localhost/nfd/fib/list").append(query.wireEncode()))
+                      .setCanBePrefix(true));
+      Block content = m_responses.back().getContent();
+      content.parse();
+
+      optional<Block> cursor;
+      size_t nItems = 0;
+      for (const Block& element : content.elements()) {
+        BOOST_REQUIRE(!cursor); // cursor must be the last element
+        if (element.type() == TLV_DATASET_PAGE_CURSOR) {
+          cursor = element;
+        }
+        else {
+          entries.emplace_back(element);
+          ++nItems;
+        }
+      }
+      BOOST_CHECK_LE(nItems, query.getLimit());
+
+      if (!cursor) {
+        return entries;
+      }
+      query.setCursor(*cursor);
+    }
+  };
+
+  auto entries = fetchAllPages(DatasetPageQuery().setLimit(10));
+  std::set<Name> prefixes;
+  for (const auto& entry : entries) {
+    prefixes.insert(entry.getPrefix());
+  }
+  BOOST_CHECK_EQUAL(entries.size(), expectedAll.size()); // no duplicates
+  BOOST_CHECK_EQUAL_COLLECTIONS(prefixes.begin(), prefixes.end(),
+                                expectedAll.begin(), expectedAll.end());
+
+  entries = fetchAllPages(DatasetPageQuery().setFaceId(face2).setLimit(10));
+  prefixes.clear();
+  for (const auto& entry : entries) {
+    prefixes.insert(entry.getPrefix());
+    BOOST_REQUIRE_EQUAL(entry.getNextHopRecords().size(), 1);
+    BOOST_CHECK_EQUAL(entry.getNextHopRecords().front().getFaceId(), face2);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(prefixes.begin(), prefixes.end(),
+                                expectedFace2.begin(), expectedFace2.end());
+
+  entries = fetchAllPages(DatasetPageQuery().setPrefix("/even").setFaceId(face2));
+  prefixes.clear();
+  for (const auto& entry : entries) {
+    prefixes.insert(entry.getPrefix());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(prefixes.begin(), prefixes.end(),
+                                expectedEvenFace2.begin(), expectedEvenFace2.end());
+
+  Name malformedName = Name("/localhost/nfd/fib/list")
+                       .append(ndn::makeStringBlock(tlv::Content, "malformed"));
+  receiveInterest(Interest(malformedName).setCanBePrefix(true));
+  BOOST_CHECK_EQUAL(checkResponse(m_responses.size() - 1, malformedName,
+                                  ControlResponse(400, "Malformed query"), tlv::ContentType_Nack),
+                    CheckResponseResult::OK);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // List
 
 BOOST_AUTO_TEST_SUITE_END() // TestFibManager
@@ -24,6 +24,8 @@
  */
 
 #include "mgmt/rib-manager.hpp"
+#include "core/dataset-page.hpp"
+#include "core/route-batch.hpp"
 
 #include "manager-common-fixture.hpp"
 #include "tests/daemon/rib/fib-updates-common.hpp"
@@ -33,6 +35,7 @@
 #include <ndn-cxx/mgmt/nfd/rib-entry.hpp>
 #include <ndn-cxx/security/signing-helpers.hpp>
 
+#include <boost/filesystem.hpp>
 #include <boost/property_tree/info_parser.hpp>
 
 namespace nfd {
@@ -405,7 +408,8 @@ BOOST_AUTO_TEST_CASE(Expiration)
   auto paramsUnregister = makeRegisterParameters("/test-expiry", 9527);
   receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register", paramsRegister));
 
-  advanceClocks(55_ms);
+  // routes expire at the end of their expiration wheel slot
+  advanceClocks(10_ms, m_rib.getExpirationTick() + 55_ms);
   BOOST_REQUIRE_EQUAL(m_fibUpdater.updates.size(), 2); // the registered route has expired
   BOOST_CHECK_EQUAL(m_fibUpdater.updates.front(),
                     rib::FibUpdate::createAddUpdate("/test-expiry", 9527, 10));
@@ -441,6 +445,106 @@ BOOST_AUTO_TEST_CASE(NameTooLong)
   BOOST_CHECK_EQUAL(m_fibUpdater.updates.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  Name longPrefix;
+  while (longPrefix.size() <= Fib::getMaxDepth()) {
+    longPrefix.append("A");
+  }
+
+  RouteBatchParameters registerBatch;
+  registerBatch.addRoute(makeRegisterParameters("/batch/a", 9527))
+               .addRoute(makeRegisterParameters(longPrefix, 9527))
+               .addRoute(ControlParameters().setFaceId(9527)) // missing Name
+               .addRoute(makeRegisterParameters("/batch/b"));
+  Name registerName("/localhost/nfd/rib/register-batch");
+  auto commandRegister = makeCommandInterest(registerName.append(registerBatch.wireEncode()));
+  commandRegister.setTag(make_shared<lp::IncomingFaceIdTag>(9528));
+  receiveInterest(commandRegister);
+
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  ControlResponse resp(m_responses[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(resp.getCode(), 200);
+  RouteBatchResults results(resp.getBody());
+  BOOST_REQUIRE_EQUAL(results.getResults().size(), 4);
+  BOOST_CHECK_EQUAL(results.getResults()[0].getCode(), 200);
+  BOOST_CHECK_EQUAL(results.getResults()[1].getCode(), 414);
+  BOOST_CHECK_EQUAL(results.getResults()[2].getCode(), 400);
+  BOOST_CHECK_EQUAL(results.getResults()[3].getCode(), 200);
+  BOOST_CHECK_EQUAL(ControlParameters(results.getResults()[3].getBody()).getFaceId(), 9528);
+
+  BOOST_REQUIRE_EQUAL(m_fibUpdater.updates.size(), 2);
+  BOOST_CHECK_EQUAL(m_fibUpdater.updates.front(), rib::FibUpdate::createAddUpdate("/batch/a", 9527, 10));
+  BOOST_CHECK_EQUAL(m_fibUpdater.updates.back(), rib::FibUpdate::createAddUpdate("/batch/b", 9528, 10));
+  m_fibUpdater.updates.clear();
+
+  RouteBatchParameters unregisterBatch;
+  unregisterBatch.addRoute(makeUnregisterParameters("/batch/a", 9527))
+                 .addRoute(makeUnregisterParameters("/batch/b", 9528));
+  Name unregisterName("/localhost/nfd/rib/unregister-batch");
+  receiveInterest(makeCommandInterest(unregisterName.append(unregisterBatch.wireEncode())));
+
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 2);
+  BOOST_CHECK_EQUAL(ControlResponse(m_responses[1].getContent().blockFromValue()).getCode(), 200);
+  BOOST_REQUIRE_EQUAL(m_fibUpdater.updates.size(), 2);
+  BOOST_CHECK_EQUAL(m_fibUpdater.updates.front(), rib::FibUpdate::createRemoveUpdate("/batch/a", 9527));
+  BOOST_CHECK_EQUAL(m_fibUpdater.updates.back(), rib::FibUpdate::createRemoveUpdate("/batch/b", 9528));
+
+  // an empty batch is rejected as a whole
+  Name emptyName("/localhost/nfd/rib/register-batch");
+  receiveInterest(makeCommandInterest(emptyName.append(RouteBatchParameters().wireEncode())));
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 3);
+  BOOST_CHECK_EQUAL(ControlResponse(m_responses[2].getContent().blockFromValue()).getCode(), 400);
+}
+
+BOOST_AUTO_TEST_CASE(BatchSizeLimit)
+{
+  // sends the batch, and checks that both the command and the response fit in a packet
+  auto sendBatch = [this] (const RouteBatchParameters& batch) {
+    Name name("/localhost/nfd/rib/register-batch");
+    auto command = makeCommandInterest(name.append(batch.wireEncode()));
+    command.setTag(make_shared<lp::IncomingFaceIdTag>(9528));
+    BOOST_CHECK_LE(command.wireEncode().size(), ndn::MAX_NDN_PACKET_SIZE);
+    m_responses.clear();
+    receiveInterest(command);
+
+    BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+    BOOST_CHECK_LE(m_responses[0].wireEncode().size(), ndn::MAX_NDN_PACKET_SIZE);
+    return ControlResponse(m_responses[0].getContent().blockFromValue());
+  };
+
+  // many short routes, each of which grows when defaults are applied in the response
+  RouteBatchParameters shortBatch;
+  for (uint64_t i = 0; shortBatch.canAddRoute(ControlParameters().setName(Name("/s").appendNumber(i))); ++i) {
+    shortBatch.addRoute(ControlParameters().setName(Name("/s").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(shortBatch.size(), RouteBatchParameters::MAX_ROUTES);
+  auto resp = sendBatch(shortBatch);
+  BOOST_CHECK_EQUAL(resp.getCode(), 200);
+  BOOST_CHECK_EQUAL(RouteBatchResults(resp.getBody()).getResults().size(), shortBatch.size());
+
+  // fewer long routes, up to the encoded size limit
+  auto makeLongRoute = [] (uint64_t i) {
+    return ControlParameters().setName(Name("/l").append(std::string(40, 'x')).appendNumber(i))
+                              .setFaceId(9527).setCost(65535).setExpirationPeriod(1_h);
+  };
+  RouteBatchParameters longBatch;
+  uint64_t i = 0;
+  for (; longBatch.canAddRoute(makeLongRoute(i)); ++i) {
+    longBatch.addRoute(makeLongRoute(i));
+  }
+  BOOST_CHECK_LT(longBatch.size(), RouteBatchParameters::MAX_ROUTES);
+  BOOST_CHECK_LE(longBatch.wireEncode().size(), RouteBatchParameters::MAX_ENCODED_SIZE);
+  resp = sendBatch(longBatch);
+  BOOST_CHECK_EQUAL(resp.getCode(), 200);
+  BOOST_CHECK_EQUAL(RouteBatchResults(resp.getBody()).getResults().size(), longBatch.size());
+
+  // a batch above the limit is rejected as a whole
+  longBatch.addRoute(makeLongRoute(i));
+  BOOST_CHECK(!longBatch.isValid());
+  BOOST_CHECK_EQUAL(sendBatch(longBatch).getCode(), 400);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // RegisterUnregister
 
 BOOST_FIXTURE_TEST_CASE(RibDataset, UnauthorizedRibManagerFixture)
@@ -500,6 +604,83 @@ BOOST_FIXTURE_TEST_CASE(RibDataset, UnauthorizedRibManagerFixture)
                                 expectedRecords.begin(), expectedRecords.end());
 }
 
+BOOST_FIXTURE_TEST_CASE(RibDatasetPaged, UnauthorizedRibManagerFixture)
+{
+  std::vector<Name> expectedAll, expectedFace2, expectedUnderA;
+  for (size_t i = 0; i < 50; ++i) {
+    Name prefix = Name(i < 20 ? "/A" : "/B").appendNumber(i);
+    rib::Route route;
+    route.faceId = 1;
+    m_rib.insert(prefix, route);
+    expectedAll.push_back(prefix);
+    if (i < 20) {
+      expectedUnderA.push_back(prefix);
+    }
+    if (i % 7 == 0) {
+      route.faceId = 2;
+      m_rib.insert(prefix, route);
+      expectedFace2.push_back(prefix);
+    }
+  }
+  std::sort(expectedAll.begin(), expectedAll.end());
+  std::sort(expectedFace2.begin(), expectedFace2.end());
+  std::sort(expectedUnderA.begin(), expectedUnderA.end());
+
+  auto fetchAllPages = [this] (DatasetPageQuery query) {
+    std::vector<ndn::nfd::RibEntry> entries;
+    for (size_t nPages = 1; ; ++nPages) {
+      BOOST_REQUIRE_LT(nPages, 100);
+      receiveInterest(*makeInterest(Name("/localhost/nfd/rib/list").append(query.wireEncode()),
+                                    true));
+      Block content = m_responses.back().getContent();
+      content.parse();
+
+      optional<Block> cursor;
+      size_t nItems = 0;
+      for (const Block& element : content.elements()) {
+        BOOST_REQUIRE(!cursor); // cursor must be the last element
+        if (element.type() == TLV_DATASET_PAGE_CURSOR) {
+          cursor = element;
+        }
+        else {
+          entries.emplace_back(element);
+          ++nItems;
+        }
+      }
+      BOOST_CHECK_LE(nItems, query.getLimit());
+
+      if (!cursor) {
+        return entries;
+      }
+      query.setCursor(*cursor);
+    }
+  };
+  auto getNames = [] (const std::vector<ndn::nfd::RibEntry>& entries) {
+    std::vector<Name> names;
+    for (const auto& entry : entries) {
+      names.push_back(entry.getName());
+    }
+    return names;
+  };
+
+  // pages are returned in name order, without duplicates
+  auto names = getNames(fetchAllPages(DatasetPageQuery().setLimit(7)));
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expectedAll.begin(), expectedAll.end());
+
+  auto entries = fetchAllPages(DatasetPageQuery().setFaceId(2).setLimit(3));
+  for (const auto& entry : entries) {
+    BOOST_REQUIRE_EQUAL(entry.getRoutes().size(), 1);
+    BOOST_CHECK_EQUAL(entry.getRoutes().front().getFaceId(), 2);
+  }
+  names = getNames(entries);
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(),
+                                expectedFace2.begin(), expectedFace2.end());
+
+  names = getNames(fetchAllPages(DatasetPageQuery().setPrefix("/A").setLimit(6)));
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(),
+                                expectedUnderA.begin(), expectedUnderA.end());
+}
+
 BOOST_FIXTURE_TEST_SUITE(FaceMonitor, LocalhostAuthorizedRibManagerFixture)
 
 BOOST_AUTO_TEST_CASE(FetchActiveFacesEvent)
@@ -559,6 +740,71 @@ BOOST_AUTO_TEST_CASE(OnNotification)
   BOOST_CHECK_EQUAL(m_rib.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  std::string path = (boost::filesystem::current_path() / "rib-manager-snapshot-test.bin").string();
+  rib::RibSnapshotRoute savedA{"/snapshot-A", "udp4://224.0.23.170:56363", "udp4://10.0.0.1:56363", {}};
+  savedA.route.origin = ndn::nfd::ROUTE_ORIGIN_STATIC;
+  savedA.route.cost = 42;
+  rib::RibSnapshotRoute savedB{"/snapshot-B", "tcp4://10.0.0.2:6363", "tcp4://10.0.0.1:6363", {}};
+  rib::RibSnapshotRoute savedC{"/snapshot-C", "udp4://224.0.23.170:56363", "udp4://10.0.0.1:56363", {}};
+  savedC.route.origin = ndn::nfd::ROUTE_ORIGIN_STATIC;
+  savedC.route.cost = 10;
+  rib::RibSnapshot::save(path, {savedA, savedB, savedC});
+
+  m_manager.enableSnapshot(path, 60_s);
+  advanceClocks(1_ms);
+  BOOST_CHECK(std::any_of(m_face.sentInterests.begin(), m_face.sentInterests.end(),
+                          [] (const Interest& i) { return i.getName() == "/localhost/nfd/faces/list"; }));
+
+  // the face of /snapshot-A has reappeared with a different FaceId, but not the face of /snapshot-B
+  ndn::nfd::FaceStatus permanentFace;
+  permanentFace.setFaceId(300)
+               .setRemoteUri("udp4://224.0.23.170:56363")
+               .setLocalUri("udp4://10.0.0.1:56363")
+               .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+  ndn::nfd::FaceStatus onDemandFace;
+  onDemandFace.setFaceId(301)
+              .setRemoteUri("udp4://10.0.0.3:6363")
+              .setLocalUri("udp4://10.0.0.1:6363")
+              .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+
+  // /snapshot-C was registered again on the reappeared face before the snapshot was restored
+  auto parametersC = makeRegisterParameters("/snapshot-C", 300);
+  parametersC.setOrigin(ndn::nfd::ROUTE_ORIGIN_STATIC).setCost(20);
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register", parametersC));
+  advanceClocks(100_ms);
+
+  m_manager.removeInvalidFaces({permanentFace, onDemandFace});
+  advanceClocks(100_ms);
+
+  auto itA = m_rib.find("/snapshot-A");
+  BOOST_REQUIRE(itA != m_rib.end());
+  BOOST_REQUIRE(itA->second->hasFaceId(300));
+  BOOST_CHECK_EQUAL(itA->second->getRouteWithLowestCostByFaceId(300)->cost, 42);
+  BOOST_CHECK(m_rib.find("/snapshot-B") == m_rib.end());
+
+  // the saved route of /snapshot-C does not replace the route registered since
+  auto itC = m_rib.find("/snapshot-C");
+  BOOST_REQUIRE(itC != m_rib.end());
+  BOOST_CHECK_EQUAL(itC->second->getRoutes().size(), 1);
+  BOOST_CHECK_EQUAL(itC->second->getRouteWithLowestCostByFaceId(300)->cost, 20);
+
+  // only routes on permanent faces are saved
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/on-demand", 301)));
+  advanceClocks(100_ms);
+  m_manager.saveSnapshot();
+  auto saved = rib::RibSnapshot::load(path);
+  BOOST_REQUIRE_EQUAL(saved.size(), 2);
+  BOOST_CHECK_EQUAL(saved[0].prefix, "/snapshot-A");
+  BOOST_CHECK_EQUAL(saved[0].remoteUri, "udp4://224.0.23.170:56363");
+  BOOST_CHECK_EQUAL(saved[0].route.cost, 42);
+
+  m_manager.disableSnapshot();
+  boost::filesystem::remove(path);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // FaceMonitor
 
 BOOST_AUTO_TEST_SUITE_END() // TestRibManager
@@ -203,6 +203,55 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(CsSnapshot)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(tablesConfig.getCsSnapshotPath(), "");
+  BOOST_CHECK_EQUAL(tablesConfig.getCsSnapshotInterval(), 600_s);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path /var/lib/ndn/nfd/cs.snapshot
+      cs_snapshot_interval 30
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(tablesConfig.getCsSnapshotPath(), "");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(tablesConfig.getCsSnapshotPath(), "/var/lib/ndn/nfd/cs.snapshot");
+  BOOST_CHECK_EQUAL(tablesConfig.getCsSnapshotInterval(), 30_s);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInterval)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path /var/lib/ndn/nfd/cs.snapshot
+      cs_snapshot_interval 0
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsSnapshot
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
@@ -57,37 +57,30 @@ public:
 
 private:
   void
-  sendAddNextHopUpdate(const FibUpdate& update,
-                       const FibUpdateSuccessCallback& onSuccess,
-                       const FibUpdateFailureCallback& onFailure,
+  sendAddNextHopUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context,
                        uint32_t nTimeouts) override
   {
-    mockUpdate(update, onSuccess, onFailure, nTimeouts);
+    mockUpdate(update, context, nTimeouts);
   }
 
   void
-  sendRemoveNextHopUpdate(const FibUpdate& update,
-                          const FibUpdateSuccessCallback& onSuccess,
-                          const FibUpdateFailureCallback& onFailure,
+  sendRemoveNextHopUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context,
                           uint32_t nTimeouts) override
   {
-    mockUpdate(update, onSuccess, onFailure, nTimeouts);
+    mockUpdate(update, context, nTimeouts);
   }
 
   void
-  mockUpdate(const FibUpdate& update,
-             const FibUpdateSuccessCallback& onSuccess,
-             const FibUpdateFailureCallback& onFailure,
-             uint32_t nTimeouts)
+  mockUpdate(const FibUpdate& update, const shared_ptr<BatchContext>& context, uint32_t nTimeouts)
   {
     updates.push_back(update);
     getGlobalIoService().post([=] {
       if (mockSuccess) {
-        onUpdateSuccess(update, onSuccess, onFailure);
+        onUpdateSuccess(update, context);
       }
       else {
         ndn::mgmt::ControlResponse resp(504, "mocked failure");
-        onUpdateError(update, onSuccess, onFailure, resp, nTimeouts);
+        onUpdateError(update, context, resp, nTimeouts);
       }
     });
   }
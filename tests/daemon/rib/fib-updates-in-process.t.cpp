@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib/fib-updater.hpp"
+#include "rib/rib.hpp"
+#include "common/global.hpp"
+#include "fw/forwarder.hpp"
+#include "mgmt/command-authenticator.hpp"
+#include "mgmt/fib-manager.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/key-chain-fixture.hpp"
+#include "tests/daemon/rib-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "tests/daemon/rib/create-route.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <thread>
+
+namespace nfd {
+namespace rib {
+namespace tests {
+
+using namespace nfd::tests;
+
+class InProcessFibUpdatesFixture : public RibIoFixture, public KeyChainFixture
+{
+public:
+  InProcessFibUpdatesFixture()
+    : face(g_io, m_keyChain)
+    , dispatcher(face, m_keyChain)
+    , fibManager(forwarder.getFib(), faceTable, dispatcher, *authenticator)
+    , controller(face, m_keyChain)
+    , fibUpdater(make_unique<FibUpdater>(rib, controller))
+  {
+    fibUpdater->setInProcessFibManager(&fibManager);
+  }
+
+  /** \brief registers a route on the RIB thread, and polls both threads until it completes
+   *  \param destroyFibUpdater if true, the FibUpdater is destroyed right after the update
+   *                           is handed to the main thread
+   */
+  void
+  registerRoute(const Name& name, uint64_t faceId, bool destroyFibUpdater = false)
+  {
+    RibUpdate update;
+    update.setAction(RibUpdate::REGISTER)
+          .setName(name)
+          .setRoute(createRoute(faceId, 0, 10, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT));
+
+    runOnRibIoService([=] {
+      rib.beginApplyUpdate(update,
+        [this] {
+          ++nSuccesses;
+          callbackThread = std::this_thread::get_id();
+        },
+        [this] (uint32_t code, const std::string&) {
+          failureCodes.push_back(code);
+          callbackThread = std::this_thread::get_id();
+        });
+      if (destroyFibUpdater) {
+        fibUpdater.reset();
+      }
+    });
+    poll();
+  }
+
+public:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  ndn::util::DummyClientFace face;
+  ndn::mgmt::Dispatcher dispatcher;
+  shared_ptr<CommandAuthenticator> authenticator = CommandAuthenticator::create();
+  FibManager fibManager;
+
+  ndn::nfd::Controller controller;
+  Rib rib;
+  unique_ptr<FibUpdater> fibUpdater;
+
+  size_t nSuccesses = 0;
+  std::vector<uint32_t> failureCodes;
+  std::thread::id callbackThread;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestFibUpdatesInProcess, InProcessFibUpdatesFixture)
+
+BOOST_AUTO_TEST_CASE(Success)
+{
+  auto dummyFace = make_shared<DummyFace>();
+  faceTable.add(dummyFace);
+
+  registerRoute("/a", dummyFace->getId());
+
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+  BOOST_CHECK_EQUAL(failureCodes.size(), 0);
+  // the update is applied on the main thread, and the callback is invoked on the RIB thread
+  BOOST_CHECK(callbackThread == g_ribThread.get_id());
+  const fib::Entry* fibEntry = forwarder.getFib().findExactMatch("/a");
+  BOOST_REQUIRE(fibEntry != nullptr);
+  BOOST_CHECK(fibEntry->hasNextHop(*dummyFace));
+  BOOST_CHECK(rib.find("/a") != rib.end());
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0); // no control commands involved
+}
+
+BOOST_AUTO_TEST_CASE(BatchFaceNotFound)
+{
+  registerRoute("/a", 9999);
+
+  BOOST_CHECK_EQUAL(nSuccesses, 0);
+  BOOST_REQUIRE_EQUAL(failureCodes.size(), 1);
+  BOOST_CHECK_EQUAL(failureCodes.front(), 410);
+  BOOST_CHECK(callbackThread == g_ribThread.get_id());
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/a") == nullptr);
+  BOOST_CHECK(rib.find("/a") == rib.end());
+}
+
+BOOST_AUTO_TEST_CASE(DestroyedBeforeCompletion)
+{
+  auto dummyFace = make_shared<DummyFace>();
+  faceTable.add(dummyFace);
+
+  registerRoute("/a", dummyFace->getId(), true);
+
+  // the updates still reach the FIB, but the callbacks are discarded on the RIB thread
+  BOOST_CHECK(fibUpdater == nullptr);
+  BOOST_CHECK_EQUAL(nSuccesses, 0);
+  BOOST_CHECK_EQUAL(failureCodes.size(), 0);
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/a") != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFibUpdatesInProcess
+
+} // namespace tests
+} // namespace rib
+} // namespace nfd
@@ -24,6 +24,7 @@
  */
 
 #include "rib/readvertise/nfd-rib-readvertise-destination.hpp"
+#include "core/route-batch.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/key-chain-fixture.hpp"
@@ -32,6 +33,8 @@
 #include <ndn-cxx/security/signing-info.hpp>
 #include <ndn-cxx/util/dummy-client-face.hpp>
 
+#include <deque>
+
 namespace nfd {
 namespace rib {
 namespace tests {
@@ -46,7 +49,7 @@ public:
     , nFailureCallbacks(0)
     , face(g_io, m_keyChain, {true, false})
     , controller(face, m_keyChain)
-    , dest(controller, rib, ndn::nfd::CommandOptions().setPrefix("/localhost/nlsr"))
+    , dest(face, m_keyChain, controller, rib, ndn::nfd::CommandOptions().setPrefix("/localhost/nlsr"))
     , successCallback([this] { nSuccessCallbacks++; })
     , failureCallback([this] (const std::string&) { nFailureCallbacks++; })
   {
@@ -225,6 +228,159 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(Withdraw, Scenario, WithdrawScenarios)
   scenario.checkCommandOutcome(this);
 }
 
+BOOST_AUTO_TEST_CASE(AdvertiseBatch)
+{
+  ReadvertisedRoute rrA("/A");
+  ReadvertisedRoute rrB("/B");
+  ReadvertisedRoute rrC("/C");
+  rrC.signer = ndn::security::signingWithSha256();
+  std::vector<ReadvertiseDestination::BatchItem> items{
+    {&rrA, successCallback, failureCallback},
+    {&rrB, successCallback, failureCallback},
+    {&rrC, successCallback, failureCallback},
+  };
+  const Name REGISTER_BATCH_COMMAND_PREFIX("/localhost/nlsr/rib/register-batch");
+  const Name RIB_REGISTER_COMMAND_PREFIX("/localhost/nlsr/rib/register");
+  const Name RIB_UNREGISTER_COMMAND_PREFIX("/localhost/nlsr/rib/unregister");
+
+  dest.setUseBatchCommands(true);
+  dest.advertiseBatch(items);
+  advanceClocks(10_ms);
+
+  // /A and /B share a signer and are sent in one command, /C has a different signer
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+  const Interest& batchInterest = face.sentInterests[0];
+  BOOST_REQUIRE(REGISTER_BATCH_COMMAND_PREFIX.isPrefixOf(batchInterest.getName()));
+  BOOST_CHECK(RIB_REGISTER_COMMAND_PREFIX.isPrefixOf(face.sentInterests[1].getName()));
+  BOOST_CHECK(!REGISTER_BATCH_COMMAND_PREFIX.isPrefixOf(face.sentInterests[1].getName()));
+
+  RouteBatchParameters batch(batchInterest.getName().get(REGISTER_BATCH_COMMAND_PREFIX.size()).blockFromValue());
+  BOOST_REQUIRE_EQUAL(batch.size(), 2);
+  BOOST_CHECK_EQUAL(batch.getRoutes()[0].getName(), "/A");
+  BOOST_CHECK_EQUAL(batch.getRoutes()[0].getOrigin(), ndn::nfd::ROUTE_ORIGIN_CLIENT);
+  BOOST_CHECK_EQUAL(batch.getRoutes()[1].getName(), "/B");
+
+  RouteBatchResults results;
+  results.addResult(ndn::nfd::ControlResponse(200, "OK").setBody(batch.getRoutes()[0].wireEncode()));
+  results.addResult(ndn::nfd::ControlResponse(403, "Not authenticated"));
+  auto responseData = makeData(batchInterest.getName());
+  responseData->setContent(ndn::nfd::ControlResponse(200, "OK").setBody(results.wireEncode()).wireEncode());
+  face.receive(*responseData);
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(nSuccessCallbacks, 1);
+  BOOST_CHECK_EQUAL(nFailureCallbacks, 1);
+
+  // when the batch command times out, the routes are sent again one by one
+  dest.withdrawBatch({items[0], items[1]});
+  advanceClocks(1_s, 11);
+  BOOST_CHECK_EQUAL(nSuccessCallbacks, 1);
+  BOOST_CHECK_EQUAL(nFailureCallbacks, 2); // the timeout of the /C command
+  BOOST_CHECK_EQUAL(dest.getUseBatchCommands(), false);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 5);
+  for (size_t i = 3; i < 5; ++i) {
+    const Name& name = face.sentInterests[i].getName();
+    BOOST_REQUIRE(RIB_UNREGISTER_COMMAND_PREFIX.isPrefixOf(name));
+    ControlParameters sentCp(name.get(RIB_UNREGISTER_COMMAND_PREFIX.size()).blockFromValue());
+    auto unregResponse = makeData(name);
+    unregResponse->setContent(ndn::nfd::ControlResponse(200, "OK")
+                              .setBody(ControlParameters()
+                                       .setName(sentCp.getName())
+                                       .setFaceId(1)
+                                       .setOrigin(ndn::nfd::ROUTE_ORIGIN_CLIENT)
+                                       .wireEncode())
+                              .wireEncode());
+    face.receive(*unregResponse);
+  }
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nSuccessCallbacks, 3);
+  BOOST_CHECK_EQUAL(nFailureCallbacks, 2);
+}
+
+BOOST_AUTO_TEST_CASE(AdvertiseBatchRejected)
+{
+  ReadvertisedRoute rrA("/A");
+  ReadvertisedRoute rrB("/B");
+  std::vector<ReadvertiseDestination::BatchItem> items{
+    {&rrA, successCallback, failureCallback},
+    {&rrB, successCallback, failureCallback},
+  };
+  const Name REGISTER_BATCH_COMMAND_PREFIX("/localhost/nlsr/rib/register-batch");
+
+  dest.setUseBatchCommands(true);
+  dest.advertiseBatch(items);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_REQUIRE(REGISTER_BATCH_COMMAND_PREFIX.isPrefixOf(face.sentInterests[0].getName()));
+
+  // a destination that does not know the command rejects it as a whole
+  auto responseData = makeData(face.sentInterests[0].getName());
+  responseData->setContent(ndn::nfd::ControlResponse(501, "Unknown command").wireEncode());
+  face.receive(*responseData);
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(nSuccessCallbacks, 0);
+  BOOST_CHECK_EQUAL(nFailureCallbacks, 0);
+  BOOST_CHECK_EQUAL(dest.getUseBatchCommands(), false);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 3);
+  BOOST_CHECK(!REGISTER_BATCH_COMMAND_PREFIX.isPrefixOf(face.sentInterests[1].getName()));
+  BOOST_CHECK(!REGISTER_BATCH_COMMAND_PREFIX.isPrefixOf(face.sentInterests[2].getName()));
+
+  // later batches are sent one by one right away
+  dest.advertiseBatch(items);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(BatchCommandsDisabled)
+{
+  ReadvertisedRoute rrA("/A");
+  ReadvertisedRoute rrB("/B");
+  const Name RIB_REGISTER_COMMAND_PREFIX("/localhost/nlsr/rib/register");
+
+  BOOST_CHECK_EQUAL(dest.getUseBatchCommands(), false);
+  dest.advertiseBatch({{&rrA, successCallback, failureCallback},
+                       {&rrB, successCallback, failureCallback}});
+  advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+  for (const Interest& interest : face.sentInterests) {
+    BOOST_CHECK(RIB_REGISTER_COMMAND_PREFIX.isPrefixOf(interest.getName()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AdvertiseBatchSizeLimit)
+{
+  // long prefixes fill a command before RouteBatchParameters::MAX_ROUTES is reached
+  std::deque<ReadvertisedRoute> routes;
+  for (int i = 0; i < 100; ++i) {
+    routes.emplace_back(Name("/long").append(std::string(60, 'x')).appendNumber(i));
+  }
+  std::vector<ReadvertiseDestination::BatchItem> items;
+  for (const auto& rr : routes) {
+    items.push_back({&rr, successCallback, failureCallback});
+  }
+  const Name REGISTER_BATCH_COMMAND_PREFIX("/localhost/nlsr/rib/register-batch");
+
+  dest.setUseBatchCommands(true);
+  dest.advertiseBatch(items);
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_GT(face.sentInterests.size(), 100 / RouteBatchParameters::MAX_ROUTES + 1);
+  size_t nRoutes = 0;
+  for (const Interest& interest : face.sentInterests) {
+    BOOST_CHECK_LE(interest.wireEncode().size(), ndn::MAX_NDN_PACKET_SIZE);
+    BOOST_REQUIRE(REGISTER_BATCH_COMMAND_PREFIX.isPrefixOf(interest.getName()));
+    RouteBatchParameters batch(interest.getName().get(REGISTER_BATCH_COMMAND_PREFIX.size()).blockFromValue());
+    BOOST_CHECK(batch.isValid());
+    for (const auto& route : batch.getRoutes()) {
+      BOOST_CHECK_EQUAL(route.getName(), routes.at(nRoutes).prefix);
+      ++nRoutes;
+    }
+  }
+  BOOST_CHECK_EQUAL(nRoutes, routes.size());
+}
+
 BOOST_AUTO_TEST_CASE(DestinationAvailability)
 {
   std::vector<bool> availabilityChangeHistory;
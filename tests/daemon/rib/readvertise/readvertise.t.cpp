@@ -95,6 +95,13 @@ public:
     }
   }
 
+  void
+  advertiseBatch(const std::vector<BatchItem>& items) override
+  {
+    advertiseBatchSizes.push_back(items.size());
+    ReadvertiseDestination::advertiseBatch(items);
+  }
+
   void
   setAvailability(bool isAvailable)
   {
@@ -111,6 +118,7 @@ public:
   bool shouldSucceed = true;
   std::vector<HistoryEntry> advertiseHistory;
   std::vector<HistoryEntry> withdrawHistory;
+  std::vector<size_t> advertiseBatchSizes;
 };
 
 class ReadvertiseFixture : public GlobalIoTimeFixture, public KeyChainFixture
@@ -160,6 +168,8 @@ protected:
 
 private:
   ndn::util::DummyClientFace m_face;
+
+protected:
   Rib m_rib;
 };
 
@@ -298,6 +308,71 @@ BOOST_AUTO_TEST_CASE(ChangeDuringRetry)
   BOOST_CHECK_EQUAL(destination->withdrawHistory.size(), 0); // don't try to withdraw
 }
 
+BOOST_AUTO_TEST_CASE(BatchRateLimit)
+{
+  readvertise->setBatchLimits(4, 8);
+
+  Route route;
+  route.faceId = 1;
+  route.origin = ndn::nfd::ROUTE_ORIGIN_CLIENT;
+  for (int i = 0; i < 10; ++i) {
+    Name prefix = Name("/P").appendNumber(i);
+    policy->decision = ReadvertiseAction{prefix, ndn::security::SigningInfo()};
+    m_rib.insert(prefix, route);
+  }
+  BOOST_CHECK_EQUAL(readvertise->getQueueDepth(), 10);
+
+  // the first batch uses the initial tokens
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 4);
+  BOOST_CHECK_EQUAL(readvertise->getQueueDepth(), 6);
+
+  // the next full batch needs 4 tokens, which take 500ms at 8 changes per second
+  this->advanceClocks(100_ms, 4);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 4);
+  this->advanceClocks(100_ms, 2);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 8);
+  this->advanceClocks(100_ms, 3);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 10);
+  BOOST_CHECK_EQUAL(readvertise->getQueueDepth(), 0);
+
+  std::vector<size_t> expectedSizes{4, 4, 2};
+  BOOST_CHECK_EQUAL_COLLECTIONS(destination->advertiseBatchSizes.begin(),
+                                destination->advertiseBatchSizes.end(),
+                                expectedSizes.begin(), expectedSizes.end());
+}
+
+BOOST_AUTO_TEST_CASE(DeltaCompression)
+{
+  Route route;
+  route.faceId = 1;
+  route.origin = ndn::nfd::ROUTE_ORIGIN_CLIENT;
+  policy->decision = ReadvertiseAction{"/A", ndn::security::SigningInfo()};
+
+  // advertise+withdraw before the batch is sent: nothing to send
+  m_rib.insert("/A/1", route);
+  m_rib.erase("/A/1", route);
+  this->advanceClocks(6_ms);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 0);
+  BOOST_CHECK_EQUAL(destination->withdrawHistory.size(), 0);
+  BOOST_CHECK_EQUAL(readvertise->getQueueDepth(), 0);
+
+  this->insertRoute("/A/1", 1, ndn::nfd::ROUTE_ORIGIN_CLIENT);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 1);
+
+  // withdraw+advertise of an advertised route before the batch is sent: nothing to send
+  m_rib.erase("/A/1", route);
+  m_rib.insert("/A/2", route);
+  BOOST_CHECK_EQUAL(readvertise->getQueueDepth(), 1);
+  this->advanceClocks(6_ms);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 1);
+  BOOST_CHECK_EQUAL(destination->withdrawHistory.size(), 0);
+
+  // the route is still refreshed
+  this->advanceClocks(1_s, 61);
+  BOOST_CHECK_EQUAL(destination->advertiseHistory.size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestReadvertise
 BOOST_AUTO_TEST_SUITE_END() // Readvertise
 
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib/rib-snapshot.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace nfd {
+namespace rib {
+namespace tests {
+
+using namespace nfd::tests;
+
+class RibSnapshotFixture : public GlobalIoTimeFixture
+{
+public:
+  RibSnapshotFixture()
+    : path((boost::filesystem::current_path() / "rib-snapshot-test.bin").string())
+  {
+    boost::filesystem::remove(path);
+  }
+
+  ~RibSnapshotFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+  static RibSnapshotRoute
+  makeRoute(const Name& prefix, const std::string& remoteUri, uint64_t cost,
+            optional<time::nanoseconds> lifetime = nullopt)
+  {
+    RibSnapshotRoute r;
+    r.prefix = prefix;
+    r.remoteUri = remoteUri;
+    r.localUri = "dev://eth0";
+    r.route.faceId = 300;
+    r.route.origin = ndn::nfd::ROUTE_ORIGIN_STATIC;
+    r.route.cost = cost;
+    r.route.flags = ndn::nfd::ROUTE_FLAG_CAPTURE;
+    if (lifetime) {
+      r.route.expires = time::steady_clock::now() + *lifetime;
+    }
+    return r;
+  }
+
+protected:
+  std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestRibSnapshot, RibSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(SaveLoad)
+{
+  std::vector<RibSnapshotRoute> routes{
+    makeRoute("/A", "ether://[01:00:5e:00:17:aa]", 10),
+    makeRoute("/B/C", "udp4://224.0.23.170:56363", 20, 1_h),
+    makeRoute("/D", "udp4://224.0.23.170:56363", 30, 10_s),
+  };
+  RibSnapshot::save(path, routes);
+  BOOST_CHECK(!boost::filesystem::exists(path + ".tmp"));
+
+  this->advanceClocks(1_s, 20);
+  auto loaded = RibSnapshot::load(path);
+
+  // /D has expired
+  BOOST_REQUIRE_EQUAL(loaded.size(), 2);
+  BOOST_CHECK_EQUAL(loaded[0].prefix, "/A");
+  BOOST_CHECK_EQUAL(loaded[0].remoteUri, "ether://[01:00:5e:00:17:aa]");
+  BOOST_CHECK_EQUAL(loaded[0].localUri, "dev://eth0");
+  BOOST_CHECK_EQUAL(loaded[0].route.faceId, 0);
+  BOOST_CHECK_EQUAL(loaded[0].route.origin, ndn::nfd::ROUTE_ORIGIN_STATIC);
+  BOOST_CHECK_EQUAL(loaded[0].route.cost, 10);
+  BOOST_CHECK_EQUAL(loaded[0].route.flags, ndn::nfd::ROUTE_FLAG_CAPTURE);
+  BOOST_CHECK(!loaded[0].route.expires);
+
+  BOOST_CHECK_EQUAL(loaded[1].prefix, "/B/C");
+  BOOST_CHECK_EQUAL(loaded[1].route.cost, 20);
+  BOOST_REQUIRE(loaded[1].route.expires);
+  BOOST_CHECK_EQUAL(*loaded[1].route.expires, time::steady_clock::now() + 1_h - 20_s);
+
+  // saving again replaces the previous snapshot
+  RibSnapshot::save(path, {});
+  BOOST_CHECK_EQUAL(RibSnapshot::load(path).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Corrupted)
+{
+  BOOST_CHECK_THROW(RibSnapshot::load(path), RibSnapshot::Error); // missing
+
+  RibSnapshot::save(path, {makeRoute("/A", "udp4://224.0.23.170:56363", 10)});
+  auto size = boost::filesystem::file_size(path);
+
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(size) - 1);
+    file.put('\xff');
+  }
+  BOOST_CHECK_THROW(RibSnapshot::load(path), RibSnapshot::Error); // checksum mismatch
+
+  boost::filesystem::resize_file(path, size - 1);
+  BOOST_CHECK_THROW(RibSnapshot::load(path), RibSnapshot::Error); // truncated
+
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "NFDRIB not a snapshot at all";
+  }
+  BOOST_CHECK_THROW(RibSnapshot::load(path), RibSnapshot::Error); // bad magic
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRibSnapshot
+
+} // namespace tests
+} // namespace rib
+} // namespace nfd
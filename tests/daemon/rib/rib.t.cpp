@@ -28,6 +28,7 @@
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
 #include "tests/daemon/rib/create-route.hpp"
+#include "tests/daemon/rib/fib-updates-common.hpp"
 
 namespace nfd {
 namespace rib {
@@ -100,6 +101,48 @@ BOOST_AUTO_TEST_CASE(Children)
   BOOST_CHECK_EQUAL((rib.find(name3)->second)->getParent()->getName(), name4);
 }
 
+BOOST_AUTO_TEST_CASE(ChildrenNested)
+{
+  rib::Rib rib;
+
+  rib.insert("/a/b", createRoute(1, 20));
+  rib.insert("/a/b/c", createRoute(2, 20));
+  rib.insert("/a/d", createRoute(3, 20));
+  rib.insert("/ab", createRoute(4, 20));
+  rib.insert("/x", createRoute(5, 20));
+
+  // the new entry adopts only its nearest descendants, without a parent entry in the RIB
+  rib.insert("/a", createRoute(6, 20));
+
+  auto a = rib.find("/a")->second;
+  BOOST_CHECK(a->getParent() == nullptr);
+  BOOST_REQUIRE_EQUAL(a->getChildren().size(), 2);
+  BOOST_CHECK_EQUAL(a->getChildren().front()->getName(), "/a/b");
+  BOOST_CHECK_EQUAL(a->getChildren().back()->getName(), "/a/d");
+  BOOST_CHECK(rib.find("/a/b/c")->second->getParent() == rib.find("/a/b")->second);
+  BOOST_CHECK(rib.find("/ab")->second->getParent() == nullptr);
+
+  // the new entry takes over a subset of an existing parent's children
+  rib.insert("/", createRoute(7, 20));
+  auto root = rib.find("/")->second;
+  BOOST_CHECK_EQUAL(root->getChildren().size(), 3);
+
+  rib.insert("/a/b/c/d", createRoute(8, 20));
+  rib.insert("/a/b/e", createRoute(9, 20));
+  rib.insert("/a/b/c/f", createRoute(10, 20));
+  rib.erase("/a/b/c", createRoute(2, 20));
+  BOOST_CHECK_EQUAL(rib.find("/a/b")->second->getChildren().size(), 3);
+
+  rib.insert("/a/b/c", createRoute(2, 20));
+  auto c = rib.find("/a/b/c")->second;
+  BOOST_CHECK_EQUAL(c->getChildren().size(), 2);
+  BOOST_CHECK(rib.find("/a/b/c/d")->second->getParent() == c);
+  BOOST_CHECK(rib.find("/a/b/c/f")->second->getParent() == c);
+  BOOST_REQUIRE_EQUAL(rib.find("/a/b")->second->getChildren().size(), 2);
+  BOOST_CHECK(rib.find("/a/b/e")->second->getParent() == rib.find("/a/b")->second);
+  BOOST_CHECK_EQUAL(root->getChildren().size(), 3);
+}
+
 BOOST_AUTO_TEST_CASE(EraseFace)
 {
   rib::Rib rib;
@@ -331,6 +374,170 @@ RibEntry {
   BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(rib), ribStr);
 }
 
+class UpdateQueueFixture : public FibUpdatesFixture
+{
+public:
+  void
+  beginUpdate(RibUpdate::Action action, const Name& name, uint64_t faceId)
+  {
+    RibUpdate update;
+    update.setAction(action)
+          .setName(name)
+          .setRoute(createRoute(faceId, ndn::nfd::ROUTE_ORIGIN_APP, 10, 0));
+    rib.beginApplyUpdate(update, [this] { ++nSuccesses; }, nullptr);
+  }
+
+  bool
+  hasFibUpdate(const Name& name) const
+  {
+    return std::any_of(getFibUpdates().begin(), getFibUpdates().end(),
+                       [&] (const FibUpdate& update) { return update.name == name; });
+  }
+
+public:
+  size_t nSuccesses = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UpdateQueue, UpdateQueueFixture)
+
+BOOST_AUTO_TEST_CASE(Pipelining)
+{
+  beginUpdate(RibUpdate::REGISTER, "/A", 1);
+  beginUpdate(RibUpdate::REGISTER, "/B", 2);
+  beginUpdate(RibUpdate::REGISTER, "/A/B", 3);
+  beginUpdate(RibUpdate::REGISTER, "/C", 4);
+
+  // /A, /B, and /C are in progress together; /A/B waits for /A
+  BOOST_CHECK(hasFibUpdate("/A"));
+  BOOST_CHECK(hasFibUpdate("/B"));
+  BOOST_CHECK(!hasFibUpdate("/A/B"));
+  BOOST_CHECK(hasFibUpdate("/C"));
+
+  pollIo();
+  BOOST_CHECK(hasFibUpdate("/A/B"));
+  BOOST_CHECK_EQUAL(nSuccesses, 4);
+  BOOST_CHECK_EQUAL(rib.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Window)
+{
+  rib.setMaxInFlightBatches(1);
+  beginUpdate(RibUpdate::REGISTER, "/A", 1);
+  beginUpdate(RibUpdate::REGISTER, "/B", 2);
+  BOOST_CHECK(hasFibUpdate("/A"));
+  BOOST_CHECK(!hasFibUpdate("/B"));
+
+  pollIo();
+  BOOST_CHECK(hasFibUpdate("/B"));
+  BOOST_CHECK_EQUAL(nSuccesses, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Coalescing)
+{
+  rib.setMaxInFlightBatches(1);
+  beginUpdate(RibUpdate::REGISTER, "/A", 1);
+  // the following are queued behind /A, and the unregistration supersedes the registration
+  beginUpdate(RibUpdate::REGISTER, "/B", 2);
+  beginUpdate(RibUpdate::UNREGISTER, "/B", 2);
+
+  pollIo();
+  BOOST_CHECK(!hasFibUpdate("/B"));
+  BOOST_CHECK_EQUAL(nSuccesses, 3);
+  BOOST_CHECK_EQUAL(rib.size(), 1);
+  BOOST_CHECK(rib.find("/B") == rib.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UpdateQueue
+
+class ExpirationFixture : public UpdateQueueFixture, public ClockFixture
+{
+public:
+  ExpirationFixture()
+    : ClockFixture(g_io)
+  {
+    rib.setExpirationTick(1_s);
+  }
+
+  void
+  registerExpiringRoute(const Name& name, uint64_t faceId, time::nanoseconds lifetime)
+  {
+    Route route = createRoute(faceId, ndn::nfd::ROUTE_ORIGIN_APP, 10, 0);
+    route.expires = time::steady_clock::now() + lifetime;
+
+    RibUpdate update;
+    update.setAction(RibUpdate::REGISTER)
+          .setName(name)
+          .setRoute(route);
+    rib.beginApplyUpdate(update, nullptr, nullptr);
+    pollIo();
+  }
+
+  size_t
+  getNWheelElements() const
+  {
+    size_t n = 0;
+    for (const auto& slot : rib.m_expirationWheel) {
+      n += slot.second.size();
+    }
+    return n;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(ExpirationWheel, ExpirationFixture)
+{
+  // start at the beginning of a slot
+  advanceClocks(1_s - time::steady_clock::now().time_since_epoch() % 1_s);
+
+  registerExpiringRoute("/A", 1, 200_ms);
+  registerExpiringRoute("/A/B", 3, 300_ms);
+  registerExpiringRoute("/B", 2, 700_ms);
+  registerExpiringRoute("/C", 4, 1500_ms);
+  registerExpiringRoute("/B", 2, 1800_ms); // refresh
+  BOOST_CHECK_EQUAL(rib.size(), 4);
+
+  // routes are not removed before the end of their slot
+  advanceClocks(100_ms, 900_ms);
+  BOOST_CHECK_EQUAL(rib.size(), 4);
+
+  // /A and /A/B are related, so they are removed in separate batches; /B was refreshed
+  advanceClocks(100_ms, 200_ms);
+  BOOST_CHECK(rib.find("/A") == rib.end());
+  BOOST_CHECK(rib.find("/A/B") == rib.end());
+  BOOST_CHECK(rib.find("/B") != rib.end());
+  BOOST_CHECK(rib.find("/C") != rib.end());
+
+  clearFibUpdates();
+  advanceClocks(100_ms, 1_s);
+  BOOST_CHECK_EQUAL(rib.size(), 0);
+  BOOST_CHECK(hasFibUpdate("/B"));
+  BOOST_CHECK(hasFibUpdate("/C"));
+}
+
+BOOST_FIXTURE_TEST_CASE(ExpirationWheelRefresh, ExpirationFixture)
+{
+  advanceClocks(1_s - time::steady_clock::now().time_since_epoch() % 1_s);
+
+  // frequent refreshes do not add elements to the wheel
+  for (int i = 1; i <= 10; ++i) {
+    registerExpiringRoute("/R", 1, 500_ms + i * 1_s);
+  }
+  BOOST_CHECK_EQUAL(rib.size(), 1);
+  BOOST_CHECK_EQUAL(getNWheelElements(), 1);
+  BOOST_CHECK_EQUAL(rib.m_expirationWheel.size(), 1);
+
+  // when the original slot ends, the route is moved to the slot of its current expiration time
+  advanceClocks(100_ms, 2100_ms);
+  BOOST_CHECK(rib.find("/R") != rib.end());
+  BOOST_CHECK_EQUAL(getNWheelElements(), 1);
+
+  // the route expires at the end of that slot, not earlier
+  advanceClocks(100_ms, 8500_ms);
+  BOOST_CHECK(rib.find("/R") != rib.end());
+  advanceClocks(100_ms, 500_ms);
+  BOOST_CHECK(rib.find("/R") == rib.end());
+  BOOST_CHECK_EQUAL(getNWheelElements(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestRib
 
 } // namespace tests
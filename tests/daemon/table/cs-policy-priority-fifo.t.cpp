@@ -96,6 +96,24 @@ BOOST_FIXTURE_TEST_CASE(Refresh, CsFixture)
   CHECK_CS_FIND(0);
 }
 
+BOOST_FIXTURE_TEST_CASE(VisitEntries, CsFixture)
+{
+  cs.setPolicy(make_unique<PriorityFifoPolicy>());
+  cs.setLimit(5);
+
+  insert(1, "/A", [] (Data& data) { data.setFreshnessPeriod(99999_ms); });
+  insert(2, "/B", [] (Data& data) { data.setFreshnessPeriod(10_ms); });
+  insert(3, "/C", [] (Data& data) { data.setFreshnessPeriod(99999_ms); }, true);
+  insert(4, "/D", [] (Data& data) { data.setFreshnessPeriod(99999_ms); });
+  advanceClocks(11_ms);
+
+  // unsolicited, then stale, then fresh in FIFO order
+  std::vector<Name> names;
+  cs.getPolicy()->visitEntries([&] (Policy::EntryRef i) { names.push_back(i->getName()); });
+  std::vector<Name> expected{"/C", "/B", "/A", "/D"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCsPriorityFifo
 BOOST_AUTO_TEST_SUITE_END() // Table
 
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-snapshot.hpp"
+
+#include "tests/daemon/table/cs-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+class CsSnapshotFixture : public CsFixture
+{
+public:
+  CsSnapshotFixture()
+    : path((boost::filesystem::current_path() / "cs-snapshot-test.bin").string())
+  {
+    boost::filesystem::remove(path);
+  }
+
+  ~CsSnapshotFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+  /** \brief check the names of CS entries, in eviction order
+   */
+  void
+  checkEntries(const std::vector<Name>& expected) const
+  {
+    std::vector<Name> names;
+    cs.getPolicy()->visitEntries([&] (Policy::EntryRef i) { names.push_back(i->getName()); });
+    BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+  }
+
+  const Entry&
+  getEntry(const Name& name) const
+  {
+    auto it = std::find_if(cs.begin(), cs.end(),
+                           [&] (const Entry& entry) { return entry.getName() == name; });
+    BOOST_REQUIRE(it != cs.end());
+    return *it;
+  }
+
+  void
+  clear()
+  {
+    erase("/", cs.size());
+    BOOST_REQUIRE_EQUAL(cs.size(), 0);
+  }
+
+public:
+  const std::string path;
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsSnapshot, CsSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(SaveLoad)
+{
+  insert(1, "/A", [] (Data& data) { data.setFreshnessPeriod(10_s); });
+  insert(2, "/B", [] (Data& data) { data.setFreshnessPeriod(0_ms); });
+  insert(3, "/C", [] (Data& data) { data.setFreshnessPeriod(10_s); }, true);
+  startInterest("/A");
+  CHECK_CS_FIND(1); // /A becomes most recently used
+  checkEntries({"/B", "/C", "/A"});
+
+  advanceClocks(1_s, 4);
+  CsSnapshot snapshot(cs, path);
+  BOOST_CHECK_EQUAL(snapshot.save(), 3);
+
+  clear();
+  advanceClocks(1_s, 3); // downtime
+
+  snapshot.load();
+  BOOST_CHECK(snapshot.isLoading());
+  BOOST_CHECK_EQUAL(cs.size(), 0); // loading happens in the background
+  advanceClocks(1_ms);
+  BOOST_CHECK(!snapshot.isLoading());
+  BOOST_CHECK_EQUAL(snapshot.getNLoaded(), 3);
+  checkEntries({"/B", "/C", "/A"});
+
+  BOOST_CHECK_EQUAL(getEntry("/B").isFresh(), false);
+  BOOST_CHECK_EQUAL(getEntry("/C").isUnsolicited(), true);
+  BOOST_CHECK_EQUAL(getEntry("/A").isUnsolicited(), false);
+
+  // /A was saved with 6 seconds of freshness left, 3 of which were spent while stopped
+  advanceClocks(1_s, 2);
+  startInterest("/A").setMustBeFresh(true);
+  CHECK_CS_FIND(1);
+  advanceClocks(1_s, 2);
+  startInterest("/A").setMustBeFresh(true);
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(Chunks)
+{
+  for (uint32_t i = 1; i <= 5; ++i) {
+    insert(i, Name("/N").appendNumber(i));
+  }
+  CsSnapshot snapshot(cs, path, 2);
+  BOOST_CHECK_EQUAL(snapshot.save(), 5);
+  clear();
+
+  snapshot.load();
+  BOOST_CHECK(snapshot.isLoading());
+
+  // a Data packet that arrives while loading is newer than the snapshot; it has the same Name
+  // as a saved Data but different content, so the saved Data is skipped
+  insert(33, Name("/N").appendNumber(3));
+
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK(!snapshot.isLoading());
+  BOOST_CHECK_EQUAL(snapshot.getNLoaded(), 4);
+  BOOST_CHECK_EQUAL(cs.size(), 5);
+
+  startInterest(Name("/N").appendNumber(3));
+  CHECK_CS_FIND(33);
+}
+
+BOOST_AUTO_TEST_CASE(SaveInBackground)
+{
+  for (uint32_t i = 1; i <= 5; ++i) {
+    insert(i, Name("/N").appendNumber(i), [] (Data& data) { data.setFreshnessPeriod(10_s); });
+  }
+  CsSnapshot snapshot(cs, path, 2);
+  snapshot.startSave();
+  BOOST_CHECK(snapshot.isSaving());
+  BOOST_CHECK(!boost::filesystem::exists(path)); // records are written in the background
+
+  // entries taken at startSave() are written even if they are evicted meanwhile
+  clear();
+  insert(6, "/M");
+
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK(!snapshot.isSaving());
+  clear();
+
+  snapshot.load();
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK_EQUAL(snapshot.getNLoaded(), 5);
+  checkEntries({"/N/%01", "/N/%02", "/N/%03", "/N/%04", "/N/%05"});
+  BOOST_CHECK_EQUAL(getEntry("/N/%03").isFresh(), true);
+
+  // save() abandons an unfinished background save
+  snapshot.startSave();
+  BOOST_CHECK_EQUAL(snapshot.save(), 5);
+  BOOST_CHECK(!snapshot.isSaving());
+  BOOST_CHECK(!boost::filesystem::exists(path + ".tmp"));
+}
+
+BOOST_AUTO_TEST_CASE(SmallerLimit)
+{
+  insert(1, "/A");
+  insert(2, "/B");
+  insert(3, "/C");
+  CsSnapshot snapshot(cs, path);
+  BOOST_CHECK_EQUAL(snapshot.save(), 3);
+  clear();
+
+  // the entries that would be evicted last are retained
+  cs.setLimit(2);
+  snapshot.load();
+  advanceClocks(1_ms);
+  checkEntries({"/B", "/C"});
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  insert(1, "/A");
+  insert(2, "/B");
+  CsSnapshot snapshot(cs, path);
+  BOOST_CHECK_EQUAL(snapshot.save(), 2);
+  clear();
+
+  boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 1);
+  snapshot.load();
+  advanceClocks(1_ms);
+  BOOST_CHECK(!snapshot.isLoading());
+  BOOST_CHECK_EQUAL(snapshot.getNLoaded(), 1);
+  checkEntries({"/A"});
+}
+
+BOOST_AUTO_TEST_CASE(Invalid)
+{
+  CsSnapshot snapshot(cs, path);
+  BOOST_CHECK_THROW(snapshot.load(), CsSnapshot::Error);
+
+  std::ofstream(path) << "not a snapshot";
+  BOOST_CHECK_THROW(snapshot.load(), CsSnapshot::Error);
+  BOOST_CHECK(!snapshot.isLoading());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsSnapshot
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
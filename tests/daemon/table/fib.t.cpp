@@ -148,6 +148,29 @@ BOOST_AUTO_TEST_CASE(FibEntry)
   BOOST_CHECK(fib.findExactMatch(prefix) == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(AfterNewNextHop)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  Face* newNextHopFace = nullptr;
+  fib.afterNewNextHop.connect([&] (const Name&, const NextHop& nextHop) {
+    newNextHopFace = &nextHop.getFace();
+  });
+
+  Entry& entry = *fib.insert("/A").first;
+  fib.addOrUpdateNextHop(entry, *face1, 20);
+  BOOST_CHECK_EQUAL(newNextHopFace, face1.get());
+
+  // the signal carries the new nexthop even though sorting moved it before the existing one
+  fib.addOrUpdateNextHop(entry, *face2, 10);
+  BOOST_CHECK_EQUAL(newNextHopFace, face2.get());
+  BOOST_REQUIRE_EQUAL(entry.getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(&entry.getNextHops().front().getFace(), face2.get());
+}
+
 BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
 {
   NameTree nameTree;
@@ -226,6 +249,48 @@ BOOST_AUTO_TEST_CASE(LongestPrefixMatchWithPitEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchCached)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+  auto face1 = make_shared<DummyFace>();
+
+  fib.insert("/A");
+  shared_ptr<pit::Entry> pitSeg0 = pit.insert(*makeInterest("/A/B/obj/seg=0")).first;
+  shared_ptr<pit::Entry> pitSeg1 = pit.insert(*makeInterest("/A/B/obj/seg=1")).first;
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg0).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.getNCacheHits(), 0);
+  BOOST_CHECK_EQUAL(fib.getNCacheMisses(), 1);
+  // answered from the cache on /A/B/obj, filled by the previous lookup
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg1).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.getNCacheHits(), 1);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg1).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.getNCacheHits(), 2);
+  BOOST_CHECK_EQUAL(fib.getNCacheMisses(), 1);
+
+  // inserting a deeper entry invalidates cached results
+  Entry& entryAB = *fib.insert("/A/B").first;
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg0).getPrefix(), "/A/B");
+  BOOST_CHECK_EQUAL(fib.getNCacheMisses(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg1).getPrefix(), "/A/B");
+  BOOST_CHECK_EQUAL(fib.getNCacheHits(), 3);
+
+  // nexthop changes do not affect which entry is matched
+  fib.addOrUpdateNextHop(entryAB, *face1, 10);
+  BOOST_CHECK_EQUAL(&fib.findLongestPrefixMatch(*pitSeg0), &entryAB);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg0).getNextHops().size(), 1);
+
+  // removing the last nexthop erases the entry and invalidates cached results
+  fib.removeNextHop(entryAB, *face1);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg0).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg1).getPrefix(), "/A");
+
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg0).getPrefix(), "/"); // the empty entry
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitSeg0).hasNextHops(), false);
+}
+
 BOOST_AUTO_TEST_CASE(LongestPrefixMatchWithMeasurementsEntry)
 {
   NameTree nameTree;
@@ -245,6 +245,28 @@ BOOST_AUTO_TEST_CASE(Lifetime)
   BOOST_CHECK_EQUAL(measurements.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(LifetimeBatches)
+{
+  const size_t nEntries = Measurements::SWEEP_BATCH_SIZE * 2 + 10;
+  for (size_t i = 0; i < nEntries; ++i) {
+    Entry& entry = measurements.get(Name("/A").appendNumber(i));
+    if (i % 2 == 1) {
+      // extended repeatedly, only the last extension counts
+      measurements.extendLifetime(entry, 5_s);
+      measurements.extendLifetime(entry, 6_s);
+    }
+  }
+  BOOST_CHECK_EQUAL(measurements.size(), nEntries);
+
+  this->advanceClocks(100_ms, 5_s);
+  BOOST_CHECK_EQUAL(measurements.size(), nEntries / 2);
+  BOOST_CHECK(measurements.findExactMatch(Name("/A").appendNumber(0)) == nullptr);
+  BOOST_CHECK(measurements.findExactMatch(Name("/A").appendNumber(1)) != nullptr);
+
+  this->advanceClocks(100_ms, 2_s);
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
 {
   size_t nNameTreeEntriesBefore = nameTree.size();
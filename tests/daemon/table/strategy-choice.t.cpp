@@ -242,6 +242,33 @@ BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithPitEntry)
   BOOST_CHECK_EQUAL(this->findInstanceName(*pitFull), strategyNameQ);
 }
 
+BOOST_AUTO_TEST_CASE(FindEffectiveStrategyCached)
+{
+  BOOST_CHECK(sc.insert("/A", strategyNameP));
+
+  Pit& pit = forwarder.getPit();
+  shared_ptr<pit::Entry> pitABC = pit.insert(*makeInterest("/A/B/C")).first;
+  measurements::Entry& mAB = forwarder.getMeasurements().get("/A/B");
+
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameP);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameP);
+  // cached result is the same instance
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/A/B/C"));
+
+  BOOST_CHECK(sc.insert("/A/B", strategyNameQ));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameQ);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameQ);
+
+  // replace the strategy instance at an existing entry
+  BOOST_CHECK(sc.insert("/A/B", strategyNameP));
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/A/B"));
+  BOOST_CHECK_NE(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/A"));
+
+  sc.erase("/A/B");
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/A"));
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(mAB), &sc.findEffectiveStrategy("/A"));
+}
+
 BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithMeasurementsEntry)
 {
   BOOST_CHECK(sc.insert("/A", strategyNameP));
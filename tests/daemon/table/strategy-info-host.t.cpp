@@ -78,6 +78,24 @@ public:
   int m_id;
 };
 
+class DummyStrategyInfo3 : public StrategyInfo, noncopyable
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 3;
+  }
+
+  DummyStrategyInfo3(int id)
+    : m_id(id)
+  {
+  }
+
+public:
+  int m_id;
+};
+
 BOOST_AUTO_TEST_SUITE(Table)
 BOOST_FIXTURE_TEST_SUITE(TestStrategyInfoHost, GlobalIoFixture)
 
@@ -132,6 +150,52 @@ BOOST_AUTO_TEST_CASE(Types)
   BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ManyTypes)
+{
+  StrategyInfoHost host;
+  g_DummyStrategyInfo_count = 0;
+
+  host.insertStrategyInfo<DummyStrategyInfo>(7150);
+  host.insertStrategyInfo<DummyStrategyInfo2>(4275);
+  host.insertStrategyInfo<DummyStrategyInfo3>(2014);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 7150);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 4275);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo3>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo3>()->m_id, 2014);
+
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 1);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+
+  BOOST_CHECK_EQUAL(host.insertStrategyInfo<DummyStrategyInfo3>(4983).second, false);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo3>()->m_id, 2014);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo3>(), 1);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo3>() == nullptr);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo3>(), 0);
+
+  BOOST_CHECK_EQUAL(host.insertStrategyInfo<DummyStrategyInfo>(1181).second, true);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 1181);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 4275);
+
+  host.clearStrategyInfo();
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo2>() == nullptr);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(StorageReuse)
+{
+  StrategyInfoHost host;
+  DummyStrategyInfo2* info = host.insertStrategyInfo<DummyStrategyInfo2>(6316).first;
+  host.eraseStrategyInfo<DummyStrategyInfo2>();
+
+  // storage of a destroyed item is recycled for the next item of the same size
+  BOOST_CHECK_EQUAL(host.insertStrategyInfo<DummyStrategyInfo2>(3744).first, info);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 3744);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestStrategyInfoHost
 BOOST_AUTO_TEST_SUITE_END() // Table
 
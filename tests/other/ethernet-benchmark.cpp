@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/multicast-ethernet-transport.hpp"
+
+#include <ndn-cxx/net/network-monitor.hpp>
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <iomanip>
+#include <iostream>
+
+#include <sys/resource.h>
+
+namespace nfd {
+namespace tests {
+
+// number of frames in flight between the sending and the receiving face
+const size_t WINDOW = 256;
+// if nothing was received during this interval, assume the window was lost and resend it
+const time::milliseconds REFILL_INTERVAL = 10_ms;
+
+/** \brief Measures how many frames per second and per CPU core can be carried
+ *         between two Ethernet faces, with either the libpcap or the PACKET_MMAP backend.
+ *
+ *  The two faces are expected to be on the two ends of a veth pair, so that every frame sent
+ *  by one face is received by the other. Both faces live in this process.
+ */
+class EthernetBenchmark
+{
+public:
+  EthernetBenchmark(const std::string& txIfname, const std::string& rxIfname,
+                    face::EthernetTransport::IoBackend backend, time::seconds duration)
+    : m_duration(duration)
+    , m_interest(makeInterest())
+  {
+    ndn::net::NetworkMonitor netmon(getGlobalIoService());
+    if (netmon.getCapabilities() & ndn::net::NetworkMonitor::CAP_ENUM) {
+      netmon.onEnumerationCompleted.connect([] { getGlobalIoService().stop(); });
+      getGlobalIoService().run();
+      getGlobalIoService().reset();
+    }
+
+    auto txNetif = netmon.getNetworkInterface(txIfname);
+    auto rxNetif = netmon.getNetworkInterface(rxIfname);
+    if (txNetif == nullptr || rxNetif == nullptr) {
+      NDN_THROW(std::invalid_argument("Network interface not found"));
+    }
+
+    m_txFace = makeFace(*txNetif, backend);
+    m_rxFace = makeFace(*rxNetif, backend);
+    m_rxFace->afterReceiveInterest.connect([this] (const Interest&, const EndpointId&) {
+      ++m_nReceived;
+      if (m_nReceived == 1) {
+        start();
+      }
+      // keep the window full, one frame out for each frame in
+      m_txFace->sendInterest(m_interest, 0);
+    });
+  }
+
+  void
+  run()
+  {
+    getGlobalIoService().post([this] { sendWindow(); });
+    getGlobalIoService().run();
+
+    double cpuSeconds = getCpuTime() - m_startCpuTime;
+    double wallSeconds = time::duration_cast<time::duration<double>>(m_duration).count();
+    std::cout << std::fixed << std::setprecision(0)
+              << m_nReceived << " frames in " << wallSeconds << " s, "
+              << m_nReceived / wallSeconds << " frames/s, "
+              << m_nReceived / cpuSeconds << " frames/s per core" << std::endl;
+  }
+
+private:
+  static shared_ptr<Face>
+  makeFace(const ndn::net::NetworkInterface& netif, face::EthernetTransport::IoBackend backend)
+  {
+    auto transport = make_unique<face::MulticastEthernetTransport>(
+                       netif, ethernet::getDefaultMulticastAddress(),
+                       ndn::nfd::LINK_TYPE_MULTI_ACCESS, backend);
+    if (transport->getIoBackend() != backend) {
+      NDN_THROW(std::runtime_error("Cannot use the requested I/O backend on " + netif.getName()));
+    }
+    return make_shared<Face>(make_unique<face::GenericLinkService>(), std::move(transport));
+  }
+
+  static Interest
+  makeInterest()
+  {
+    Interest interest("/ethernet-benchmark/A/B/C/D");
+    interest.setCanBePrefix(false);
+    interest.wireEncode();
+    return interest;
+  }
+
+  static double
+  getCpuTime()
+  {
+    rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+  }
+
+  void
+  start()
+  {
+    m_startCpuTime = getCpuTime();
+    m_nReceived = 0;
+    getScheduler().schedule(m_duration, [] { getGlobalIoService().stop(); });
+    // frames may be dropped by the kernel, refill the window periodically
+    m_refillEvent = getScheduler().schedule(REFILL_INTERVAL, [this] { refill(); });
+  }
+
+  void
+  refill()
+  {
+    if (m_nReceived == m_nReceivedAtLastRefill) {
+      sendWindow();
+    }
+    m_nReceivedAtLastRefill = m_nReceived;
+    m_refillEvent = getScheduler().schedule(REFILL_INTERVAL, [this] { refill(); });
+  }
+
+  void
+  sendWindow()
+  {
+    for (size_t i = 0; i < WINDOW; ++i) {
+      m_txFace->sendInterest(m_interest, 0);
+    }
+  }
+
+private:
+  time::nanoseconds m_duration;
+  Interest m_interest;
+  shared_ptr<Face> m_txFace;
+  shared_ptr<Face> m_rxFace;
+  uint64_t m_nReceived = 0;
+  uint64_t m_nReceivedAtLastRefill = 0;
+  double m_startCpuTime = 0.0;
+  scheduler::ScopedEventId m_refillEvent;
+};
+
+} // namespace tests
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+#ifdef _DEBUG
+  std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+  if (argc < 4 || argc > 5) {
+    std::cerr << "Usage: " << argv[0] << " tx-ifname rx-ifname pcap|mmap [duration-seconds]" << std::endl;
+    return 2;
+  }
+
+  using nfd::face::EthernetTransport;
+  std::string backendName = argv[3];
+  EthernetTransport::IoBackend backend;
+  if (backendName == "pcap") {
+    backend = EthernetTransport::IoBackend::PCAP;
+  }
+  else if (backendName == "mmap") {
+    backend = EthernetTransport::IoBackend::MMAP;
+  }
+  else {
+    std::cerr << "ERROR: unknown I/O backend '" << backendName << "'" << std::endl;
+    return 2;
+  }
+
+  try {
+    auto duration = ndn::time::seconds(argc > 4 ? std::stoi(argv[4]) : 10);
+    nfd::tests::EthernetBenchmark bench(argv[1], argv[2], backend, duration);
+    bench.run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << boost::diagnostic_information(e);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "fw/forwarder.hpp"
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-link-service.hpp"
+#include "tests/daemon/face/dummy-transport.hpp"
+
+#include <iostream>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+using face::tests::DummyLinkService;
+using face::tests::DummyTransport;
+
+class ForwarderBenchmarkFixture
+{
+protected:
+  ForwarderBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    m_consumer = addFace();
+    m_producer = addFace();
+  }
+
+  /** \brief add a face whose link service does not record sent packets
+   */
+  shared_ptr<Face>
+  addFace()
+  {
+    auto face = make_shared<Face>(make_unique<DummyLinkService>(), make_unique<DummyTransport>());
+    getLinkService(*face).setPacketLogging(face::tests::LogNothing);
+    m_faceTable.add(face);
+    return face;
+  }
+
+  static DummyLinkService&
+  getLinkService(Face& face)
+  {
+    return static_cast<DummyLinkService&>(*face.getLinkService());
+  }
+
+  void
+  generatePacketsAndPopulateFib(size_t nPackets, size_t nFibEntries)
+  {
+    for (size_t i = 0; i < nFibEntries; ++i) {
+      Name prefix("/bench");
+      prefix.appendNumber(i);
+      fib::Entry& entry = *m_forwarder.getFib().insert(prefix).first;
+      m_forwarder.getFib().addOrUpdateNextHop(entry, *m_producer, 0);
+    }
+
+    for (size_t i = 0; i < nPackets; ++i) {
+      Name name("/bench");
+      name.appendNumber(i % nFibEntries).appendSegment(i);
+      interests.push_back(makeInterest(name));
+      interests.back()->getNonce(); // generate a Nonce outside of the measured loop
+      data.push_back(makeData(name));
+    }
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> data;
+
+  FaceTable m_faceTable;
+  Forwarder m_forwarder{m_faceTable};
+  shared_ptr<Face> m_consumer;
+  shared_ptr<Face> m_producer;
+};
+
+// This test case models the complete forwarding pipelines of a router with simple Interest-Data
+// exchanges: each Interest is received on one face, goes through the incoming Interest pipeline,
+// the default strategy and the outgoing Interest pipeline, and is answered on another face by a
+// Data packet that goes through the incoming and outgoing Data pipelines.
+// Under callgrind, divide the instruction count by nRoundTrip to obtain the number of
+// instructions per forwarded Interest/Data pair.
+BOOST_FIXTURE_TEST_CASE(InterestDataExchanges, ForwarderBenchmarkFixture)
+{
+  // number of Interest-Data exchanges
+  const size_t nRoundTrip = 500000;
+  // total amount of FIB entries, Interests are spread evenly among them
+  const size_t nFibEntries = 1000;
+  // how often pending timers (such as PIT entry expiration) are processed
+  const size_t pollInterval = 1000;
+
+  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries);
+  DummyLinkService& consumer = getLinkService(*m_consumer);
+  DummyLinkService& producer = getLinkService(*m_producer);
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  auto t1 = time::steady_clock::now();
+
+  for (size_t i = 0; i < nRoundTrip; ++i) {
+    consumer.receiveInterest(*interests[i], 0);
+    producer.receiveData(*data[i], 0);
+
+    if (i % pollInterval == 0) {
+      getGlobalIoService().poll();
+    }
+  }
+
+  auto t2 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  const auto& counters = m_forwarder.getCounters();
+  BOOST_CHECK_EQUAL(counters.nOutInterests, nRoundTrip);
+  BOOST_CHECK_EQUAL(counters.nOutData, nRoundTrip);
+
+  auto duration = time::duration_cast<time::nanoseconds>(t2 - t1);
+  std::cout << time::duration_cast<time::microseconds>(duration) << ", "
+            << duration.count() / nRoundTrip << " ns per Interest/Data pair" << std::endl;
+}
+
+} // namespace tests
+} // namespace nfd
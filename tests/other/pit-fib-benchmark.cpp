@@ -27,7 +27,9 @@
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <queue>
 
 #ifdef HAVE_VALGRIND
 #include <valgrind/callgrind.h>
@@ -149,5 +151,107 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
 }
 
+// This test case models a consumer fetching many segments of the same objects, e.g., a file
+// transfer. Each segment Interest creates a new PIT entry, whose name differs from the previous
+// ones only in its last component. The FIB lookup with the PIT entry can reuse the result cached
+// on the name tree entry of the object prefix, while a lookup by name has to hash and probe
+// every prefix of the Interest name. Both are timed to show the savings.
+BOOST_FIXTURE_TEST_CASE(SegmentFetch, PitFibBenchmarkFixture)
+{
+  // number of objects fetched concurrently
+  const size_t nObjects = 100;
+  // number of segments in each object
+  const size_t nSegments = 10000;
+  // total amount of FIB entries, objects are spread evenly among them
+  const size_t nFibEntries = 20;
+  // number of name components between the FIB prefix and the segment number
+  const size_t objectNameLength = 3;
+  // number of pending Interests, across all objects
+  const size_t windowSize = nObjects * 8;
+
+  for (size_t i = 0; i < nFibEntries; ++i) {
+    m_fib.insert(Name("/fib").appendNumber(i));
+  }
+
+  std::vector<Name> objectNames;
+  for (size_t i = 0; i < nObjects; ++i) {
+    Name name("/fib");
+    name.appendNumber(i % nFibEntries);
+    for (size_t j = 0; j < objectNameLength; ++j) {
+      name.appendNumber(i);
+    }
+    objectNames.push_back(name);
+  }
+
+  for (size_t seg = 0; seg < nSegments; ++seg) {
+    for (const auto& objectName : objectNames) {
+      interests.push_back(make_shared<Interest>(Name(objectName).appendSegment(seg)));
+    }
+  }
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  auto t1 = time::steady_clock::now();
+
+  // FIB lookup by name, repeated for every segment
+  for (const auto& interest : interests) {
+    m_fib.findLongestPrefixMatch(interest->getName());
+  }
+
+  auto t2 = time::steady_clock::now();
+  auto nHitsBefore = m_fib.getNCacheHits();
+  auto nMissesBefore = m_fib.getNCacheMisses();
+
+  // PIT insert, then FIB lookup with the PIT entry; PIT entries are erased once they leave
+  // the window, so that each object has several segments pending at any time
+  std::queue<shared_ptr<pit::Entry>> pending;
+  for (const auto& interest : interests) {
+    auto pitEntry = m_pit.insert(*interest).first;
+    m_fib.findLongestPrefixMatch(*pitEntry);
+    pending.push(pitEntry);
+    if (pending.size() > windowSize) {
+      m_pit.erase(pending.front().get());
+      pending.pop();
+    }
+  }
+
+  auto t3 = time::steady_clock::now();
+  auto nHits = m_fib.getNCacheHits() - nHitsBefore;
+  auto nMisses = m_fib.getNCacheMisses() - nMissesBefore;
+
+  for (; !pending.empty(); pending.pop()) {
+    m_pit.erase(pending.front().get());
+  }
+
+  auto t4 = time::steady_clock::now();
+
+  // PIT insert only, to isolate the cost of the FIB lookup with the PIT entry
+  for (const auto& interest : interests) {
+    auto pitEntry = m_pit.insert(*interest).first;
+    pending.push(pitEntry);
+    if (pending.size() > windowSize) {
+      m_pit.erase(pending.front().get());
+      pending.pop();
+    }
+  }
+
+  auto t5 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  auto nLookups = interests.size();
+  auto byName = time::duration_cast<time::nanoseconds>(t2 - t1);
+  auto withPitEntry = time::duration_cast<time::nanoseconds>((t3 - t2) - (t5 - t4));
+  std::cout << "FIB lookup by name: " << byName.count() / nLookups << " ns per Interest\n"
+            << "FIB lookup with PIT entry: " << withPitEntry.count() / nLookups << " ns per Interest\n"
+            << "FIB cache: " << nHits << " hits, " << nMisses << " misses, hit rate "
+            << 100.0 * nHits / std::max<uint64_t>(nHits + nMisses, 1) << "%"
+            << std::endl;
+}
+
 } // namespace tests
 } // namespace nfd
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/tcp-channel.hpp"
+#include "face/udp-channel.hpp"
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <iomanip>
+#include <iostream>
+
+#include <sys/resource.h>
+
+namespace nfd {
+namespace tests {
+
+// number of packets in flight between the client and the server face
+const size_t WINDOW = 256;
+// if nothing was received during this interval, assume the window was lost and resend it
+const time::milliseconds REFILL_INTERVAL = 10_ms;
+
+/** \brief Measures how many packets per second and per CPU core can be carried
+ *         over a loopback UDP or TCP face.
+ *
+ *  Both ends of the face live in this process, so the CPU time includes the cost of
+ *  sending and receiving each packet. Comparing the results of builds configured with
+ *  and without `--with-io-uring` shows the effect of the I/O backend.
+ */
+class TransportBenchmark
+{
+public:
+  TransportBenchmark(const std::string& scheme, uint16_t port, time::seconds duration)
+    : m_scheme(scheme)
+    , m_duration(duration)
+    , m_interest(makeInterest())
+  {
+    auto loopback = boost::asio::ip::address_v4::loopback();
+    auto onFailure = [] (uint32_t status, const std::string& reason) {
+      NDN_THROW(std::runtime_error("Failed to create face: [" + to_string(status) + "] " + reason));
+    };
+
+    if (m_scheme == "udp4") {
+      auto server = make_unique<face::UdpChannel>(udp::Endpoint(loopback, port), 10_min, false);
+      auto client = make_unique<face::UdpChannel>(udp::Endpoint(loopback, port + 1), 10_min, false);
+      server->listen([this] (const auto& face) { this->onServerFaceCreated(face); }, onFailure);
+      client->connect(udp::Endpoint(loopback, port), {},
+                      [this] (const auto& face) { this->onClientFaceCreated(face); }, onFailure);
+      m_channels.push_back(std::move(server));
+      m_channels.push_back(std::move(client));
+    }
+    else if (m_scheme == "tcp4") {
+      auto determineScope = [] (auto&&...) { return ndn::nfd::FACE_SCOPE_NON_LOCAL; };
+      auto server = make_unique<face::TcpChannel>(tcp::Endpoint(loopback, port), false, determineScope);
+      auto client = make_unique<face::TcpChannel>(tcp::Endpoint(loopback, port + 1), false, determineScope);
+      server->listen([this] (const auto& face) { this->onServerFaceCreated(face); }, onFailure);
+      client->connect(tcp::Endpoint(loopback, port), {},
+                      [this] (const auto& face) { this->onClientFaceCreated(face); }, onFailure);
+      m_channels.push_back(std::move(server));
+      m_channels.push_back(std::move(client));
+    }
+    else {
+      NDN_THROW(std::invalid_argument("Unsupported protocol '" + m_scheme + "'"));
+    }
+  }
+
+  void
+  run()
+  {
+    getGlobalIoService().run();
+
+    double cpuSeconds = getCpuTime() - m_startCpuTime;
+    double wallSeconds = time::duration_cast<time::duration<double>>(m_duration).count();
+    std::cout << std::fixed << std::setprecision(0)
+              << m_scheme << ": " << m_nReceived << " packets in " << wallSeconds << " s, "
+              << m_nReceived / wallSeconds << " packets/s, "
+              << m_nReceived / cpuSeconds << " packets/s per core" << std::endl;
+  }
+
+private:
+  static Interest
+  makeInterest()
+  {
+    Interest interest("/transport-benchmark/A/B/C/D");
+    interest.setCanBePrefix(false);
+    interest.wireEncode();
+    return interest;
+  }
+
+  static double
+  getCpuTime()
+  {
+    rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+  }
+
+  void
+  onClientFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_clientFace = face;
+    // UDP server faces are created upon the first received packet
+    sendWindow();
+  }
+
+  void
+  onServerFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_serverFace = face;
+    face->afterReceiveInterest.connect([this] (const Interest&, const EndpointId&) {
+      ++m_nReceived;
+      if (m_nReceived == 1) {
+        start();
+      }
+      // keep the window full, one packet out for each packet in
+      m_clientFace->sendInterest(m_interest, 0);
+    });
+  }
+
+  void
+  start()
+  {
+    m_startCpuTime = getCpuTime();
+    m_nReceived = 0;
+    getScheduler().schedule(m_duration, [] { getGlobalIoService().stop(); });
+    // datagrams may be dropped by the kernel, refill the window periodically
+    m_refillEvent = getScheduler().schedule(REFILL_INTERVAL, [this] { refill(); });
+  }
+
+  void
+  refill()
+  {
+    if (m_nReceived == m_nReceivedAtLastRefill) {
+      sendWindow();
+    }
+    m_nReceivedAtLastRefill = m_nReceived;
+    m_refillEvent = getScheduler().schedule(REFILL_INTERVAL, [this] { refill(); });
+  }
+
+  void
+  sendWindow()
+  {
+    for (size_t i = 0; i < WINDOW; ++i) {
+      m_clientFace->sendInterest(m_interest, 0);
+    }
+  }
+
+private:
+  std::string m_scheme;
+  time::nanoseconds m_duration;
+  Interest m_interest;
+  std::vector<unique_ptr<face::Channel>> m_channels;
+  shared_ptr<Face> m_clientFace;
+  shared_ptr<Face> m_serverFace;
+  uint64_t m_nReceived = 0;
+  uint64_t m_nReceivedAtLastRefill = 0;
+  double m_startCpuTime = 0.0;
+  scheduler::ScopedEventId m_refillEvent;
+};
+
+} // namespace tests
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+#ifdef _DEBUG
+  std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+  if (argc < 2 || argc > 4) {
+    std::cerr << "Usage: " << argv[0] << " udp4|tcp4 [duration-seconds] [port]" << std::endl;
+    return 2;
+  }
+
+  try {
+    auto duration = ndn::time::seconds(argc > 2 ? std::stoi(argv[2]) : 10);
+    auto port = static_cast<uint16_t>(argc > 3 ? std::stoi(argv[3]) : 56363);
+    nfd::tests::TransportBenchmark bench(argv[1], port, duration);
+    bench.run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << boost::diagnostic_information(e);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/unix-stream-channel.hpp"
+
+#include "tests/daemon/face/shm-client.hpp"
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace tests {
+
+/** \brief Measures how many packets per second and per CPU core an application can send
+ *         to NFD over a Unix stream face, either through the socket or through the
+ *         shared-memory rings negotiated by face::tests::ShmClient.
+ *
+ *  The NFD side (a UnixStreamChannel and the faces it creates) runs on the main thread,
+ *  the application runs on a second thread and sends the same Interest as fast as the
+ *  face accepts it. The CPU time covers both threads.
+ */
+class UnixBenchmark
+{
+public:
+  UnixBenchmark(const std::string& mode, const std::string& path, time::seconds duration)
+    : m_mode(mode)
+    , m_path(path)
+    , m_duration(duration)
+    , m_channel(unix_stream::Endpoint(path), false)
+  {
+    if (m_mode != "socket" && m_mode != "shm") {
+      NDN_THROW(std::invalid_argument("Unsupported mode '" + m_mode + "'"));
+    }
+
+    m_channel.listen([this] (const shared_ptr<Face>& face) { this->onFaceCreated(face); },
+                     [] (uint32_t status, const std::string& reason) {
+                       NDN_THROW(std::runtime_error("Accept failed: [" + to_string(status) + "] " +
+                                                    reason));
+                     });
+  }
+
+  void
+  run()
+  {
+    std::thread app([this] { runApplication(); });
+    getGlobalIoService().run();
+    m_shouldStop = true;
+    app.join();
+
+    if (!m_error.empty()) {
+      NDN_THROW(std::runtime_error(m_error));
+    }
+
+    double cpuSeconds = getCpuTime() - m_startCpuTime;
+    double wallSeconds = time::duration_cast<time::duration<double>>(m_duration).count();
+    std::cout << std::fixed << std::setprecision(0)
+              << m_mode << ": " << m_nReceived << " packets in " << wallSeconds << " s, "
+              << m_nReceived / wallSeconds << " packets/s, "
+              << m_nReceived / cpuSeconds << " packets/s per core" << std::endl;
+  }
+
+private:
+  static double
+  getCpuTime()
+  {
+    rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+  }
+
+  void
+  onFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_face = face;
+    face->afterReceiveInterest.connect([this] (const Interest&, const EndpointId&) {
+      ++m_nReceived;
+      if (m_nReceived == 1) {
+        m_startCpuTime = getCpuTime();
+        m_nReceived = 0;
+        getScheduler().schedule(m_duration, [] { getGlobalIoService().stop(); });
+      }
+    });
+  }
+
+  /** \brief the application thread
+   */
+  void
+  runApplication()
+  {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    try {
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+      m_path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+      if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        NDN_THROW(std::runtime_error("Cannot connect to " + m_path));
+      }
+
+      Interest interest("/unix-benchmark/A/B/C/D");
+      interest.setCanBePrefix(false);
+      const Block& wire = interest.wireEncode();
+
+      if (m_mode == "shm") {
+        face::tests::ShmClient client(fd, 1 << 22);
+        while (!m_shouldStop) {
+          if (!client.send(wire)) {
+            // the ring is full, let NFD catch up
+            std::this_thread::yield();
+          }
+        }
+      }
+      else {
+        while (!m_shouldStop) {
+          ssize_t nSent = ::send(fd, wire.wire(), wire.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+          if (nSent < 0) {
+            pollfd pfd{fd, POLLOUT, 0};
+            ::poll(&pfd, 1, 10);
+          }
+          else if (static_cast<size_t>(nSent) < wire.size()) {
+            // finish the partially written packet, so that the stream stays aligned
+            ::send(fd, wire.wire() + nSent, wire.size() - nSent, MSG_NOSIGNAL);
+          }
+        }
+      }
+    }
+    catch (const std::exception& e) {
+      m_error = e.what();
+      getGlobalIoService().post([] { getGlobalIoService().stop(); });
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+private:
+  std::string m_mode;
+  std::string m_path;
+  time::nanoseconds m_duration;
+  face::UnixStreamChannel m_channel;
+  shared_ptr<Face> m_face;
+  uint64_t m_nReceived = 0;
+  double m_startCpuTime = 0.0;
+  std::atomic<bool> m_shouldStop{false};
+  std::string m_error;
+};
+
+} // namespace tests
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+#ifdef _DEBUG
+  std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+  if (argc < 2 || argc > 4) {
+    std::cerr << "Usage: " << argv[0] << " socket|shm [duration-seconds] [socket-path]" << std::endl;
+    return 2;
+  }
+
+  try {
+    auto duration = ndn::time::seconds(argc > 2 ? std::stoi(argv[2]) : 10);
+    std::string path = argc > 3 ? argv[3] : "/tmp/nfd-unix-benchmark.sock";
+    nfd::tests::UnixBenchmark bench(argv[1], path, duration);
+    bench.run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << boost::diagnostic_information(e);
+    return 1;
+  }
+
+  return 0;
+}
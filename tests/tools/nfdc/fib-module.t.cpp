@@ -24,6 +24,7 @@
  */
 
 #include "nfdc/fib-module.hpp"
+#include "core/dataset-page.hpp"
 
 #include "status-fixture.hpp"
 
@@ -88,7 +89,8 @@ BOOST_AUTO_TEST_CASE(Status)
   payload2.setPrefix("/localhost/nfd")
           .addNextHopRecord(NextHopRecord().setFaceId(1).setCost(0))
           .addNextHopRecord(NextHopRecord().setFaceId(274).setCost(0));
-  this->sendDataset("/localhost/nfd/fib/list", payload1, payload2);
+  this->sendDataset(Name("/localhost/nfd/fib/list").append(DatasetPageQuery().wireEncode()),
+                    payload1, payload2);
   this->prepareStatusOutput();
 
   BOOST_CHECK(statusXml.is_equal(STATUS_XML));
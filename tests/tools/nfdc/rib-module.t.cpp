@@ -24,10 +24,16 @@
  */
 
 #include "nfdc/rib-module.hpp"
+#include "core/route-batch.hpp"
 
 #include "execute-command-fixture.hpp"
 #include "status-fixture.hpp"
 
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
 namespace nfd {
 namespace tools {
 namespace nfdc {
@@ -328,6 +334,165 @@ BOOST_AUTO_TEST_CASE(ErrorCommand)
 
 BOOST_AUTO_TEST_SUITE_END() // AddCommand
 
+class AddBatchFixture : public ExecuteCommandFixture
+{
+protected:
+  AddBatchFixture()
+    : path((boost::filesystem::current_path() / "nfdc-route-add-batch.txt").string())
+  {
+    boost::filesystem::remove(path);
+  }
+
+  ~AddBatchFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+  void
+  writeFile(const std::string& content)
+  {
+    std::ofstream(path) << content;
+  }
+
+  /** \brief responds to a rib/register-batch command, accepting every route except those
+   *         whose name is in \p rejected
+   */
+  void
+  respondBatch(const Interest& interest, const std::set<Name>& rejected = {})
+  {
+    Name prefix("/localhost/nfd/rib/register-batch");
+    BOOST_REQUIRE(prefix.isPrefixOf(interest.getName()));
+    RouteBatchParameters batch(interest.getName().at(prefix.size()).blockFromValue());
+    BOOST_CHECK(batch.isValid());
+    batchSizes.push_back(batch.size());
+
+    ndn::nfd::RibRegisterCommand cmd;
+    RouteBatchResults results;
+    for (ControlParameters route : batch.getRoutes()) {
+      cmd.validateRequest(route);
+      cmd.applyDefaultsToRequest(route);
+      if (rejected.count(route.getName()) > 0) {
+        results.addResult(ControlResponse(403, "mocked failure"));
+      }
+      else {
+        results.addResult(ControlResponse(200, "OK").setBody(route.wireEncode()));
+      }
+    }
+
+    auto data = makeData(interest.getName());
+    data->setContent(ControlResponse(200, "OK").setBody(results.wireEncode()).wireEncode());
+    face.receive(*data);
+  }
+
+protected:
+  std::string path;
+  std::vector<size_t> batchSizes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AddBatchCommand, AddBatchFixture)
+
+BOOST_AUTO_TEST_CASE(Normal)
+{
+  std::string content = "# comment\n\n/batch/cost 10156 702\n";
+  for (int i = 0; i < 99; ++i) {
+    content += "/batch/" + to_string(i) + " 10156 # route " + to_string(i) + "\n";
+  }
+  writeFile(content);
+
+  this->processInterest = [this] (const Interest& interest) {
+    respondBatch(interest, {"/batch/7"});
+  };
+
+  this->execute("route add-batch " + path + " no-inherit");
+  // 100 routes are split into commands within the size limit
+  BOOST_CHECK_EQUAL(std::accumulate(batchSizes.begin(), batchSizes.end(), size_t(0)), 100);
+  BOOST_CHECK_EQUAL(batchSizes.size(),
+                    (100 + RouteBatchParameters::MAX_ROUTES - 1) / RouteBatchParameters::MAX_ROUTES);
+  BOOST_CHECK_EQUAL(exitCode, 1);
+  BOOST_CHECK(err.is_equal("Error 403 when adding route: mocked failure\n"));
+
+  std::string outStr = out.str();
+  BOOST_CHECK_EQUAL(std::count(outStr.begin(), outStr.end(), '\n'), 99);
+  BOOST_CHECK_NE(outStr.find("route-add-accepted prefix=/batch/cost nexthop=10156 origin=static "
+                             "cost=702 flags=none expires=never\n"), std::string::npos);
+  BOOST_CHECK_NE(outStr.find("route-add-accepted prefix=/batch/0 nexthop=10156 origin=static "
+                             "cost=0 flags=none expires=never\n"), std::string::npos);
+  BOOST_CHECK_EQUAL(outStr.find("prefix=/batch/7 "), std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(LongRoutes)
+{
+  // fewer long routes fit in one command
+  std::string content;
+  for (int i = 0; i < 40; ++i) {
+    content += "/batch/" + std::string(100, 'x') + "/" + to_string(i) + " 10156\n";
+  }
+  writeFile(content);
+
+  this->processInterest = [this] (const Interest& interest) {
+    respondBatch(interest);
+  };
+
+  this->execute("route add-batch " + path);
+  BOOST_CHECK_EQUAL(std::accumulate(batchSizes.begin(), batchSizes.end(), size_t(0)), 40);
+  BOOST_CHECK_GT(batchSizes.size(), 1);
+  BOOST_CHECK_EQUAL(exitCode, 0);
+  BOOST_CHECK(err.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(RouteTooLong)
+{
+  writeFile("/batch/" + std::string(RouteBatchParameters::MAX_ENCODED_SIZE, 'x') + " 10156\n");
+
+  this->processInterest = [] (const Interest& interest) {
+    BOOST_ERROR("unexpected command " << interest.getName());
+  };
+
+  this->execute("route add-batch " + path);
+  BOOST_CHECK_EQUAL(exitCode, 2);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal(path + ":1: route is too long\n"));
+}
+
+BOOST_AUTO_TEST_CASE(MalformedLine)
+{
+  writeFile("/batch/a 10156\n/batch/b\n");
+
+  this->processInterest = [] (const Interest& interest) {
+    BOOST_ERROR("unexpected command " << interest.getName());
+  };
+
+  this->execute("route add-batch " + path);
+  BOOST_CHECK_EQUAL(exitCode, 2);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal(path + ":2: expecting <PREFIX> <FACEID> [<COST>]\n"));
+}
+
+BOOST_AUTO_TEST_CASE(FileNotFound)
+{
+  this->execute("route add-batch " + path);
+  BOOST_CHECK_EQUAL(exitCode, 1);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("Cannot open " + path + "\n"));
+}
+
+BOOST_AUTO_TEST_CASE(ErrorCommand)
+{
+  writeFile("/batch/a 10156\n");
+
+  this->processInterest = [this] (const Interest& interest) {
+    MOCK_NFD_MGMT_REQUIRE_COMMAND_IS("/localhost/nfd/rib/register-batch");
+    this->failCommand(interest, 403, "not authorized");
+  };
+
+  this->execute("route add-batch " + path);
+  BOOST_CHECK_EQUAL(exitCode, 1);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("Error 403 when adding routes: not authorized\n"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AddBatchCommand
+
 BOOST_FIXTURE_TEST_SUITE(RemoveCommand, ExecuteCommandFixture)
 
 BOOST_AUTO_TEST_CASE(NormalByFaceId)
@@ -537,7 +702,8 @@ BOOST_AUTO_TEST_CASE(Status)
                            .setOrigin(ndn::nfd::ROUTE_ORIGIN_APP)
                            .setCost(0)
                            .setFlags(ndn::nfd::ROUTE_FLAG_CHILD_INHERIT));
-  this->sendDataset("/localhost/nfd/rib/list", payload1, payload2);
+  this->sendDataset(Name("/localhost/nfd/rib/list").append(DatasetPageQuery().wireEncode()),
+                    payload1, payload2);
   this->prepareStatusOutput();
 
   BOOST_CHECK(statusXml.is_equal(STATUS_XML));
@@ -25,6 +25,7 @@
 
 #include "fib-module.hpp"
 #include "format-helpers.hpp"
+#include "paged-dataset.hpp"
 
 namespace nfd {
 namespace tools {
@@ -36,12 +37,12 @@ FibModule::fetchStatus(Controller& controller,
                        const Controller::DatasetFailCallback& onFailure,
                        const CommandOptions& options)
 {
-  controller.fetch<ndn::nfd::FibDataset>(
-    [this, onSuccess] (const std::vector<FibEntry>& result) {
-      m_status = result;
-      onSuccess();
+  m_status.clear();
+  fetchAllPages<FibPageDataset>(controller, DatasetPageQuery(),
+    [this] (const std::vector<FibEntry>& page) {
+      m_status.insert(m_status.end(), page.begin(), page.end());
     },
-    onFailure, options);
+    onSuccess, onFailure, options);
 }
 
 void
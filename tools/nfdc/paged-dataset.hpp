@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_TOOLS_NFDC_PAGED_DATASET_HPP
+#define NFD_TOOLS_NFDC_PAGED_DATASET_HPP
+
+#include "module.hpp"
+#include "core/dataset-page.hpp"
+
+#include <ndn-cxx/mgmt/nfd/fib-entry.hpp>
+#include <ndn-cxx/mgmt/nfd/rib-entry.hpp>
+#include <ndn-cxx/mgmt/nfd/status-dataset.hpp>
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+
+/** \brief one page of a paged StatusDataset
+ */
+template<typename Item>
+struct DatasetPage
+{
+  std::vector<Item> items;
+  optional<Block> cursor; ///< DatasetPageCursor of the next page, nullopt if this is the last page
+};
+
+/** \brief a StatusDataset requested one page at a time
+ *  \tparam Item type of dataset items
+ *
+ *  The DatasetPageQuery is appended to the dataset prefix. A producer that does not recognize
+ *  the query returns the whole dataset, which is then treated as a single page.
+ */
+template<typename Item>
+class PagedDataset : public ndn::nfd::StatusDataset
+{
+public:
+  using ParamType = DatasetPageQuery;
+  using ItemType = Item;
+  using ResultType = DatasetPage<Item>;
+
+  ResultType
+  parseResult(ConstBufferPtr payload) const
+  {
+    ResultType page;
+    size_t offset = 0;
+    while (offset < payload->size()) {
+      bool isOk = false;
+      Block block;
+      std::tie(isOk, block) = Block::fromBuffer(payload, offset);
+      if (!isOk) {
+        NDN_THROW(tlv::Error("Cannot decode dataset page"));
+      }
+      offset += block.size();
+
+      if (page.cursor) {
+        NDN_THROW(tlv::Error("DatasetPageCursor is not the last element of the page"));
+      }
+      if (block.type() == TLV_DATASET_PAGE_CURSOR) {
+        page.cursor = block;
+      }
+      else {
+        page.items.emplace_back(block);
+      }
+    }
+    return page;
+  }
+
+protected:
+  PagedDataset(const PartialName& datasetName, const DatasetPageQuery& query)
+    : StatusDataset(datasetName)
+    , m_query(query)
+  {
+  }
+
+private:
+  void
+  addParameters(Name& prefix) const override
+  {
+    prefix.append(m_query.wireEncode());
+  }
+
+private:
+  DatasetPageQuery m_query;
+};
+
+/** \brief represents a page of fib/list dataset
+ */
+class FibPageDataset : public PagedDataset<ndn::nfd::FibEntry>
+{
+public:
+  explicit
+  FibPageDataset(const DatasetPageQuery& query)
+    : PagedDataset("fib/list", query)
+  {
+  }
+};
+
+/** \brief represents a page of rib/list dataset
+ */
+class RibPageDataset : public PagedDataset<ndn::nfd::RibEntry>
+{
+public:
+  explicit
+  RibPageDataset(const DatasetPageQuery& query)
+    : PagedDataset("rib/list", query)
+  {
+  }
+};
+
+/** \brief fetch all pages of a paged StatusDataset, one page after another
+ *  \tparam Dataset a subclass of PagedDataset
+ *  \param query query of the first page; its cursor, if any, is replaced for subsequent pages
+ *  \param onPage invoked with the items of each page
+ *  \param onSuccess invoked after the last page has been processed
+ *  \param onFailure passed to controller.fetch
+ *  \param options passed to controller.fetch
+ */
+template<typename Dataset>
+void
+fetchAllPages(Controller& controller, DatasetPageQuery query,
+              const std::function<void(const std::vector<typename Dataset::ItemType>&)>& onPage,
+              const std::function<void()>& onSuccess,
+              const Controller::DatasetFailCallback& onFailure,
+              const CommandOptions& options)
+{
+  controller.fetch<Dataset>(query,
+    [=, &controller] (const typename Dataset::ResultType& page) mutable {
+      onPage(page.items);
+      if (!page.cursor) {
+        onSuccess();
+        return;
+      }
+      query.setCursor(*page.cursor);
+      fetchAllPages<Dataset>(controller, query, onPage, onSuccess, onFailure, options);
+    },
+    onFailure, options);
+}
+
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
+
+#endif // NFD_TOOLS_NFDC_PAGED_DATASET_HPP
@@ -26,6 +26,14 @@
 #include "rib-module.hpp"
 #include "find-face.hpp"
 #include "format-helpers.hpp"
+#include "paged-dataset.hpp"
+
+#include "core/route-batch.hpp"
+
+#include <ndn-cxx/security/command-interest-signer.hpp>
+
+#include <fstream>
+#include <sstream>
 
 namespace nfd {
 namespace tools {
@@ -60,6 +68,17 @@ RibModule::registerCommands(CommandParser& parser)
     .addArg("expires", ArgValueType::UNSIGNED, Required::NO, Positional::NO);
   parser.addCommand(defRouteAdd, &RibModule::add);
 
+  CommandDefinition defRouteAddBatch("route", "add-batch");
+  defRouteAddBatch
+    .setTitle("add routes listed in a file")
+    .addArg("file", ArgValueType::STRING, Required::YES, Positional::YES)
+    .addArg("origin", ArgValueType::ROUTE_ORIGIN, Required::NO, Positional::NO)
+    .addArg("cost", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("no-inherit", ArgValueType::NONE, Required::NO, Positional::NO)
+    .addArg("capture", ArgValueType::NONE, Required::NO, Positional::NO)
+    .addArg("expires", ArgValueType::UNSIGNED, Required::NO, Positional::NO);
+  parser.addCommand(defRouteAddBatch, &RibModule::addBatch);
+
   CommandDefinition defRouteRemove("route", "remove");
   defRouteRemove
     .setTitle("remove a route")
@@ -97,7 +116,12 @@ RibModule::list(ExecuteContext& ctx)
     nexthops = findFace.getFaceIds();
   }
 
-  listRoutesImpl(ctx, [&] (const RibEntry& entry, const Route& route) {
+  DatasetPageQuery query;
+  if (nexthops.size() == 1) {
+    query.setFaceId(*nexthops.begin());
+  }
+
+  listRoutesImpl(ctx, query, [&] (const RibEntry& entry, const Route& route) {
     return (nexthops.empty() || nexthops.count(route.getFaceId()) > 0) &&
            (!origin || route.getOrigin() == *origin);
   });
@@ -108,18 +132,20 @@ RibModule::show(ExecuteContext& ctx)
 {
   auto prefix = ctx.args.get<Name>("prefix");
 
-  listRoutesImpl(ctx, [&] (const RibEntry& entry, const Route& route) {
-    return entry.getName() == prefix;
-  });
+  listRoutesImpl(ctx, DatasetPageQuery().setPrefix(prefix),
+                 [&] (const RibEntry& entry, const Route& route) {
+                   return entry.getName() == prefix;
+                 });
 }
 
 void
-RibModule::listRoutesImpl(ExecuteContext& ctx, const RoutePredicate& filter)
+RibModule::listRoutesImpl(ExecuteContext& ctx, const DatasetPageQuery& query,
+                          const RoutePredicate& filter)
 {
-  ctx.controller.fetch<ndn::nfd::RibDataset>(
-    [&] (const std::vector<RibEntry>& dataset) {
-      bool hasRoute = false;
-      for (const RibEntry& entry : dataset) {
+  bool hasRoute = false;
+  fetchAllPages<RibPageDataset>(ctx.controller, query,
+    [&] (const std::vector<RibEntry>& page) {
+      for (const RibEntry& entry : page) {
         for (const Route& route : entry.getRoutes()) {
           if (filter(entry, route)) {
             hasRoute = true;
@@ -128,7 +154,8 @@ RibModule::listRoutesImpl(ExecuteContext& ctx, const RoutePredicate& filter)
           }
         }
       }
-
+    },
+    [&] {
       if (!hasRoute) {
         ctx.exitCode = 6;
         ctx.err << "Route not found\n";
@@ -208,6 +235,136 @@ RibModule::add(ExecuteContext& ctx)
   ctx.face.processEvents();
 }
 
+void
+RibModule::addBatch(ExecuteContext& ctx)
+{
+  auto filename = ctx.args.get<std::string>("file");
+  auto origin = ctx.args.get<RouteOrigin>("origin", ndn::nfd::ROUTE_ORIGIN_STATIC);
+  auto defaultCost = ctx.args.get<uint64_t>("cost", 0);
+  bool wantChildInherit = !ctx.args.get<bool>("no-inherit", false);
+  bool wantCapture = ctx.args.get<bool>("capture", false);
+  auto expiresMillis = ctx.args.getOptional<uint64_t>("expires");
+
+  std::ifstream file(filename);
+  if (!file) {
+    ctx.exitCode = 1;
+    ctx.err << "Cannot open " << filename << '\n';
+    return;
+  }
+
+  // each batch is filled up to the size limit of a rib/register-batch command
+  std::vector<RouteBatchParameters> batches;
+  std::string line;
+  for (size_t lineNo = 1; std::getline(file, line); ++lineNo) {
+    std::istringstream iss(line.substr(0, line.find('#')));
+    std::string prefix;
+    if (!(iss >> prefix)) {
+      continue; // blank or comment-only line
+    }
+
+    uint64_t faceId = 0;
+    uint64_t cost = defaultCost;
+    uint64_t lineCost = 0;
+    std::string extra;
+    bool isValid = static_cast<bool>(iss >> faceId);
+    if (isValid && iss >> lineCost) {
+      cost = lineCost;
+      isValid = !(iss >> extra);
+    }
+    else if (isValid) {
+      isValid = iss.eof();
+    }
+    if (!isValid) {
+      ctx.exitCode = 2;
+      ctx.err << filename << ":" << lineNo << ": expecting <PREFIX> <FACEID> [<COST>]\n";
+      return;
+    }
+
+    ControlParameters params;
+    params
+      .setName(prefix)
+      .setFaceId(faceId)
+      .setOrigin(origin)
+      .setCost(cost)
+      .setFlags((wantChildInherit ? ndn::nfd::ROUTE_FLAG_CHILD_INHERIT : ndn::nfd::ROUTE_FLAGS_NONE) |
+                (wantCapture ? ndn::nfd::ROUTE_FLAG_CAPTURE : ndn::nfd::ROUTE_FLAGS_NONE));
+    if (expiresMillis) {
+      params.setExpirationPeriod(time::milliseconds(*expiresMillis));
+    }
+
+    if (batches.empty() || !batches.back().canAddRoute(params)) {
+      batches.emplace_back();
+      if (!batches.back().canAddRoute(params)) {
+        ctx.exitCode = 2;
+        ctx.err << filename << ":" << lineNo << ": route is too long\n";
+        return;
+      }
+    }
+    batches.back().addRoute(params);
+  }
+
+  ndn::security::CommandInterestSigner signer(ctx.keyChain);
+  auto options = ctx.makeCommandOptions();
+  auto onFailure = ctx.makeCommandFailureHandler("adding routes");
+
+  for (const auto& batch : batches) {
+    Name requestName = options.getPrefix();
+    requestName.append("rib").append("register-batch").append(batch.wireEncode());
+    Interest interest = signer.makeCommandInterest(requestName, options.getSigningInfo());
+    interest.setInterestLifetime(options.getTimeout());
+
+    ctx.face.expressInterest(interest,
+      [&ctx, onFailure] (const Interest&, const Data& data) {
+        ControlResponse resp;
+        RouteBatchResults results;
+        try {
+          resp.wireDecode(data.getContent().blockFromValue());
+          if (resp.getCode() == 200) {
+            results.wireDecode(resp.getBody());
+          }
+        }
+        catch (const tlv::Error& e) {
+          return onFailure(ControlResponse(Controller::ERROR_SERVER, e.what()));
+        }
+        if (resp.getCode() != 200) {
+          return onFailure(resp);
+        }
+
+        for (const auto& result : results.getResults()) {
+          if (result.getCode() != 200) {
+            ctx.exitCode = 1;
+            ctx.err << "Error " << result.getCode() << " when adding route: "
+                    << result.getText() << '\n';
+            continue;
+          }
+
+          ControlParameters route(result.getBody());
+          ctx.out << "route-add-accepted ";
+          text::ItemAttributes ia;
+          ctx.out << ia("prefix") << route.getName()
+                  << ia("nexthop") << route.getFaceId()
+                  << ia("origin") << route.getOrigin()
+                  << ia("cost") << route.getCost()
+                  << ia("flags") << static_cast<ndn::nfd::RouteFlags>(route.getFlags());
+          if (route.hasExpirationPeriod()) {
+            ctx.out << ia("expires") << text::formatDuration<time::milliseconds>(route.getExpirationPeriod()) << "\n";
+          }
+          else {
+            ctx.out << ia("expires") << "never\n";
+          }
+        }
+      },
+      [onFailure] (const Interest&, const lp::Nack& nack) {
+        onFailure(ControlResponse(Controller::ERROR_NACK, "network Nack received"));
+      },
+      [onFailure] (const Interest&) {
+        onFailure(ControlResponse(Controller::ERROR_TIMEOUT, "request timed out"));
+      });
+  }
+
+  ctx.face.processEvents();
+}
+
 void
 RibModule::remove(ExecuteContext& ctx)
 {
@@ -262,12 +419,12 @@ RibModule::fetchStatus(Controller& controller,
                        const Controller::DatasetFailCallback& onFailure,
                        const CommandOptions& options)
 {
-  controller.fetch<ndn::nfd::RibDataset>(
-    [this, onSuccess] (const std::vector<RibEntry>& result) {
-      m_status = result;
-      onSuccess();
+  m_status.clear();
+  fetchAllPages<RibPageDataset>(controller, DatasetPageQuery(),
+    [this] (const std::vector<RibEntry>& page) {
+      m_status.insert(m_status.end(), page.begin(), page.end());
     },
-    onFailure, options);
+    onSuccess, onFailure, options);
 }
 
 void
@@ -29,6 +29,8 @@
 #include "module.hpp"
 #include "command-parser.hpp"
 
+#include "core/dataset-page.hpp"
+
 namespace nfd {
 namespace tools {
 namespace nfdc {
@@ -42,7 +44,7 @@ using ndn::nfd::Route;
 class RibModule : public Module, noncopyable
 {
 public:
-  /** \brief register 'route list', 'route show', 'route add', 'route remove' commands
+  /** \brief register 'route list', 'route show', 'route add', 'route add-batch', 'route remove' commands
    */
   static void
   registerCommands(CommandParser& parser);
@@ -62,6 +64,14 @@ public:
   static void
   add(ExecuteContext& ctx);
 
+  /** \brief the 'route add-batch' command
+   *
+   *  Reads routes from a file, one '<PREFIX> <FACEID> [<COST>]' per line, and sends them
+   *  in rib/register-batch commands.
+   */
+  static void
+  addBatch(ExecuteContext& ctx);
+
   /** \brief the 'route remove' command
    */
   static void
@@ -82,8 +92,11 @@ public:
 private:
   using RoutePredicate = std::function<bool(const RibEntry&, const Route&)>;
 
+  /** \brief print routes that satisfy \p filter
+   *  \param query server-side filter, applied to the RIB dataset before \p filter
+   */
   static void
-  listRoutesImpl(ExecuteContext& ctx, const RoutePredicate& filter);
+  listRoutesImpl(ExecuteContext& ctx, const DatasetPageQuery& query, const RoutePredicate& filter);
 
   /** \brief format a single status item as XML
    *  \param os output stream